@@ -0,0 +1,177 @@
+/**
+ * \file assets.c
+ * \brief Fichier source, paquet de ressources pré-décodées
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les images et la police du programme peuvent être regroupées dans un seul
+ * fichier (voir tools/packAssets.c), projeté en mémoire au lancement.
+ * Les images y sont stockées déjà décodées en RGBA : aucun décodage PNG
+ * n'est nécessaire. Sans ce fichier, les ressources sont lues une à une.
+ * 
+ */
+
+#include "assets.h"
+
+#ifdef _WIN32
+	/* Pas de mmap : le paquet est lu en mémoire */
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/* Contenu du paquet ouvert */
+static unsigned char *packData = NULL;
+static size_t packSize = 0;
+static const assetEntry *packEntries = NULL;
+static uint32_t packCount = 0;
+
+/**
+ * \fn bool assetsOpen(const char *path);
+ * \brief Ouvre le paquet de ressources et le projette en mémoire
+ * 
+ * \param path Chemin du paquet
+ * \return Vrai si le paquet est utilisable, Faux sinon (ressources lues une à une)
+ */
+bool assetsOpen(const char *path)
+{
+	const assetHeader *header;
+	uint32_t i;
+	
+	assetsClose();
+	
+#ifdef _WIN32
+	FILE *file = fopen(path, "rb");
+	long size;
+	
+	if (file == NULL)
+		return false;
+	
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	
+	packData = (unsigned char*) malloc(size > 0 ? size : 1);
+	if (packData == NULL || fread(packData, 1, size, file) != (size_t) size)
+	{
+		fclose(file);
+		free(packData);
+		packData = NULL;
+		return false;
+	}
+	
+	fclose(file);
+	packSize = size;
+#else
+	struct stat info;
+	void *data;
+	int fd = open(path, O_RDONLY);
+	
+	if (fd < 0)
+		return false;
+	
+	if (fstat(fd, &info) < 0 || info.st_size < (off_t) sizeof(assetHeader))
+	{
+		close(fd);
+		return false;
+	}
+	
+	/* Les pages ne sont lues qu'à la première utilisation de chaque ressource */
+	data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	
+	if (data == MAP_FAILED)
+		return false;
+	
+	packData = (unsigned char*) data;
+	packSize = info.st_size;
+#endif
+	
+	/* On vérifie l'en-tête et que chaque ressource est dans le fichier */
+	header = (const assetHeader*) packData;
+	
+	if (packSize < sizeof(assetHeader)
+		|| memcmp(header->magic, ASSETS_MAGIC, 8) != 0
+		|| packSize < sizeof(assetHeader) + (uint64_t) header->count * sizeof(assetEntry))
+	{
+		fprintf(stderr, "Paquet de ressources \"%s\" invalide\n", path);
+		assetsClose();
+		return false;
+	}
+	
+	packEntries = (const assetEntry*)(packData + sizeof(assetHeader));
+	packCount = header->count;
+	
+	for (i = 0; i < packCount; i++)
+	{
+		if (packEntries[i].offset > packSize
+			|| packEntries[i].size > packSize - packEntries[i].offset
+			|| memchr(packEntries[i].name, '\0', sizeof(packEntries[i].name)) == NULL)
+		{
+			fprintf(stderr, "Paquet de ressources \"%s\" invalide\n", path);
+			assetsClose();
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+/**
+ * \fn void assetsClose(void);
+ * \brief Ferme le paquet de ressources
+ * \remark Les surfaces et polices créées depuis le paquet doivent être libérées avant.
+ * 
+ * \return Rien
+ */
+void assetsClose(void)
+{
+	if (packData == NULL)
+		return;
+	
+#ifdef _WIN32
+	free(packData);
+#else
+	munmap(packData, packSize);
+#endif
+	
+	packData = NULL;
+	packSize = 0;
+	packEntries = NULL;
+	packCount = 0;
+}
+
+/**
+ * \fn const assetEntry* assetsFind(const char *name);
+ * \brief Cherche une ressource dans le paquet
+ * 
+ * \param name Chemin d'origine de la ressource (ex: "img/logo.png")
+ * \return La description de la ressource, NULL si absente ou sans paquet
+ */
+const assetEntry* assetsFind(const char *name)
+{
+	uint32_t i;
+	
+	for (i = 0; i < packCount; i++)
+		if (strcmp(packEntries[i].name, name) == 0)
+			return &packEntries[i];
+	
+	return NULL;
+}
+
+/**
+ * \fn const void* assetsData(const assetEntry *entry);
+ * \brief Renvoie les données d'une ressource, directement dans le paquet projeté
+ * 
+ * \param entry Description de la ressource
+ * \return Pointeur vers les données (lecture seule)
+ */
+const void* assetsData(const assetEntry *entry)
+{
+	return packData + entry->offset;
+}
@@ -0,0 +1,100 @@
+/**
+ * \file assets.h
+ * \brief Fichier d'entête, paquet de ressources pré-décodées
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les images et la police du programme peuvent être regroupées dans un seul
+ * fichier (voir tools/packAssets.c), projeté en mémoire au lancement.
+ * Les images y sont stockées déjà décodées en RGBA : aucun décodage PNG
+ * n'est nécessaire. Sans ce fichier, les ressources sont lues une à une.
+ * 
+ * Le format dépend de la machine (entiers natifs), le paquet est généré
+ * à la compilation.
+ * 
+ */
+
+#ifndef H_ASSETS
+#define H_ASSETS
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Macros */
+
+/**
+ * \def ASSETS_FILE
+ * \brief Chemin du paquet de ressources
+ */
+#define ASSETS_FILE "assets.pack"
+
+/**
+ * \def ASSETS_MAGIC
+ * \brief Signature du paquet de ressources (8 octets)
+ */
+#define ASSETS_MAGIC "LIFEPAK1"
+
+/**
+ * \def ASSETS_ALIGN
+ * \brief Alignement en octets des données de chaque ressource
+ */
+#define ASSETS_ALIGN 16
+
+/**
+ * \def ASSET_RAW
+ * \brief Ressource stockée telle quelle (police TTF ...)
+ */
+#define ASSET_RAW 0
+
+/**
+ * \def ASSET_RGBA
+ * \brief Image décodée, 4 octets par pixel dans l'ordre R, V, B, A
+ */
+#define ASSET_RGBA 1
+
+/* Structures */
+
+/**
+ * \struct assetHeader
+ * \brief En-tête du paquet de ressources
+ * 
+*/
+typedef struct
+{
+	char		magic[8];	/*!< Signature ASSETS_MAGIC */
+	uint32_t	count;		/*!< Nombre de ressources */
+	uint32_t	reserved;	/*!< Inutilisé (alignement) */
+} assetHeader;
+
+/**
+ * \struct assetEntry
+ * \brief Description d'une ressource du paquet
+ * 
+ * Les entrées suivent directement l'en-tête.
+ * 
+*/
+typedef struct
+{
+	char		name[64];	/*!< Chemin d'origine (ex: "img/logo.png") */
+	uint32_t	type;		/*!< ASSET_RAW ou ASSET_RGBA */
+	uint32_t	width;		/*!< Largeur de l'image (ASSET_RGBA) */
+	uint32_t	height;		/*!< Hauteur de l'image (ASSET_RGBA) */
+	uint32_t	reserved;	/*!< Inutilisé (alignement) */
+	uint64_t	offset;		/*!< Position des données depuis le début du fichier */
+	uint64_t	size;		/*!< Taille des données en octets */
+} assetEntry;
+
+/* Prototypes */
+
+bool assetsOpen(const char *path);
+void assetsClose(void);
+const assetEntry* assetsFind(const char *name);
+const void* assetsData(const assetEntry *entry);
+
+#endif /* H_ASSETS */
@@ -0,0 +1,416 @@
+/**
+ * \file batch.c
+ * \brief Fichier source, calcul d'une liste d'images par un seul groupe de threads (LiFE --batch)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Le manifeste entier est lu et vérifié avant le premier calcul : une
+ * ligne invalide arrête tout, avant d'écrire la moindre image.
+ * 
+ */
+
+#include "batch.h"
+
+/**
+ * \fn static bool batchParseLine(batchJob *j, const renderJob *base, char *line, int lineNumber);
+ * \brief Lit une ligne du manifeste
+ * 
+ * \param j Image à remplir
+ * \param base Options de la ligne de commande, valables pour toutes les images
+ * \param line Ligne, gardée par l'image (les options pointent dedans)
+ * \param lineNumber Numéro de la ligne
+ * \return Faux si la ligne est invalide (message sur stderr)
+ */
+static bool batchParseLine(batchJob *j, const renderJob *base, char *line, int lineNumber)
+{
+	char *args[BATCH_LINE / 2 + 1], *token;
+	int count = 0;
+	
+	memset(j, 0, sizeof(batchJob));
+	j->line = line;
+	j->lineNumber = lineNumber;
+	j->job = *base;
+	j->job.output = NULL;
+	
+	/* Comme une ligne de commande : args[0] n'est pas lu */
+	args[count++] = "LiFE";
+	for (token = strtok(line, " \t\r\n"); token != NULL; token = strtok(NULL, " \t\r\n"))
+		args[count++] = token;
+	
+	if (!renderJobParse(&j->job, count, args))
+	{
+		fprintf(stderr, "Ligne %d invalide\n", lineNumber);
+		return false;
+	}
+	
+	if (j->job.output == NULL)
+	{
+		fprintf(stderr, "Ligne %d : --output manquant\n", lineNumber);
+		return false;
+	}
+	
+	if (j->job.poster || j->job.pyramidLevels > 0 || j->job.listen != NULL)
+	{
+		fprintf(stderr, "Ligne %d : --poster, --pyramid et --listen ne s'appliquent pas au manifeste\n", lineNumber);
+		return false;
+	}
+	
+	j->fSet = renderJobSettings(&j->job);
+	j->format = j->job.format != 0 ? j->job.format : imageFormatFromName(j->job.output);
+	
+	if (j->format == 0 || j->format == IMAGE_FORMAT_TIFF || j->format == IMAGE_FORMAT_FIELD)
+	{
+		fprintf(stderr, "Ligne %d : %s : format inconnu (png, ppm ou raw)\n", lineNumber, j->job.output);
+		return false;
+	}
+	
+	/* L'image entière est en mémoire pendant son calcul */
+	if ((size_t) j->fSet.screenWidth * j->fSet.screenHeight > HEADLESS_PIXELS_MAX)
+	{
+		fprintf(stderr, "Ligne %d : image trop grande (%dx%d), utiliser LiFE --render --poster\n",
+			lineNumber, j->fSet.screenWidth, j->fSet.screenHeight);
+		return false;
+	}
+	
+	/* Les indices sont sur 16 bits */
+	if (paletteSize(j->fSet) > 65536)
+	{
+		fprintf(stderr, "Ligne %d : trop d'itérations (%d) pour des indices sur 16 bits\n",
+			lineNumber, j->fSet.iterMax);
+		return false;
+	}
+	
+	return true;
+}
+
+/**
+ * \fn static bool batchRead(batch *b, const char *path, const renderJob *base);
+ * \brief Lit et vérifie tout le manifeste
+ * 
+ * \param b Pointeur vers le manifeste
+ * \param path Chemin du manifeste, "-" pour l'entrée standard
+ * \param base Options de la ligne de commande, valables pour toutes les images
+ * \return Faux si le fichier est illisible ou une ligne invalide (message sur stderr)
+ */
+static bool batchRead(batch *b, const char *path, const renderJob *base)
+{
+	FILE *file = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+	char buffer[BATCH_LINE], *line, *start;
+	int lineNumber = 0, capacity = 0;
+	bool valid = true;
+	batchJob *jobs;
+	
+	if (file == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'ouverture de %s\n", path);
+		return false;
+	}
+	
+	while (valid && fgets(buffer, sizeof(buffer), file) != NULL)
+	{
+		lineNumber++;
+		
+		if (strchr(buffer, '\n') == NULL && !feof(file))
+		{
+			fprintf(stderr, "Ligne %d : plus de %d caractères\n", lineNumber, BATCH_LINE - 1);
+			valid = false;
+			break;
+		}
+		
+		/* Lignes vides et commentaires */
+		for (start = buffer; *start == ' ' || *start == '\t'; start++)
+			;
+		if (*start == '#' || *start == '\n' || *start == '\r' || *start == '\0')
+			continue;
+		
+		if (b->count == capacity)
+		{
+			capacity = capacity > 0 ? capacity * 2 : 64;
+			jobs = (batchJob*) realloc(b->jobs, capacity * sizeof(batchJob));
+			if (jobs == NULL)
+			{
+				fprintf(stderr, "Erreur lors de l'allocation du manifeste (%d images)\n", capacity);
+				exit(EXIT_FAILURE);
+			}
+			b->jobs = jobs;
+		}
+		
+		line = strdup(start);
+		if (line == NULL)
+		{
+			fprintf(stderr, "Erreur lors de l'allocation du manifeste (%d images)\n", capacity);
+			exit(EXIT_FAILURE);
+		}
+		
+		valid = batchParseLine(&b->jobs[b->count], base, line, lineNumber);
+		b->count++;
+	}
+	
+	if (file != stdin)
+		fclose(file);
+	
+	return valid;
+}
+
+/**
+ * \fn static void batchOpen(batch *b, batchJob *j);
+ * \brief Commence une image, appelée avec le verrou
+ * 
+ * La palette d'une image précédente de même fractale, mêmes itérations
+ * et même degré est réutilisée.
+ * 
+ * \param b Pointeur vers le manifeste
+ * \param j Image à commencer
+ * \return Rien
+ */
+static void batchOpen(batch *b, batchJob *j)
+{
+	batchJob *other;
+	
+	for (other = b->jobs; other < j && j->pal == NULL; other++)
+		if (other->pal != NULL && other->fSet.fractalId == j->fSet.fractalId
+			&& other->fSet.iterMax == j->fSet.iterMax
+			&& (j->fSet.fractalId != COMPLEX_NEWTON || other->fSet.newtonPower == j->fSet.newtonPower))
+			j->pal = other->pal;
+	
+	if (j->pal == NULL)
+	{
+		j->pal = paletteCreate(j->fSet);
+		j->ownsPalette = true;
+	}
+	
+	j->buffer = iterationBufferCreate(j->fSet.screenWidth, j->fSet.screenHeight);
+	
+	if (j->pal == NULL || j->buffer == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation de %s (%dx%d)\n", j->job.output,
+			j->fSet.screenWidth, j->fSet.screenHeight);
+		exit(EXIT_FAILURE);
+	}
+	j->start = headlessNowMs();
+	b->open++;
+}
+
+/**
+ * \fn static batchJob* batchNextBand(batch *b, int *firstRow, int *lastRow);
+ * \brief Choisit la prochaine bande à calculer, appelée avec le verrou
+ * 
+ * La bande vient de la plus ancienne image qui en a encore. Si aucune
+ * n'en a, l'image suivante du manifeste est commencée, dans la limite
+ * de b->openMax images en cours.
+ * 
+ * \param b Pointeur vers le manifeste
+ * \param firstRow Reçoit la première ligne de la bande
+ * \param lastRow Reçoit la ligne suivant la dernière ligne de la bande
+ * \return L'image de la bande, NULL s'il n'y a pas de bande à calculer pour l'instant
+ */
+static batchJob* batchNextBand(batch *b, int *firstRow, int *lastRow)
+{
+	batchJob *j;
+	
+	while (true)
+	{
+		while (b->first < b->opened && b->jobs[b->first].nextRow >= b->jobs[b->first].fSet.screenHeight)
+			b->first++;
+		
+		if (b->first < b->opened)
+			break;
+		
+		if (b->opened == b->count || b->open >= b->openMax)
+			return NULL;
+		
+		batchOpen(b, &b->jobs[b->opened++]);
+	}
+	
+	j = &b->jobs[b->first];
+	*firstRow = j->nextRow;
+	*lastRow = j->nextRow + BATCH_ROWS < j->fSet.screenHeight ? j->nextRow + BATCH_ROWS : j->fSet.screenHeight;
+	j->nextRow = *lastRow;
+	
+	return j;
+}
+
+/**
+ * \fn static void batchFinish(batch *b, batchJob *j);
+ * \brief Écrit une image finie et affiche sa durée
+ * 
+ * L'écriture se fait sans le verrou : les autres threads continuent.
+ * 
+ * \param b Pointeur vers le manifeste
+ * \param j Image dont toutes les bandes sont calculées
+ * \return Rien
+ */
+static void batchFinish(batch *b, batchJob *j)
+{
+	bool success = imageFileWrite(j->job.output, j->format, j->buffer, j->pal);
+	double wall = headlessNowMs() - j->start;
+	
+	iterationBufferFree(j->buffer);
+	
+	pthread_mutex_lock(&b->lock);
+	
+	j->buffer = NULL;
+	b->open--;
+	
+	if (success)
+	{
+		b->written++;
+		printf("[%d/%d] %s : %dx%d en %.1f ms (%.1f ms de calcul)\n", b->written + b->failed, b->count,
+			j->job.output, j->fSet.screenWidth, j->fSet.screenHeight, wall, j->computeMs);
+	}
+	else
+	{
+		b->failed++;
+		fprintf(stderr, "[%d/%d] Erreur lors de l'écriture de %s (ligne %d)\n", b->written + b->failed,
+			b->count, j->job.output, j->lineNumber);
+	}
+	
+	pthread_cond_broadcast(&b->room);
+	pthread_mutex_unlock(&b->lock);
+}
+
+/**
+ * \fn static void* batchWorker(void *arg);
+ * \brief Calcule des bandes jusqu'à la fin du manifeste
+ * 
+ * \param arg Pointeur vers le manifeste
+ * \return NULL
+ */
+static void* batchWorker(void *arg)
+{
+	batch *b = (batch*) arg;
+	batchJob *j;
+	int firstRow, lastRow;
+	double start;
+	
+	pthread_mutex_lock(&b->lock);
+	
+	while (true)
+	{
+		j = batchNextBand(b, &firstRow, &lastRow);
+		
+		if (j == NULL)
+		{
+			/* Tout est commencé : il ne reste que les bandes des autres threads */
+			if (b->opened == b->count)
+				break;
+			
+			pthread_cond_wait(&b->room, &b->lock);
+			continue;
+		}
+		
+		pthread_mutex_unlock(&b->lock);
+		
+		start = headlessNowMs();
+		computeComplexRows(j->fSet, j->buffer, firstRow, lastRow);
+		
+		pthread_mutex_lock(&b->lock);
+		
+		j->computeMs += headlessNowMs() - start;
+		j->rowsDone += lastRow - firstRow;
+		
+		if (j->rowsDone == j->fSet.screenHeight)
+		{
+			pthread_mutex_unlock(&b->lock);
+			batchFinish(b, j);
+			pthread_mutex_lock(&b->lock);
+		}
+	}
+	
+	pthread_mutex_unlock(&b->lock);
+	return NULL;
+}
+
+/**
+ * \fn int batchMain(int argc, char *argv[]);
+ * \brief Entrée du mode manifeste
+ * 
+ * \param argc Nombre d'arguments
+ * \param argv "--batch MANIFESTE" puis des options de LiFE --render valables pour toutes les images
+ * \return EXIT_SUCCESS si toutes les images sont écrites, EXIT_FAILURE sinon
+ */
+int batchMain(int argc, char *argv[])
+{
+	batch b;
+	renderJob base;
+	pthread_t threads[COMPUTE_THREADS_MAX];
+	char **args = (char**) malloc(argc * sizeof(char*));
+	const char *path = NULL;
+	int count = 0, threadCount, started, i;
+	double seconds;
+	
+	if (args == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation des options\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	/* Le manifeste, les autres options sont celles de --render */
+	args[count++] = argv[0];
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+			path = argv[++i];
+		else
+			args[count++] = argv[i];
+	}
+	
+	renderJobInit(&base);
+	
+	if (path == NULL || !renderJobParse(&base, count, args))
+	{
+		fprintf(stderr, "Utilisation : LiFE --batch MANIFESTE [options de --render pour toutes les images]\n"
+			"  MANIFESTE : une image par ligne, avec ses options de --render dont --output,\n"
+			"  '-' pour l'entrée standard\n");
+		free(args);
+		return EXIT_FAILURE;
+	}
+	
+	free(args);
+	
+	memset(&b, 0, sizeof(batch));
+	
+	if (!batchRead(&b, path, &base))
+		return EXIT_FAILURE;
+	
+	threadCount = base.threads > 0 ? base.threads : sysconf(_SC_NPROCESSORS_ONLN);
+	if (threadCount < 1)
+		threadCount = 1;
+	if (threadCount > COMPUTE_THREADS_MAX)
+		threadCount = COMPUTE_THREADS_MAX;
+	
+	b.openMax = threadCount * BATCH_OPEN_PER_THREAD;
+	pthread_mutex_init(&b.lock, NULL);
+	pthread_cond_init(&b.room, NULL);
+	b.start = headlessNowMs();
+	
+	/* Les mêmes threads pour tout le manifeste, le thread principal compris */
+	for (started = 0; started < threadCount - 1; started++)
+		if (pthread_create(&threads[started], NULL, batchWorker, &b) != 0)
+			break;
+	
+	batchWorker(&b);
+	
+	for (i = 0; i < started; i++)
+		pthread_join(threads[i], NULL);
+	
+	seconds = (headlessNowMs() - b.start) / 1000.0;
+	printf("%d images sur %d en %.2f s (%.1f images/s, %d threads)\n", b.written, b.count, seconds,
+		seconds > 0.0 ? b.written / seconds : 0.0, started + 1);
+	
+	for (i = 0; i < b.count; i++)
+	{
+		if (b.jobs[i].ownsPalette)
+			paletteFree(b.jobs[i].pal);
+		free(b.jobs[i].line);
+	}
+	free(b.jobs);
+	
+	pthread_cond_destroy(&b.room);
+	pthread_mutex_destroy(&b.lock);
+	
+	return b.failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
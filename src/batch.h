@@ -0,0 +1,98 @@
+/**
+ * \file batch.h
+ * \brief Fichier d'entête, calcul d'une liste d'images par un seul groupe de threads (LiFE --batch)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Le manifeste décrit une image par ligne, avec les options de
+ * LiFE --render (par exemple "--fractal julia --julia -0.8,0.156 --size
+ * 256x256 --output j1.png"). Les lignes vides et celles qui commencent
+ * par '#' sont ignorées. Les options données après le manifeste sur la
+ * ligne de commande valent pour toutes les images.
+ * 
+ * Les images sont découpées en bandes de BATCH_ROWS lignes, calculées par
+ * les mêmes threads du début à la fin. Quand une image n'a plus assez de
+ * bandes pour occuper tous les threads, les bandes des images suivantes
+ * sont prises en même temps. Chaque image est écrite dès sa dernière
+ * bande finie, avec sa durée.
+ * 
+ */
+
+#ifndef H_BATCH
+#define H_BATCH
+
+#include <pthread.h>
+
+#include "headless.h"
+
+/* Macros */
+
+/**
+ * \def BATCH_ROWS
+ * \brief Nombre de lignes d'une bande, l'unité de travail des threads
+ */
+#define BATCH_ROWS 8
+
+/**
+ * \def BATCH_OPEN_PER_THREAD
+ * \brief Images en cours au plus, par thread : borne la mémoire des tampons
+ */
+#define BATCH_OPEN_PER_THREAD 2
+
+/**
+ * \def BATCH_LINE
+ * \brief Longueur maximum d'une ligne du manifeste
+ */
+#define BATCH_LINE 4096
+
+/* Structures */
+
+/**
+ * \struct batchJob
+ * \brief Une image du manifeste
+ * 
+*/
+typedef struct
+{
+	renderJob	job;		/*!< Options de l'image */
+	char		*line;		/*!< Ligne du manifeste, découpée (les options pointent dedans) */
+	int		lineNumber;	/*!< Numéro de la ligne, pour les messages */
+	fractalSettings	fSet;		/*!< Paramètres de la fractale */
+	int		format;		/*!< Format du fichier écrit */
+	palette		*pal;		/*!< Palette, partagée entre les images de même fractale et itérations */
+	bool		ownsPalette;	/*!< Vrai si la palette a été créée pour cette image */
+	iterationBuffer	*buffer;	/*!< Indices de l'image, NULL si elle n'est pas en cours */
+	int		nextRow;	/*!< Première ligne de la prochaine bande à calculer */
+	int		rowsDone;	/*!< Lignes calculées */
+	double		start;		/*!< Début du calcul, en ms */
+	double		computeMs;	/*!< Temps passé par les threads sur l'image */
+} batchJob;
+
+/**
+ * \struct batch
+ * \brief Manifeste en cours de calcul, partagé entre les threads
+ * 
+*/
+typedef struct
+{
+	batchJob	*jobs;		/*!< Images du manifeste */
+	int		count;		/*!< Nombre d'images */
+	int		opened;		/*!< Images commencées (les premières du manifeste) */
+	int		first;		/*!< Première image pouvant avoir des bandes à calculer */
+	int		open;		/*!< Images commencées mais pas encore écrites */
+	int		openMax;	/*!< Nombre maximum d'images en cours */
+	int		written;	/*!< Images écrites */
+	int		failed;		/*!< Images en erreur */
+	pthread_mutex_t	lock;		/*!< Protège tout le reste */
+	pthread_cond_t	room;		/*!< Signalé quand une image est écrite */
+	double		start;		/*!< Début du manifeste, en ms */
+} batch;
+
+/* Prototypes */
+
+int batchMain(int argc, char *argv[]);
+
+#endif /* H_BATCH */
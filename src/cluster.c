@@ -0,0 +1,1061 @@
+/**
+ * \file cluster.c
+ * \brief Fichier source, calcul par tuiles réparti entre plusieurs processus (LiFE --listen, LiFE --worker)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Le coordinateur n'a qu'un thread : il attend les messages de tous les
+ * travailleurs avec poll() et lit chaque message au fur et à mesure qu'il
+ * arrive. Un travailleur calcule ses tuiles une à une avec tous ses
+ * threads, un second thread envoie les battements.
+ * 
+ */
+
+#include "cluster.h"
+#include "poster.h"
+#include "life.h"
+
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * \struct clusterLink
+ * \brief Connexion d'un travailleur au coordinateur, partagée avec le thread des battements
+ * 
+*/
+typedef struct
+{
+	int		socket;	/*!< Connexion au coordinateur */
+	pthread_mutex_t	lock;	/*!< Un seul message envoyé à la fois */
+	pthread_cond_t	wake;	/*!< Réveille le thread des battements pour l'arrêter */
+	bool		stop;	/*!< Vrai quand le thread des battements doit s'arrêter */
+} clusterLink;
+
+/**
+ * \struct clusterRank
+ * \brief Une tuile et son coût estimé, pour les trier
+ * 
+*/
+typedef struct
+{
+	double	cost;	/*!< Coût estimé */
+	int	index;	/*!< Numéro de la tuile */
+} clusterRank;
+
+/**
+ * \fn static void putLittle(unsigned char *dest, uint64_t value, int bytes);
+ * \brief Écrit un entier, octet de poids faible en premier
+ * 
+ * \param dest Destination
+ * \param value Valeur à écrire
+ * \param bytes Nombre d'octets
+ * \return Rien
+ */
+static void putLittle(unsigned char *dest, uint64_t value, int bytes)
+{
+	int i;
+	
+	for (i = 0; i < bytes; i++)
+		dest[i] = (value >> (8 * i)) & 0xFF;
+}
+
+/**
+ * \fn static uint64_t getLittle(const unsigned char *src, int bytes);
+ * \brief Lit un entier écrit octet de poids faible en premier
+ * 
+ * \param src Source
+ * \param bytes Nombre d'octets
+ * \return La valeur lue
+ */
+static uint64_t getLittle(const unsigned char *src, int bytes)
+{
+	uint64_t value = 0;
+	int i;
+	
+	for (i = bytes - 1; i >= 0; i--)
+		value = (value << 8) | src[i];
+	
+	return value;
+}
+
+/**
+ * \fn static void putDouble(unsigned char *dest, double value);
+ * \brief Écrit un double IEEE 754, octet de poids faible en premier
+ * 
+ * \param dest Destination (8 octets)
+ * \param value Valeur à écrire
+ * \return Rien
+ */
+static void putDouble(unsigned char *dest, double value)
+{
+	uint64_t bits;
+	
+	memcpy(&bits, &value, sizeof(bits));
+	putLittle(dest, bits, 8);
+}
+
+/**
+ * \fn static double getDouble(const unsigned char *src);
+ * \brief Lit un double écrit par putDouble()
+ * 
+ * \param src Source (8 octets)
+ * \return La valeur lue
+ */
+static double getDouble(const unsigned char *src)
+{
+	uint64_t bits = getLittle(src, 8);
+	double value;
+	
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/**
+ * \fn static int clusterSocket(const char *address, bool listening);
+ * \brief Ouvre une socket d'écoute ou se connecte à une adresse
+ * 
+ * \param address "unix:chemin", "hôte:port" ou "port" (écoute sur toutes les interfaces)
+ * \param listening Vrai pour écouter, faux pour se connecter
+ * \return La socket, -1 en cas d'erreur (errno indique laquelle)
+ */
+static int clusterSocket(const char *address, bool listening)
+{
+	struct sockaddr_un local;
+	struct addrinfo hints, *list, *info;
+	char host[256];
+	const char *port = strrchr(address, ':');
+	int fd = -1, reuse = 1;
+	
+	/* Socket Unix : travailleurs sur la même machine */
+	if (strncmp(address, "unix:", 5) == 0)
+	{
+		if (strlen(address + 5) >= sizeof(local.sun_path) || (fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+			return -1;
+		
+		memset(&local, 0, sizeof(local));
+		local.sun_family = AF_UNIX;
+		strcpy(local.sun_path, address + 5);
+		
+		if (listening)
+		{
+			unlink(local.sun_path);
+			if (bind(fd, (struct sockaddr*) &local, sizeof(local)) == 0 && listen(fd, CLUSTER_WORKERS_MAX) == 0)
+				return fd;
+		}
+		else if (connect(fd, (struct sockaddr*) &local, sizeof(local)) == 0)
+			return fd;
+		
+		close(fd);
+		return -1;
+	}
+	
+	/* TCP : "hôte:port", ou "port" seul pour écouter partout */
+	host[0] = '\0';
+	if (port == NULL)
+		port = address;
+	else
+	{
+		snprintf(host, sizeof(host), "%.*s", (int)(port - address), address);
+		port++;
+	}
+	
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = listening ? AI_PASSIVE : 0;
+	
+	if (getaddrinfo(host[0] != '\0' ? host : NULL, port, &hints, &list) != 0)
+	{
+		errno = EINVAL;
+		return -1;
+	}
+	
+	for (info = list; info != NULL; info = info->ai_next)
+	{
+		if ((fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol)) < 0)
+			continue;
+		
+		if (listening)
+		{
+			setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+			if (bind(fd, info->ai_addr, info->ai_addrlen) == 0 && listen(fd, CLUSTER_WORKERS_MAX) == 0)
+				break;
+		}
+		else if (connect(fd, info->ai_addr, info->ai_addrlen) == 0)
+			break;
+		
+		close(fd);
+		fd = -1;
+	}
+	
+	freeaddrinfo(list);
+	return fd;
+}
+
+/**
+ * \fn static bool clusterSendAll(int fd, const unsigned char *data, size_t length);
+ * \brief Envoie exactement length octets
+ * 
+ * \param fd Connexion
+ * \param data Octets à envoyer
+ * \param length Nombre d'octets
+ * \return Faux si la connexion est perdue
+ */
+static bool clusterSendAll(int fd, const unsigned char *data, size_t length)
+{
+	ssize_t sent;
+	
+	while (length > 0)
+	{
+		sent = send(fd, data, length, MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR)
+			continue;
+		if (sent <= 0)
+			return false;
+		
+		data += sent;
+		length -= sent;
+	}
+	
+	return true;
+}
+
+/**
+ * \fn static bool clusterSend(int fd, uint32_t type, const unsigned char *payload, uint32_t length);
+ * \brief Envoie un message complet
+ * 
+ * \param fd Connexion
+ * \param type Type du message
+ * \param payload Contenu, NULL si length vaut 0
+ * \param length Taille du contenu
+ * \return Faux si la connexion est perdue
+ */
+static bool clusterSend(int fd, uint32_t type, const unsigned char *payload, uint32_t length)
+{
+	unsigned char header[8];
+	
+	putLittle(header, type, 4);
+	putLittle(header + 4, length, 4);
+	
+	return clusterSendAll(fd, header, sizeof(header)) && (length == 0 || clusterSendAll(fd, payload, length));
+}
+
+/**
+ * \fn static bool clusterReceiveAll(int fd, unsigned char *dest, size_t length);
+ * \brief Lit exactement length octets (travailleur, lecture bloquante)
+ * 
+ * \param fd Connexion
+ * \param dest Destination
+ * \param length Nombre d'octets
+ * \return Faux si la connexion est perdue
+ */
+static bool clusterReceiveAll(int fd, unsigned char *dest, size_t length)
+{
+	ssize_t received;
+	
+	while (length > 0)
+	{
+		received = recv(fd, dest, length, 0);
+		if (received < 0 && errno == EINTR)
+			continue;
+		if (received <= 0)
+			return false;
+		
+		dest += received;
+		length -= received;
+	}
+	
+	return true;
+}
+
+/**
+ * \fn static void clusterEncodeTask(unsigned char *dest, int index, fractalSettings tile);
+ * \brief Contenu d'un message CLUSTER_TASK
+ * 
+ * \param dest Destination (CLUSTER_TASK_SIZE octets)
+ * \param index Numéro de la tuile
+ * \param tile Paramètres de la tuile
+ * \return Rien
+ */
+static void clusterEncodeTask(unsigned char *dest, int index, fractalSettings tile)
+{
+	putLittle(dest, index, 4);
+	putLittle(dest + 4, tile.fractalId, 4);
+	putLittle(dest + 8, tile.screenWidth, 4);
+	putLittle(dest + 12, tile.screenHeight, 4);
+	putLittle(dest + 16, tile.iterMax, 4);
+	putLittle(dest + 20, tile.newtonPower, 4);
+	putDouble(dest + 24, tile.realMin);
+	putDouble(dest + 32, tile.realMax);
+	putDouble(dest + 40, tile.imagMin);
+	putDouble(dest + 48, tile.imagMax);
+	putDouble(dest + 56, tile.cstJulia.real);
+	putDouble(dest + 64, tile.cstJulia.imag);
+}
+
+/**
+ * \fn static bool clusterDecodeTask(const unsigned char *src, int *index, fractalSettings *tile);
+ * \brief Lit un message CLUSTER_TASK
+ * 
+ * \param src Contenu du message (CLUSTER_TASK_SIZE octets)
+ * \param index Reçoit le numéro de la tuile
+ * \param tile Reçoit les paramètres de la tuile
+ * \return Faux si les paramètres sont invalides
+ */
+static bool clusterDecodeTask(const unsigned char *src, int *index, fractalSettings *tile)
+{
+	memset(tile, 0, sizeof(fractalSettings));
+	
+	*index = (int32_t) getLittle(src, 4);
+	tile->fractalId = (int32_t) getLittle(src + 4, 4);
+	tile->screenWidth = (int32_t) getLittle(src + 8, 4);
+	tile->screenHeight = (int32_t) getLittle(src + 12, 4);
+	tile->iterMax = (int32_t) getLittle(src + 16, 4);
+	tile->newtonPower = (int32_t) getLittle(src + 20, 4);
+	tile->realMin = getDouble(src + 24);
+	tile->realMax = getDouble(src + 32);
+	tile->imagMin = getDouble(src + 40);
+	tile->imagMax = getDouble(src + 48);
+	tile->cstJulia = complexSet(getDouble(src + 56), getDouble(src + 64));
+	
+	return tile->fractalId >= COMPLEX_MANDELBROT && tile->fractalId <= COMPLEX_NEWTON
+		&& tile->screenWidth > 0 && tile->screenWidth <= POSTER_TILE_MAX
+		&& tile->screenHeight > 0 && tile->screenHeight <= POSTER_TILE_MAX
+		&& tile->iterMax > 0 && tile->newtonPower >= 2;
+}
+
+/**
+ * \fn static int compareRank(const void *a, const void *b);
+ * \brief Comparaison de deux tuiles pour qsort(), la plus chère d'abord
+ * 
+ * \param a Première tuile
+ * \param b Seconde tuile
+ * \return Négatif si a passe avant b, positif sinon
+ */
+static int compareRank(const void *a, const void *b)
+{
+	const clusterRank *ra = (const clusterRank*) a, *rb = (const clusterRank*) b;
+	
+	if (ra->cost != rb->cost)
+		return ra->cost < rb->cost ? 1 : -1;
+	
+	return ra->index - rb->index;
+}
+
+/**
+ * \fn static void clusterEstimate(cluster *c);
+ * \brief Estime le coût de chaque tuile sur un aperçu grossier et les trie
+ * 
+ * L'aperçu calcule quelques points de chaque tuile, aux mêmes
+ * coordonnées que dans la tuile. Le coût d'un point est son nombre
+ * d'itérations.
+ * 
+ * \param c Pointeur vers le calcul réparti
+ * \return Rien
+ */
+static void clusterEstimate(cluster *c)
+{
+	fractalSettings preview = posterTileSettings(c->image, c->tileSize, 0);
+	int tilesX = (c->image.screenWidth + c->tileSize - 1) / c->tileSize;
+	int tilesY = c->tiles / tilesX, side = CLUSTER_PREVIEW, x, y, index, value, i;
+	iterationBuffer *buffer;
+	clusterRank *ranks = (clusterRank*) malloc(c->tiles * sizeof(clusterRank));
+	
+	if (ranks == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation du calcul réparti (%d tuiles)\n", c->tiles);
+		exit(EXIT_FAILURE);
+	}
+	
+	while (side > 1 && (double) c->tiles * side * side > CLUSTER_PREVIEW_MAX)
+		side /= 2;
+	
+	/* Toutes les tuiles, y compris ce qui dépasse de l'image */
+	preview.realMax = preview.realMin + tilesX * (preview.realMax - preview.realMin);
+	preview.imagMax = preview.imagMin + tilesY * (preview.imagMax - preview.imagMin);
+	preview.screenWidth = tilesX * side;
+	preview.screenHeight = tilesY * side;
+	
+	buffer = iterationBufferCreate(preview.screenWidth, preview.screenHeight);
+	if (buffer == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation du calcul réparti (%d tuiles)\n", c->tiles);
+		exit(EXIT_FAILURE);
+	}
+	
+	computeComplexParallel(preview, buffer);
+	
+	for (index = 0; index < c->tiles; index++)
+	{
+		ranks[index].index = index;
+		ranks[index].cost = 0.0;
+		
+		for (y = 0; y < side; y++)
+			for (x = 0; x < side; x++)
+			{
+				i = ((index / tilesX) * side + y) * buffer->width + (index % tilesX) * side + x;
+				value = buffer->data[i];
+			
+				/* Newton : (iterMax + 1) couleurs par racine, 0 sans racine */
+				if (c->image.fractalId == COMPLEX_NEWTON)
+					value = value == 0 ? c->image.iterMax : (value - 1) % (c->image.iterMax + 1);
+			
+				/* Chaque pixel coûte au moins son parcours */
+				ranks[index].cost += value + 1;
+			}
+		
+		ranks[index].cost *= (double) c->tileSize * c->tileSize / (side * side);
+		c->cost[index] = ranks[index].cost;
+	}
+	
+	qsort(ranks, c->tiles, sizeof(clusterRank), compareRank);
+	for (index = 0; index < c->tiles; index++)
+		c->order[index] = ranks[index].index;
+	
+	iterationBufferFree(buffer);
+	free(ranks);
+}
+
+/**
+ * \fn bool clusterOpen(cluster *c, const char *address, fractalSettings image, int tileSize, const unsigned char *done);
+ * \brief Ouvre l'écoute du coordinateur et prépare les tuiles
+ * 
+ * \param c Pointeur vers le calcul réparti
+ * \param address Adresse d'écoute (voir clusterSocket())
+ * \param image Paramètres de l'image entière
+ * \param tileSize Côté des tuiles en pixels
+ * \param done Tuiles déjà calculées, un bit par tuile, NULL si aucune
+ * \return Faux si l'écoute est impossible (message sur stderr), c->listener vaut alors -1
+ */
+bool clusterOpen(cluster *c, const char *address, fractalSettings image, int tileSize, const unsigned char *done)
+{
+	int tilesX = (image.screenWidth + tileSize - 1) / tileSize;
+	int tilesY = (image.screenHeight + tileSize - 1) / tileSize;
+	int i;
+	
+	memset(c, 0, sizeof(cluster));
+	for (i = 0; i < CLUSTER_WORKERS_MAX; i++)
+		c->workers[i].socket = -1;
+	
+	c->address = address;
+	c->image = image;
+	c->tileSize = tileSize;
+	c->tiles = tilesX * tilesY;
+	c->nextId = 1;
+	
+	c->listener = clusterSocket(address, true);
+	if (c->listener < 0)
+	{
+		fprintf(stderr, "Erreur lors de l'écoute sur %s : %s\n", address, strerror(errno));
+		return false;
+	}
+	
+	c->state = (unsigned char*) calloc(c->tiles, 1);
+	c->cost = (double*) malloc(c->tiles * sizeof(double));
+	c->order = (int*) malloc(c->tiles * sizeof(int));
+	c->result = iterationBufferCreate(tileSize, tileSize);
+	
+	if (c->state == NULL || c->cost == NULL || c->order == NULL || c->result == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation du calcul réparti (%d tuiles)\n", c->tiles);
+		exit(EXIT_FAILURE);
+	}
+	
+	for (i = 0; i < c->tiles; i++)
+	{
+		/* 0 : à faire, 1 : confiée, 2 : finie */
+		if (done != NULL && (done[i / 8] & (1 << (i % 8))))
+			c->state[i] = 2;
+		else
+			c->remaining++;
+	}
+	
+	/* Les travailleurs peuvent se connecter pendant l'aperçu */
+	printf("Coordinateur sur %s : %d tuiles à calculer\n", address, c->remaining);
+	fflush(stdout);
+	
+	if (c->remaining > 0)
+		clusterEstimate(c);
+	
+	return true;
+}
+
+/**
+ * \fn static void clusterDrop(cluster *c, clusterWorker *w, const char *reason);
+ * \brief Déconnecte un travailleur et remet ses tuiles à faire
+ * 
+ * \param c Pointeur vers le calcul réparti
+ * \param w Travailleur perdu
+ * \param reason Cause, pour le message
+ * \return Rien
+ */
+static void clusterDrop(cluster *c, clusterWorker *w, const char *reason)
+{
+	int i;
+	
+	for (i = 0; i < w->inflightCount; i++)
+		c->state[w->inflight[i]] = 0;
+	
+	if (w->inflightCount > 0)
+	{
+		c->reassigned += w->inflightCount;
+		c->cursor = 0;
+	}
+	
+	fprintf(stderr, "Travailleur %d perdu (%s) : %d tuiles à confier à nouveau\n",
+		w->id, reason, w->inflightCount);
+	
+	close(w->socket);
+	free(w->payload);
+	memset(w, 0, sizeof(clusterWorker));
+	w->socket = -1;
+}
+
+/**
+ * \fn static void clusterAccept(cluster *c);
+ * \brief Accepte la connexion d'un nouveau travailleur
+ * 
+ * \param c Pointeur vers le calcul réparti
+ * \return Rien
+ */
+static void clusterAccept(cluster *c)
+{
+	int fd = accept(c->listener, NULL, NULL), i;
+	
+	if (fd < 0)
+		return;
+	
+	for (i = 0; i < CLUSTER_WORKERS_MAX && c->workers[i].socket >= 0; i++)
+		;
+	
+	if (i == CLUSTER_WORKERS_MAX)
+	{
+		clusterSend(fd, CLUSTER_BYE, NULL, 0);
+		close(fd);
+		return;
+	}
+	
+	memset(&c->workers[i], 0, sizeof(clusterWorker));
+	c->workers[i].socket = fd;
+	c->workers[i].id = c->nextId++;
+	c->workers[i].lastHeard = headlessNowMs();
+}
+
+/**
+ * \fn static int clusterMessage(cluster *c, clusterWorker *w);
+ * \brief Traite un message complet d'un travailleur
+ * 
+ * \param c Pointeur vers le calcul réparti
+ * \param w Travailleur
+ * \return Le numéro de la tuile revenue (dans c->result), -1 sinon, -2 si le message est invalide
+ */
+static int clusterMessage(cluster *c, clusterWorker *w)
+{
+	unsigned char *data = w->payload;
+	int index, i, size = c->tileSize * c->tileSize;
+	double ms, speed;
+	
+	if (w->type == CLUSTER_HEARTBEAT)
+		return -1;
+	
+	if (w->type == CLUSTER_HELLO)
+	{
+		if (w->length != 8 || getLittle(data + 4, 4) != CLUSTER_PROTOCOL)
+			return -2;
+		
+		w->threads = getLittle(data, 4);
+		if (w->threads < 1)
+			w->threads = 1;
+		
+		printf("Travailleur %d connecté (%d threads)\n", w->id, w->threads);
+		fflush(stdout);
+		return -1;
+	}
+	
+	if (w->type != CLUSTER_RESULT || w->length != 8 + 2 * (uint32_t) size)
+		return -2;
+	
+	/* Seules les tuiles confiées à ce travailleur sont acceptées */
+	index = getLittle(data, 4);
+	for (i = 0; i < w->inflightCount && w->inflight[i] != index; i++)
+		;
+	if (i == w->inflightCount)
+		return -2;
+	
+	w->inflight[i] = w->inflight[--w->inflightCount];
+	
+	/* Vitesse mesurée : coût estimé par ms de calcul, moyenne glissante */
+	ms = getLittle(data + 4, 4) / 1000.0;
+	speed = c->cost[index] / (ms > 0.01 ? ms : 0.01);
+	w->speed = w->speed == 0.0 ? speed : 0.7 * w->speed + 0.3 * speed;
+	w->busyMs += ms;
+	w->tiles++;
+	
+	if (c->state[index] == 2)
+		return -1;
+	
+	for (i = 0; i < size; i++)
+		c->result->data[i] = getLittle(data + 8 + 2 * i, 2);
+	
+	c->state[index] = 2;
+	c->remaining--;
+	
+	return index;
+}
+
+/**
+ * \fn static int clusterReceive(cluster *c, clusterWorker *w);
+ * \brief Lit ce qui est arrivé d'un travailleur, sans attendre
+ * 
+ * La lecture s'arrête à la fin du premier message complet : le reste
+ * attend dans la socket.
+ * 
+ * \param c Pointeur vers le calcul réparti
+ * \param w Travailleur
+ * \return Le numéro d'une tuile revenue, -1 sinon, -2 si le travailleur est perdu
+ */
+static int clusterReceive(cluster *c, clusterWorker *w)
+{
+	size_t maxLength = 8 + 2 * (size_t) c->tileSize * c->tileSize;
+	ssize_t received;
+	int index;
+	
+	while (true)
+	{
+		if (w->received < 8)
+			received = recv(w->socket, w->header + w->received, 8 - w->received, MSG_DONTWAIT);
+		else
+			received = recv(w->socket, w->payload + w->received - 8, w->length + 8 - w->received, MSG_DONTWAIT);
+		
+		if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+			return -1;
+		if (received <= 0)
+			return -2;
+		
+		w->received += received;
+		w->lastHeard = headlessNowMs();
+		
+		/* En-tête complet : place pour le contenu */
+		if (w->received == 8)
+		{
+			w->type = getLittle(w->header, 4);
+			w->length = getLittle(w->header + 4, 4);
+			
+			if (w->length > maxLength)
+				return -2;
+			
+			free(w->payload);
+			w->payload = (unsigned char*) malloc(w->length > 0 ? w->length : 1);
+			if (w->payload == NULL)
+				return -2;
+		}
+		
+		if (w->received == 8 + (size_t) w->length)
+		{
+			w->received = 0;
+			index = clusterMessage(c, w);
+			
+			if (index != -1)
+				return index;
+		}
+	}
+}
+
+/**
+ * \fn static void clusterDispatch(cluster *c);
+ * \brief Confie des tuiles aux travailleurs qui en manquent
+ * 
+ * Un travailleur reçoit des tuiles tant que le travail qu'il a déjà,
+ * estimé d'après sa vitesse mesurée, ne dépasse pas CLUSTER_PIPELINE_MS.
+ * Avant sa première tuile, il en reçoit autant qu'il a de threads.
+ * 
+ * \param c Pointeur vers le calcul réparti
+ * \return Rien
+ */
+static void clusterDispatch(cluster *c)
+{
+	unsigned char task[CLUSTER_TASK_SIZE];
+	clusterWorker *w;
+	double pending;
+	int i, j, index;
+	
+	for (i = 0; i < CLUSTER_WORKERS_MAX; i++)
+	{
+		w = &c->workers[i];
+		if (w->socket < 0 || w->threads == 0)
+			continue;
+		
+		while (w->inflightCount < CLUSTER_INFLIGHT_MAX)
+		{
+			while (c->cursor < c->tiles && c->state[c->order[c->cursor]] != 0)
+				c->cursor++;
+			if (c->cursor == c->tiles)
+				return;
+			
+			index = c->order[c->cursor];
+			
+			if (w->inflightCount > 0)
+			{
+				if (w->speed == 0.0)
+				{
+					if (w->inflightCount >= w->threads)
+						break;
+				}
+				else
+				{
+					for (pending = c->cost[index], j = 0; j < w->inflightCount; j++)
+						pending += c->cost[w->inflight[j]];
+					if (pending / w->speed > CLUSTER_PIPELINE_MS)
+						break;
+				}
+			}
+			
+			clusterEncodeTask(task, index, posterTileSettings(c->image, c->tileSize, index));
+			if (!clusterSend(w->socket, CLUSTER_TASK, task, CLUSTER_TASK_SIZE))
+			{
+				clusterDrop(c, w, "connexion fermée");
+				break;
+			}
+			
+			c->state[index] = 1;
+			w->inflight[w->inflightCount++] = index;
+		}
+	}
+}
+
+/**
+ * \fn int clusterNext(cluster *c);
+ * \brief Attend la prochaine tuile calculée par un travailleur
+ * 
+ * Attend sans fin qu'un travailleur se connecte s'il n'y en a aucun.
+ * 
+ * \param c Pointeur vers le calcul réparti
+ * \return Le numéro de la tuile, ses indices dans c->result ; -1 quand toutes les tuiles sont revenues
+ */
+int clusterNext(cluster *c)
+{
+	struct pollfd fds[CLUSTER_WORKERS_MAX + 1];
+	int slots[CLUSTER_WORKERS_MAX + 1];
+	int count, i, index;
+	bool announced = false;
+	double now;
+	
+	while (c->remaining > 0)
+	{
+		clusterDispatch(c);
+		
+		fds[0].fd = c->listener;
+		fds[0].events = POLLIN;
+		for (count = 1, i = 0; i < CLUSTER_WORKERS_MAX; i++)
+			if (c->workers[i].socket >= 0)
+			{
+				fds[count].fd = c->workers[i].socket;
+				fds[count].events = POLLIN;
+				slots[count++] = i;
+			}
+		
+		if (count == 1 && !announced)
+		{
+			printf("En attente de travailleurs : LiFE --worker %s\n", c->address);
+			fflush(stdout);
+			announced = true;
+		}
+		
+		if (poll(fds, count, CLUSTER_HEARTBEAT_MS / 4) < 0 && errno != EINTR)
+		{
+			fprintf(stderr, "Erreur lors de l'attente des travailleurs : %s\n", strerror(errno));
+			exit(EXIT_FAILURE);
+		}
+		
+		if (fds[0].revents & POLLIN)
+			clusterAccept(c);
+		
+		/* Un travailleur qui a écrit est vivant, même si la lecture attend */
+		now = headlessNowMs();
+		for (i = 1; i < count; i++)
+			if (fds[i].revents != 0)
+				c->workers[slots[i]].lastHeard = now;
+		
+		for (i = 1; i < count; i++)
+		{
+			if (fds[i].revents == 0)
+				continue;
+			
+			index = clusterReceive(c, &c->workers[slots[i]]);
+			
+			if (index == -2)
+				clusterDrop(c, &c->workers[slots[i]], "connexion fermée ou message invalide");
+			else if (index >= 0)
+				return index;
+		}
+		
+		/* Un travailleur muet est considéré comme mort */
+		for (i = 0; i < CLUSTER_WORKERS_MAX; i++)
+			if (c->workers[i].socket >= 0 && now - c->workers[i].lastHeard > CLUSTER_TIMEOUT_MS)
+				clusterDrop(c, &c->workers[i], "plus de battement");
+	}
+	
+	return -1;
+}
+
+/**
+ * \fn void clusterClose(cluster *c);
+ * \brief Arrête les travailleurs, affiche leur bilan et ferme l'écoute
+ * 
+ * \param c Pointeur vers le calcul réparti
+ * \return Rien
+ */
+void clusterClose(cluster *c)
+{
+	clusterWorker *w;
+	int i;
+	
+	for (i = 0; i < CLUSTER_WORKERS_MAX; i++)
+	{
+		w = &c->workers[i];
+		if (w->socket < 0)
+			continue;
+		
+		if (w->tiles > 0)
+			printf("Travailleur %d : %d tuiles, %.1f ms par tuile\n", w->id, w->tiles, w->busyMs / w->tiles);
+		
+		clusterSend(w->socket, CLUSTER_BYE, NULL, 0);
+		close(w->socket);
+		free(w->payload);
+	}
+	
+	if (c->reassigned > 0)
+		printf("%d tuiles confiées à nouveau après la perte d'un travailleur\n", c->reassigned);
+	
+	close(c->listener);
+	c->listener = -1;
+	if (strncmp(c->address, "unix:", 5) == 0)
+		unlink(c->address + 5);
+	
+	iterationBufferFree(c->result);
+	free(c->order);
+	free(c->cost);
+	free(c->state);
+}
+
+/**
+ * \fn bool clusterComputeFrame(const char *address, fractalSettings fSet, int tileSize, iterationBuffer *buffer);
+ * \brief Calcule une image entière par les travailleurs
+ * 
+ * \param address Adresse d'écoute du coordinateur
+ * \param fSet Paramètres de l'image
+ * \param tileSize Côté des tuiles en pixels
+ * \param buffer Tampon recevant les indices de l'image
+ * \return Faux si l'écoute est impossible (message sur stderr)
+ */
+bool clusterComputeFrame(const char *address, fractalSettings fSet, int tileSize, iterationBuffer *buffer)
+{
+	cluster c;
+	int tilesX = (fSet.screenWidth + tileSize - 1) / tileSize;
+	int index, x0, y0, width, y;
+	
+	if (!clusterOpen(&c, address, fSet, tileSize, NULL))
+		return false;
+	
+	/* Chaque tuile à sa place, sans ce qui dépasse de l'image */
+	while ((index = clusterNext(&c)) >= 0)
+	{
+		x0 = (index % tilesX) * tileSize;
+		y0 = (index / tilesX) * tileSize;
+		width = fSet.screenWidth - x0 < tileSize ? fSet.screenWidth - x0 : tileSize;
+		
+		for (y = 0; y < tileSize && y0 + y < fSet.screenHeight; y++)
+			memcpy(buffer->data + (size_t) (y0 + y) * buffer->width + x0, c.result->data + y * tileSize,
+				width * sizeof(unsigned short));
+	}
+	
+	clusterClose(&c);
+	return true;
+}
+
+/**
+ * \fn static void* clusterHeartbeat(void *arg);
+ * \brief Envoie un battement toutes les CLUSTER_HEARTBEAT_MS jusqu'à l'arrêt
+ * 
+ * \param arg Pointeur vers la connexion (clusterLink)
+ * \return NULL
+ */
+static void* clusterHeartbeat(void *arg)
+{
+	clusterLink *link = (clusterLink*) arg;
+	struct timespec deadline;
+	
+	pthread_mutex_lock(&link->lock);
+	
+	while (!link->stop)
+	{
+		clock_gettime(CLOCK_REALTIME, &deadline);
+		deadline.tv_sec += CLUSTER_HEARTBEAT_MS / 1000;
+		deadline.tv_nsec += (CLUSTER_HEARTBEAT_MS % 1000) * 1000000L;
+		if (deadline.tv_nsec >= 1000000000L)
+		{
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+		
+		if (pthread_cond_timedwait(&link->wake, &link->lock, &deadline) == ETIMEDOUT && !link->stop)
+			clusterSend(link->socket, CLUSTER_HEARTBEAT, NULL, 0);
+	}
+	
+	pthread_mutex_unlock(&link->lock);
+	return NULL;
+}
+
+/**
+ * \fn int clusterWorkerMain(int argc, char *argv[]);
+ * \brief Entrée d'un travailleur : calcule les tuiles du coordinateur jusqu'à la fin
+ * 
+ * \param argc Nombre d'arguments
+ * \param argv "--worker ADRESSE" et, facultatif, "--threads N"
+ * \return EXIT_SUCCESS quand le coordinateur a fini, EXIT_FAILURE sinon
+ */
+int clusterWorkerMain(int argc, char *argv[])
+{
+	clusterLink link;
+	pthread_t heartbeat;
+	const char *address = NULL;
+	unsigned char header[8], hello[8], task[CLUSTER_TASK_SIZE], *result = NULL;
+	fractalSettings tile;
+	iterationBuffer *buffer = NULL;
+	lifeRenderer *renderer = NULL;
+	int threads = 0, tries, index, i, tiles = 0;
+	uint32_t type, length;
+	double start;
+	bool finished = false;
+	char end;
+	
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--worker") == 0 && i + 1 < argc)
+			address = argv[++i];
+		else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc
+			&& sscanf(argv[i + 1], "%d%c", &threads, &end) == 1 && threads >= 0)
+			i++;
+		else
+		{
+			fprintf(stderr, "Utilisation : LiFE --worker unix:CHEMIN|HÔTE:PORT [--threads N]\n");
+			return EXIT_FAILURE;
+		}
+	}
+	
+	if (address == NULL)
+	{
+		fprintf(stderr, "Utilisation : LiFE --worker unix:CHEMIN|HÔTE:PORT [--threads N]\n");
+		return EXIT_FAILURE;
+	}
+	
+	/* Le coordinateur peut démarrer après le travailleur */
+	for (tries = 0; (link.socket = clusterSocket(address, false)) < 0 && tries < CLUSTER_CONNECT_TRIES; tries++)
+		sleep(1);
+	
+	if (link.socket < 0)
+	{
+		fprintf(stderr, "Erreur lors de la connexion à %s : %s\n", address, strerror(errno));
+		return EXIT_FAILURE;
+	}
+	
+	/* Les mêmes threads pour toutes les tuiles */
+	renderer = lifeRendererCreate(threads);
+	if (renderer == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation du moteur de calcul\n");
+		exit(EXIT_FAILURE);
+	}
+	threads = renderer->threadCount;
+	
+	link.stop = false;
+	pthread_mutex_init(&link.lock, NULL);
+	pthread_cond_init(&link.wake, NULL);
+	
+	putLittle(hello, threads, 4);
+	putLittle(hello + 4, CLUSTER_PROTOCOL, 4);
+	clusterSend(link.socket, CLUSTER_HELLO, hello, sizeof(hello));
+	
+	pthread_create(&heartbeat, NULL, clusterHeartbeat, &link);
+	
+	while (clusterReceiveAll(link.socket, header, sizeof(header)))
+	{
+		type = getLittle(header, 4);
+		length = getLittle(header + 4, 4);
+		
+		if (type == CLUSTER_BYE)
+		{
+			finished = true;
+			break;
+		}
+		
+		if (type != CLUSTER_TASK || length != CLUSTER_TASK_SIZE
+			|| !clusterReceiveAll(link.socket, task, CLUSTER_TASK_SIZE)
+			|| !clusterDecodeTask(task, &index, &tile))
+			break;
+		
+		if (buffer == NULL || buffer->width != tile.screenWidth || buffer->height != tile.screenHeight)
+		{
+			iterationBufferFree(buffer);
+			free(result);
+			
+			buffer = iterationBufferCreate(tile.screenWidth, tile.screenHeight);
+			result = (unsigned char*) malloc(8 + 2 * (size_t) tile.screenWidth * tile.screenHeight);
+			if (buffer == NULL || result == NULL)
+			{
+				fprintf(stderr, "Erreur lors de l'allocation d'une tuile\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+		
+		start = headlessNowMs();
+		if (lifeRenderIndices(renderer, tile, buffer->data, buffer->width, NULL, NULL) != LIFE_OK)
+		{
+			fprintf(stderr, "Tuile %d invalide reçue de %s\n", index, address);
+			break;
+		}
+		
+		putLittle(result, index, 4);
+		putLittle(result + 4, (uint32_t)((headlessNowMs() - start) * 1000.0), 4);
+		for (i = 0; i < tile.screenWidth * tile.screenHeight; i++)
+			putLittle(result + 8 + 2 * i, buffer->data[i], 2);
+		
+		pthread_mutex_lock(&link.lock);
+		if (!clusterSend(link.socket, CLUSTER_RESULT, result, 8 + 2 * tile.screenWidth * tile.screenHeight))
+		{
+			pthread_mutex_unlock(&link.lock);
+			break;
+		}
+		pthread_mutex_unlock(&link.lock);
+		
+		tiles++;
+	}
+	
+	pthread_mutex_lock(&link.lock);
+	link.stop = true;
+	pthread_cond_signal(&link.wake);
+	pthread_mutex_unlock(&link.lock);
+	pthread_join(heartbeat, NULL);
+	
+	close(link.socket);
+	lifeRendererFree(renderer);
+	iterationBufferFree(buffer);
+	free(result);
+	
+	printf("%d tuiles calculées pour %s\n", tiles, address);
+	
+	if (!finished)
+	{
+		fprintf(stderr, "Connexion à %s perdue\n", address);
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
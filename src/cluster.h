@@ -0,0 +1,190 @@
+/**
+ * \file cluster.h
+ * \brief Fichier d'entête, calcul par tuiles réparti entre plusieurs processus (LiFE --listen, LiFE --worker)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Le coordinateur (LiFE --render ... --listen ADRESSE) découpe l'image en
+ * tuiles et les confie aux travailleurs (LiFE --worker ADRESSE) connectés
+ * en TCP ("hôte:port", ou "port" pour écouter partout) ou par une socket
+ * Unix ("unix:chemin"). Les indices calculés reviennent au coordinateur,
+ * qui les place dans l'image ou dans le poster.
+ * 
+ * Un aperçu grossier de l'image estime le coût de chaque tuile : les plus
+ * chères partent d'abord et chaque travailleur reçoit d'avance autant de
+ * tuiles que sa vitesse mesurée en calcule en CLUSTER_PIPELINE_MS.
+ * 
+ * Les travailleurs envoient un battement toutes les CLUSTER_HEARTBEAT_MS,
+ * même pendant un calcul. Les tuiles d'un travailleur déconnecté ou muet
+ * depuis CLUSTER_TIMEOUT_MS sont confiées aux autres.
+ * 
+ * Chaque message est un en-tête (type, taille du contenu, 32 bits) suivi
+ * du contenu, en little-endian :
+ * 
+ * - CLUSTER_HELLO : nombre de threads, version du protocole ;
+ * - CLUSTER_TASK : numéro de la tuile puis ses paramètres ;
+ * - CLUSTER_RESULT : numéro, durée du calcul (µs), indices sur 16 bits ;
+ * - CLUSTER_HEARTBEAT, CLUSTER_BYE : sans contenu.
+ * 
+ */
+
+#ifndef H_CLUSTER
+#define H_CLUSTER
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include "headless.h"
+
+/* Macros */
+
+/**
+ * \def CLUSTER_PROTOCOL
+ * \brief Version du protocole, vérifiée à la connexion
+ */
+#define CLUSTER_PROTOCOL 1
+
+/**
+ * \def CLUSTER_HELLO
+ * \brief Message d'un travailleur qui se présente
+ */
+#define CLUSTER_HELLO 1
+
+/**
+ * \def CLUSTER_TASK
+ * \brief Message d'une tuile à calculer
+ */
+#define CLUSTER_TASK 2
+
+/**
+ * \def CLUSTER_RESULT
+ * \brief Message d'une tuile calculée
+ */
+#define CLUSTER_RESULT 3
+
+/**
+ * \def CLUSTER_HEARTBEAT
+ * \brief Message d'un travailleur toujours en vie
+ */
+#define CLUSTER_HEARTBEAT 4
+
+/**
+ * \def CLUSTER_BYE
+ * \brief Message de fin du calcul, le travailleur s'arrête
+ */
+#define CLUSTER_BYE 5
+
+/**
+ * \def CLUSTER_TASK_SIZE
+ * \brief Taille du contenu d'un message CLUSTER_TASK
+ */
+#define CLUSTER_TASK_SIZE 72
+
+/**
+ * \def CLUSTER_HEARTBEAT_MS
+ * \brief Intervalle entre deux battements d'un travailleur
+ */
+#define CLUSTER_HEARTBEAT_MS 1000
+
+/**
+ * \def CLUSTER_TIMEOUT_MS
+ * \brief Silence après lequel un travailleur est considéré comme mort
+ */
+#define CLUSTER_TIMEOUT_MS 5000
+
+/**
+ * \def CLUSTER_PIPELINE_MS
+ * \brief Travail estimé confié d'avance à chaque travailleur
+ */
+#define CLUSTER_PIPELINE_MS 250
+
+/**
+ * \def CLUSTER_INFLIGHT_MAX
+ * \brief Nombre maximum de tuiles confiées à un travailleur en même temps
+ */
+#define CLUSTER_INFLIGHT_MAX 8
+
+/**
+ * \def CLUSTER_WORKERS_MAX
+ * \brief Nombre maximum de travailleurs connectés
+ */
+#define CLUSTER_WORKERS_MAX 64
+
+/**
+ * \def CLUSTER_PREVIEW
+ * \brief Côté de l'aperçu de chaque tuile, en points, pour estimer son coût
+ */
+#define CLUSTER_PREVIEW 8
+
+/**
+ * \def CLUSTER_PREVIEW_MAX
+ * \brief Nombre maximum de points de l'aperçu (le côté par tuile diminue au delà)
+ */
+#define CLUSTER_PREVIEW_MAX (4 * 1024 * 1024)
+
+/**
+ * \def CLUSTER_CONNECT_TRIES
+ * \brief Nombre de tentatives de connexion d'un travailleur, une par seconde
+ */
+#define CLUSTER_CONNECT_TRIES 30
+
+/* Structures */
+
+/**
+ * \struct clusterWorker
+ * \brief Un travailleur connecté, vu du coordinateur
+ * 
+*/
+typedef struct
+{
+	int		socket;				/*!< Connexion, -1 pour une place libre */
+	int		id;				/*!< Numéro du travailleur, pour les messages */
+	int		threads;			/*!< Threads du travailleur, 0 avant CLUSTER_HELLO */
+	double		lastHeard;			/*!< Dernier message reçu, en ms */
+	int		inflight[CLUSTER_INFLIGHT_MAX];	/*!< Tuiles confiées, pas encore revenues */
+	int		inflightCount;			/*!< Nombre de tuiles confiées */
+	double		speed;				/*!< Coût estimé calculé par ms, 0 avant la première tuile */
+	int		tiles;				/*!< Tuiles calculées */
+	double		busyMs;				/*!< Temps de calcul total des tuiles */
+	unsigned char	header[8];			/*!< En-tête du message en cours de réception */
+	size_t		received;			/*!< Octets reçus du message en cours */
+	uint32_t	type;				/*!< Type du message en cours */
+	uint32_t	length;				/*!< Taille du contenu du message en cours */
+	unsigned char	*payload;			/*!< Contenu du message en cours */
+} clusterWorker;
+
+/**
+ * \struct cluster
+ * \brief Calcul réparti en cours, côté coordinateur
+ * 
+*/
+typedef struct
+{
+	int		listener;			/*!< Socket d'écoute */
+	const char	*address;			/*!< Adresse d'écoute */
+	fractalSettings	image;				/*!< Paramètres de l'image entière */
+	int		tileSize;			/*!< Côté des tuiles en pixels */
+	int		tiles;				/*!< Nombre de tuiles de l'image */
+	int		remaining;			/*!< Tuiles pas encore revenues */
+	unsigned char	*state;				/*!< État de chaque tuile : à faire, confiée, finie */
+	double		*cost;				/*!< Coût estimé de chaque tuile, en itérations */
+	int		*order;				/*!< Tuiles par coût décroissant */
+	int		cursor;				/*!< Début de order pouvant contenir une tuile à faire */
+	clusterWorker	workers[CLUSTER_WORKERS_MAX];	/*!< Travailleurs */
+	int		nextId;				/*!< Numéro du prochain travailleur */
+	int		reassigned;			/*!< Tuiles confiées à nouveau après une perte */
+	iterationBuffer	*result;			/*!< Indices de la dernière tuile revenue */
+} cluster;
+
+/* Prototypes */
+
+bool clusterOpen(cluster *c, const char *address, fractalSettings image, int tileSize, const unsigned char *done);
+int clusterNext(cluster *c);
+void clusterClose(cluster *c);
+bool clusterComputeFrame(const char *address, fractalSettings fSet, int tileSize, iterationBuffer *buffer);
+int clusterWorkerMain(int argc, char *argv[]);
+
+#endif /* H_CLUSTER */
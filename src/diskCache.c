@@ -0,0 +1,663 @@
+/**
+ * \file diskCache.c
+ * \brief Fichier source, cache disque des fractales complexes calculées
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les tampons d'itérations calculés sont gardés sur le disque, d'un
+ * lancement à l'autre. Ils sont ajoutés à la fin d'un paquet projeté en
+ * mémoire (tiles.pack), un index (tiles.idx) donne la position de chacun.
+ * 
+ */
+
+#include "diskCache.h"
+
+#ifndef _WIN32
+
+#include <math.h>
+#include <time.h>
+#include <errno.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Signatures des deux fichiers (8 octets) */
+#define PACK_MAGIC "LIFETIL1"
+#define INDEX_MAGIC "LIFEIDX1"
+
+/* Chemins des fichiers, vides si le cache est désactivé */
+static char packPath[1024] = "";
+static char indexPath[1024] = "";
+
+/* Index chargé en mémoire */
+static diskCacheRecord *records = NULL;
+static long recordCount = 0;
+static long recordCapacity = 0;
+
+/* Paquet projeté en mémoire */
+static unsigned char *packMap = NULL;
+static size_t packMapSize = 0;
+static ino_t packInode = 0;
+
+/**
+ * \fn static bool cacheDirectory(const char *directory, char *path, size_t size);
+ * \brief Choisit et crée le répertoire du cache
+ * 
+ * \param directory Répertoire imposé, NULL pour le répertoire par défaut
+ * \param path Chemin du répertoire choisi
+ * \param size Taille de \e path
+ * \return Vrai si le répertoire existe, Faux si le cache est désactivé
+ */
+static bool cacheDirectory(const char *directory, char *path, size_t size)
+{
+	const char *env = NULL;
+	
+	if (directory == NULL)
+		directory = getenv("LIFE_CACHE_DIR");
+	
+	if (directory != NULL)
+	{
+		/* Une variable vide désactive le cache */
+		if (directory[0] == '\0')
+			return false;
+		
+		snprintf(path, size, "%s", directory);
+	}
+	else if ((env = getenv("XDG_CACHE_HOME")) != NULL && env[0] != '\0')
+	{
+		snprintf(path, size, "%s/LiFE", env);
+	}
+	else if ((env = getenv("HOME")) != NULL && env[0] != '\0')
+	{
+		snprintf(path, size, "%s/.cache", env);
+		mkdir(path, 0777);
+		snprintf(path, size, "%s/.cache/LiFE", env);
+	}
+	else
+		return false;
+	
+	if (mkdir(path, 0777) < 0 && errno != EEXIST)
+		return false;
+	
+	return access(path, R_OK | W_OK | X_OK) == 0;
+}
+
+/**
+ * \fn static uint64_t keyHash(const diskTileKey *key);
+ * \brief Empreinte FNV-1a 64 bits d'une clé
+ * 
+ * \param key Clé à hacher
+ * \return L'empreinte
+ */
+static uint64_t keyHash(const diskTileKey *key)
+{
+	const unsigned char *bytes = (const unsigned char*) key;
+	uint64_t hash = 14695981039346656037ULL;
+	size_t i;
+	
+	for (i = 0; i < sizeof(diskTileKey); i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	
+	return hash;
+}
+
+/**
+ * \fn static bool keyMake(fractalSettings fSet, iterationBuffer *buffer, diskTileKey *key);
+ * \brief Construit la clé d'une fractale
+ * 
+ * \param fSet Paramètres de la fractale
+ * \param buffer Tampon d'itérations (pour sa taille)
+ * \param key Clé construite
+ * \return Faux si la vue est trop petite pour être arrondie sur 64 bits
+ */
+static bool keyMake(fractalSettings fSet, iterationBuffer *buffer, diskTileKey *key)
+{
+	/* Coordonnées en fractions de pixel */
+	double scale = DISK_CACHE_QUANTUM * buffer->width / (fSet.realMax - fSet.realMin);
+	double limit = 9E18;
+	
+	if (!(fabs(fSet.realMin * scale) < limit && fabs(fSet.realMax * scale) < limit
+		&& fabs(fSet.imagMin * scale) < limit && fabs(fSet.imagMax * scale) < limit))
+		return false;
+	
+	/* Mise à zéro complète : la clé est hachée et comparée octet par octet */
+	memset(key, 0, sizeof(diskTileKey));
+	
+	key->fractalId = fSet.fractalId;
+	key->iterMax = fSet.iterMax;
+	key->width = buffer->width;
+	key->height = buffer->height;
+	key->realMin = llround(fSet.realMin * scale);
+	key->realMax = llround(fSet.realMax * scale);
+	key->imagMin = llround(fSet.imagMin * scale);
+	key->imagMax = llround(fSet.imagMax * scale);
+	
+	if (fSet.fractalId == COMPLEX_NEWTON)
+		key->newtonPower = fSet.newtonPower;
+	
+	if (fSet.fractalId == COMPLEX_JULIA)
+	{
+		key->juliaReal = fSet.cstJulia.real;
+		key->juliaImag = fSet.cstJulia.imag;
+	}
+	
+	return true;
+}
+
+/**
+ * \fn static void packUnmap(void);
+ * \brief Libère la projection du paquet
+ * 
+ * \return Rien
+ */
+static void packUnmap(void)
+{
+	if (packMap != NULL)
+		munmap(packMap, packMapSize);
+	
+	packMap = NULL;
+	packMapSize = 0;
+}
+
+/**
+ * \fn static void indexLoad(bool locked);
+ * \brief Lit les entrées de l'index ajoutées depuis la dernière lecture
+ * 
+ * \param locked Vrai si le programme tient déjà le verrou de l'index
+ * \return Rien
+ */
+static void indexLoad(bool locked)
+{
+	struct stat info;
+	char magic[8];
+	long count, i;
+	int fd = open(indexPath, O_RDONLY);
+	
+	if (fd < 0)
+		return;
+	
+	if (!locked)
+		flock(fd, LOCK_SH);
+	
+	if (fstat(fd, &info) == 0 && info.st_size >= 8
+		&& pread(fd, magic, 8, 0) == 8 && memcmp(magic, INDEX_MAGIC, 8) == 0)
+	{
+		/* Une entrée en cours d'écriture (incomplète) est ignorée */
+		count = (info.st_size - 8) / sizeof(diskCacheRecord);
+		
+		if (count > recordCapacity)
+		{
+			diskCacheRecord *grown = (diskCacheRecord*) realloc(records, count * sizeof(diskCacheRecord));
+			
+			if (grown != NULL)
+			{
+				records = grown;
+				recordCapacity = count;
+			}
+			else
+				count = recordCapacity;
+		}
+		
+		i = recordCount;
+		if (count > i && pread(fd, records + i, (count - i) * sizeof(diskCacheRecord),
+				8 + i * sizeof(diskCacheRecord)) == (ssize_t) ((count - i) * sizeof(diskCacheRecord)))
+			recordCount = count;
+	}
+	
+	if (!locked)
+		flock(fd, LOCK_UN);
+	
+	close(fd);
+}
+
+/**
+ * \fn static void cacheSync(bool locked);
+ * \brief Met à jour l'index et la projection après les écritures d'autres programmes
+ * 
+ * \param locked Vrai si le programme tient déjà le verrou de l'index
+ * \return Rien
+ */
+static void cacheSync(bool locked)
+{
+	struct stat info;
+	void *data;
+	int fd;
+	
+	if (stat(packPath, &info) < 0)
+	{
+		packUnmap();
+		recordCount = 0;
+		return;
+	}
+	
+	/* Le paquet a été réécrit (éviction) : on recharge tout */
+	if (info.st_ino != packInode)
+	{
+		packUnmap();
+		recordCount = 0;
+	}
+	
+	if (packMap == NULL || (size_t) info.st_size > packMapSize)
+	{
+		fd = open(packPath, O_RDONLY);
+		if (fd < 0)
+			return;
+		
+		if (fstat(fd, &info) == 0 && info.st_size > 0)
+		{
+			data = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			
+			if (data != MAP_FAILED)
+			{
+				packUnmap();
+				packMap = (unsigned char*) data;
+				packMapSize = info.st_size;
+				packInode = info.st_ino;
+			}
+		}
+		
+		close(fd);
+	}
+	
+	indexLoad(locked);
+}
+
+/**
+ * \fn static int indexLock(void);
+ * \brief Ouvre l'index pour y écrire et prend le verrou exclusif
+ * 
+ * \return Descripteur de l'index verrouillé, -1 en cas d'erreur
+ */
+static int indexLock(void)
+{
+	struct stat opened, current;
+	int fd;
+	
+	while (true)
+	{
+		fd = open(indexPath, O_RDWR | O_CREAT, 0666);
+		if (fd < 0)
+			return -1;
+		
+		flock(fd, LOCK_EX);
+		
+		/* L'index a pu être remplacé pendant l'attente du verrou */
+		if (fstat(fd, &opened) == 0 && stat(indexPath, &current) == 0
+			&& opened.st_ino == current.st_ino)
+			return fd;
+		
+		flock(fd, LOCK_UN);
+		close(fd);
+	}
+}
+
+/**
+ * \fn static int recordCompare(const void *a, const void *b);
+ * \brief Tri des entrées, de la plus récemment utilisée à la plus ancienne
+ * 
+ * \param a Première entrée
+ * \param b Seconde entrée
+ * \return Ordre des deux entrées (qsort)
+ */
+static int recordCompare(const void *a, const void *b)
+{
+	const diskCacheRecord *ra = (const diskCacheRecord*) a;
+	const diskCacheRecord *rb = (const diskCacheRecord*) b;
+	
+	if (ra->lastUse != rb->lastUse)
+		return ra->lastUse < rb->lastUse ? 1 : -1;
+	
+	/* A date égale, la plus récemment ajoutée d'abord */
+	return ra->offset < rb->offset ? 1 : (ra->offset > rb->offset ? -1 : 0);
+}
+
+/**
+ * \fn static void cacheEvict(void);
+ * \brief Réécrit le cache avec les fractales les plus récemment utilisées
+ * \remark Le verrou de l'index doit être tenu.
+ * 
+ * \return Rien
+ */
+static void cacheEvict(void)
+{
+	char packTemp[1040], indexTemp[1040];
+	diskCacheRecord *sorted = NULL;
+	diskCacheRecord record;
+	uint64_t offset = 8;
+	size_t bytes;
+	long i;
+	FILE *pack = NULL, *index = NULL;
+	
+	cacheSync(true);
+	if (packMap == NULL || recordCount == 0)
+		return;
+	
+	sorted = (diskCacheRecord*) malloc(recordCount * sizeof(diskCacheRecord));
+	if (sorted == NULL)
+		return;
+	
+	memcpy(sorted, records, recordCount * sizeof(diskCacheRecord));
+	qsort(sorted, recordCount, sizeof(diskCacheRecord), recordCompare);
+	
+	snprintf(packTemp, sizeof(packTemp), "%s.tmp", packPath);
+	snprintf(indexTemp, sizeof(indexTemp), "%s.tmp", indexPath);
+	
+	pack = fopen(packTemp, "wb");
+	index = fopen(indexTemp, "wb");
+	
+	if (pack == NULL || index == NULL)
+	{
+		if (pack != NULL)
+			fclose(pack);
+		if (index != NULL)
+			fclose(index);
+		free(sorted);
+		return;
+	}
+	
+	fwrite(PACK_MAGIC, 1, 8, pack);
+	fwrite(INDEX_MAGIC, 1, 8, index);
+	
+	/* On garde les plus récentes jusqu'à la moitié de la taille maximum */
+	for (i = 0; i < recordCount; i++)
+	{
+		record = sorted[i];
+		bytes = sizeof(diskCacheBlob) + record.length * sizeof(unsigned short);
+		
+		if (record.offset + bytes > packMapSize)
+			continue;
+		
+		if (offset + bytes > DISK_CACHE_MAX / 2)
+			break;
+		
+		fwrite(packMap + record.offset, 1, bytes, pack);
+		record.offset = offset;
+		fwrite(&record, sizeof(record), 1, index);
+		
+		offset += bytes;
+	}
+	
+	fclose(pack);
+	fclose(index);
+	free(sorted);
+	
+	/* Les autres programmes voient le changement de paquet et rechargent */
+	rename(indexTemp, indexPath);
+	rename(packTemp, packPath);
+	
+	packUnmap();
+	recordCount = 0;
+}
+
+/**
+ * \fn bool diskCacheOpen(const char *directory);
+ * \brief Ouvre le cache disque
+ * 
+ * \param directory Répertoire du cache, NULL pour le répertoire par défaut
+ * \return Vrai si le cache est utilisable, Faux sinon (cache désactivé)
+ */
+bool diskCacheOpen(const char *directory)
+{
+	char path[1000];
+	
+	diskCacheClose();
+	
+	if (!cacheDirectory(directory, path, sizeof(path)))
+		return false;
+	
+	snprintf(packPath, sizeof(packPath), "%s/tiles.pack", path);
+	snprintf(indexPath, sizeof(indexPath), "%s/tiles.idx", path);
+	
+	cacheSync(false);
+	
+	return true;
+}
+
+/**
+ * \fn void diskCacheClose(void);
+ * \brief Ferme le cache disque
+ * 
+ * \return Rien
+ */
+void diskCacheClose(void)
+{
+	packUnmap();
+	packInode = 0;
+	
+	free(records);
+	records = NULL;
+	recordCount = 0;
+	recordCapacity = 0;
+	
+	packPath[0] = '\0';
+	indexPath[0] = '\0';
+}
+
+/**
+ * \fn static long recordFind(const diskTileKey *key, uint64_t hash);
+ * \brief Cherche la dernière entrée de l'index ayant cette clé
+ * 
+ * \param key Clé cherchée
+ * \param hash Empreinte de la clé
+ * \return Numéro de l'entrée, -1 si absente
+ */
+static long recordFind(const diskTileKey *key, uint64_t hash)
+{
+	long i;
+	
+	for (i = recordCount - 1; i >= 0; i--)
+		if (records[i].hash == hash && memcmp(&records[i].key, key, sizeof(diskTileKey)) == 0)
+			return i;
+	
+	return -1;
+}
+
+/**
+ * \fn bool diskCacheFetch(fractalSettings fSet, iterationBuffer *buffer);
+ * \brief Cherche une fractale dans le cache disque et la copie dans le tampon
+ * 
+ * \param fSet Paramètres de la fractale voulue
+ * \param buffer Tampon d'itérations à remplir
+ * \return Vrai si la fractale était dans le cache, Faux sinon
+ */
+bool diskCacheFetch(fractalSettings fSet, iterationBuffer *buffer)
+{
+	diskTileKey key;
+	diskCacheRecord *record = NULL;
+	const diskCacheBlob *blob = NULL;
+	long count = (long) buffer->width * buffer->height;
+	long i;
+	uint64_t now = time(NULL);
+	int fd;
+	
+	if (packPath[0] == '\0')
+		return false;
+	
+	if (!keyMake(fSet, buffer, &key))
+		return false;
+	
+	/* Pas dans l'index chargé : un autre programme l'a peut-être ajoutée */
+	i = recordFind(&key, keyHash(&key));
+	if (i < 0)
+	{
+		cacheSync(false);
+		i = recordFind(&key, keyHash(&key));
+	}
+	
+	if (i < 0 || packMap == NULL)
+		return false;
+	
+	record = &records[i];
+	
+	if (record->offset + sizeof(diskCacheBlob) + record->length * sizeof(unsigned short) > packMapSize)
+		return false;
+	
+	/* L'en-tête des données doit correspondre à l'index */
+	blob = (const diskCacheBlob*) (packMap + record->offset);
+	if (blob->hash != record->hash || blob->length != record->length
+		|| blob->compressed != record->compressed)
+		return false;
+	
+	if (!record->compressed)
+	{
+		if (record->length != (uint32_t) count)
+			return false;
+		
+		memcpy(buffer->data, blob + 1, count * sizeof(unsigned short));
+	}
+	else if (!rleDecode((const unsigned short*) (blob + 1), record->length, buffer->data, count))
+		return false;
+	
+	/* Date d'utilisation, pour garder les fractales revisitées. Sous le
+	 * verrou : un autre programme a pu compacter l'index depuis la lecture,
+	 * l'entrée est donc cherchée à nouveau avant d'écrire à sa place. */
+	if (now > record->lastUse)
+	{
+		fd = indexLock();
+		if (fd >= 0)
+		{
+			cacheSync(true);
+			i = recordFind(&key, keyHash(&key));
+			
+			if (i >= 0 && now > records[i].lastUse
+				&& pwrite(fd, &now, sizeof(now),
+					8 + i * sizeof(diskCacheRecord) + offsetof(diskCacheRecord, lastUse))
+					== (ssize_t) sizeof(now))
+				records[i].lastUse = now;
+			
+			flock(fd, LOCK_UN);
+			close(fd);
+		}
+	}
+	
+	return true;
+}
+
+/**
+ * \fn void diskCacheStore(fractalSettings fSet, iterationBuffer *buffer);
+ * \brief Ajoute une fractale calculée au cache disque
+ * 
+ * \param fSet Paramètres de la fractale calculée
+ * \param buffer Tampon d'itérations calculé
+ * \return Rien
+ */
+void diskCacheStore(fractalSettings fSet, iterationBuffer *buffer)
+{
+	diskCacheRecord record;
+	diskCacheBlob blob;
+	struct stat info;
+	long count = (long) buffer->width * buffer->height;
+	long length;
+	unsigned short *data = NULL;
+	int indexFd, packFd;
+	bool written = false;
+	
+	if (packPath[0] == '\0')
+		return;
+	
+	memset(&record, 0, sizeof(record));
+	if (!keyMake(fSet, buffer, &record.key))
+		return;
+	record.hash = keyHash(&record.key);
+	record.lastUse = time(NULL);
+	
+	/* On compresse, ou on garde les indices tels quels si ça ne gagne rien */
+	data = (unsigned short*) malloc(count * sizeof(unsigned short));
+	if (data == NULL)
+		return;
+	
+	length = rleEncode(buffer->data, count, data, count);
+	record.compressed = length >= 0;
+	record.length = length >= 0 ? length : count;
+	
+	memset(&blob, 0, sizeof(blob));
+	blob.hash = record.hash;
+	blob.length = record.length;
+	blob.compressed = record.compressed;
+	
+	indexFd = indexLock();
+	if (indexFd < 0)
+	{
+		free(data);
+		return;
+	}
+	
+	packFd = open(packPath, O_WRONLY | O_APPEND | O_CREAT, 0666);
+	
+	if (packFd >= 0 && fstat(packFd, &info) == 0)
+	{
+		/* Nouveau paquet : signature en tête */
+		if (info.st_size == 0 && write(packFd, PACK_MAGIC, 8) == 8)
+			info.st_size = 8;
+		
+		record.offset = info.st_size;
+		
+		/* Les données d'abord, l'index ne désigne jamais des données absentes */
+		written = write(packFd, &blob, sizeof(blob)) == sizeof(blob)
+			&& write(packFd, record.compressed ? data : buffer->data,
+				record.length * sizeof(unsigned short))
+				== (ssize_t) (record.length * sizeof(unsigned short));
+		
+		/* Puis l'entrée, à la suite des entrées complètes de l'index */
+		if (written && fstat(indexFd, &info) == 0)
+		{
+			if (info.st_size < 8)
+			{
+				pwrite(indexFd, INDEX_MAGIC, 8, 0);
+				info.st_size = 8;
+			}
+			
+			info.st_size = 8 + (info.st_size - 8) / sizeof(diskCacheRecord) * sizeof(diskCacheRecord);
+			pwrite(indexFd, &record, sizeof(record), info.st_size);
+		}
+		
+		/* Paquet trop gros : on garde les fractales les plus récentes */
+		if (written && record.offset + sizeof(blob) + record.length * sizeof(unsigned short) > DISK_CACHE_MAX)
+			cacheEvict();
+	}
+	
+	if (packFd >= 0)
+		close(packFd);
+	
+	flock(indexFd, LOCK_UN);
+	close(indexFd);
+	free(data);
+}
+
+#else /* _WIN32 */
+
+/* Pas de cache disque sous Windows (mmap et verrous POSIX) */
+
+bool diskCacheOpen(const char *directory)
+{
+	(void) directory;
+	return false;
+}
+
+void diskCacheClose(void)
+{
+}
+
+bool diskCacheFetch(fractalSettings fSet, iterationBuffer *buffer)
+{
+	(void) fSet;
+	(void) buffer;
+	return false;
+}
+
+void diskCacheStore(fractalSettings fSet, iterationBuffer *buffer)
+{
+	(void) fSet;
+	(void) buffer;
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,110 @@
+/**
+ * \file diskCache.h
+ * \brief Fichier d'entête, cache disque des fractales complexes calculées
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les tampons d'itérations calculés sont gardés sur le disque, d'un
+ * lancement à l'autre. Ils sont ajoutés à la fin d'un paquet projeté en
+ * mémoire (tiles.pack), un index (tiles.idx) donne la position de chacun.
+ * 
+ * Le répertoire est LIFE_CACHE_DIR s'il est défini (vide pour désactiver le
+ * cache), sinon $XDG_CACHE_HOME/LiFE ou ~/.cache/LiFE. Un répertoire commun
+ * permet de partager le cache entre plusieurs utilisateurs d'une machine,
+ * les écritures sont protégées par un verrou sur l'index.
+ * 
+ */
+
+#ifndef H_DISK_CACHE
+#define H_DISK_CACHE
+
+#include <stdint.h>
+
+#include "renderCache.h"
+
+/* Macros */
+
+/**
+ * \def DISK_CACHE_MAX
+ * \brief Taille maximum du paquet sur le disque (octets)
+ * 
+ * Au delà, le paquet est réécrit avec les fractales utilisées le plus
+ * récemment, jusqu'à la moitié de cette taille.
+ */
+#define DISK_CACHE_MAX (256L * 1024 * 1024)
+
+/**
+ * \def DISK_CACHE_QUANTUM
+ * \brief Précision des coordonnées dans la clé, en fraction de pixel
+ * 
+ * Deux vues qui diffèrent de moins d'un 1/16 de pixel ont la même clé.
+ */
+#define DISK_CACHE_QUANTUM 16
+
+/* Structures */
+
+/**
+ * \struct diskTileKey
+ * \brief Clé d'une fractale dans le cache disque
+ * 
+ * Les coordonnées sont arrondies (voir DISK_CACHE_QUANTUM), les paramètres
+ * inutiles à la fractale sont à zéro.
+ * 
+*/
+typedef struct
+{
+	int32_t		fractalId;	/*!< Identifiant de la fractale */
+	int32_t		iterMax;	/*!< Nombre d'itérations */
+	int32_t		width;		/*!< Largeur du tampon en pixels */
+	int32_t		height;		/*!< Hauteur du tampon en pixels */
+	int32_t		newtonPower;	/*!< Degré du polynome (Newton) */
+	int32_t		reserved;	/*!< Inutilisé (alignement) */
+	int64_t		realMin;	/*!< Minimum en abscisse, arrondi */
+	int64_t		realMax;	/*!< Maximum en abscisse, arrondi */
+	int64_t		imagMin;	/*!< Minimum en ordonnée, arrondi */
+	int64_t		imagMax;	/*!< Maximum en ordonnée, arrondi */
+	double		juliaReal;	/*!< Partie réelle de la constante (Julia) */
+	double		juliaImag;	/*!< Partie imaginaire de la constante (Julia) */
+} diskTileKey;
+
+/**
+ * \struct diskCacheRecord
+ * \brief Entrée de l'index du cache disque (tiles.idx)
+ * 
+*/
+typedef struct
+{
+	uint64_t	hash;		/*!< Empreinte FNV-1a de la clé */
+	diskTileKey	key;		/*!< Clé complète (vérifiée à la lecture) */
+	uint64_t	offset;		/*!< Position des données dans tiles.pack */
+	uint32_t	length;		/*!< Nombre de valeurs 16 bits */
+	uint32_t	compressed;	/*!< 1 si les données sont compressées par plages */
+	uint64_t	lastUse;	/*!< Date de la dernière utilisation (secondes) */
+} diskCacheRecord;
+
+/**
+ * \struct diskCacheBlob
+ * \brief En-tête des données d'une fractale dans tiles.pack
+ * 
+ * Permet de vérifier que l'index et le paquet correspondent bien, même
+ * pendant qu'un autre programme réécrit le cache.
+ * 
+*/
+typedef struct
+{
+	uint64_t	hash;		/*!< Empreinte de la clé */
+	uint32_t	length;		/*!< Nombre de valeurs 16 bits */
+	uint32_t	compressed;	/*!< 1 si les données sont compressées par plages */
+} diskCacheBlob;
+
+/* Prototypes */
+
+bool diskCacheOpen(const char *directory);
+void diskCacheClose(void);
+bool diskCacheFetch(fractalSettings fSet, iterationBuffer *buffer);
+void diskCacheStore(fractalSettings fSet, iterationBuffer *buffer);
+
+#endif /* H_DISK_CACHE */
@@ -0,0 +1,185 @@
+/**
+ * \file dynamicResolution.c
+ * \brief Fichier source, résolution de calcul adaptée au temps disponible
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Chaque calcul mesure le nombre de pixels calculés par milliseconde.
+ * Pendant une interaction, la fractale est calculée à une résolution
+ * réduite (un pixel sur DYNRES_SCALE_MAX au plus dans chaque direction),
+ * choisie pour tenir en DYNRES_BUDGET millisecondes, puis agrandie.
+ * Une fois l'utilisateur immobile, elle est recalculée à la résolution
+ * de l'écran.
+ * 
+ */
+
+#include "dynamicResolution.h"
+
+/**
+ * \fn dynamicResolution* dynamicResolutionCreate(int width, int height);
+ * \brief Alloue la mesure du débit et le tampon de résolution réduite
+ * 
+ * \param width Largeur de l'écran en pixels
+ * \param height Hauteur de l'écran en pixels
+ * \return Un pointeur vers la structure allouée
+ */
+dynamicResolution* dynamicResolutionCreate(int width, int height)
+{
+	dynamicResolution *dr = (dynamicResolution*) malloc(sizeof(dynamicResolution));
+	
+	/* Assez grand pour toutes les résolutions réduites */
+	if (dr != NULL)
+		dr->low = iterationBufferCreate(width, height);
+	
+	if (dr == NULL || dr->low == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation de la résolution dynamique\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	dr->throughput = 0;
+	dr->scale = 1;
+	dr->refine = false;
+	dr->lastRender = 0;
+	
+	return dr;
+}
+
+/**
+ * \fn void dynamicResolutionFree(dynamicResolution *dr);
+ * \brief Libère la mesure du débit et son tampon
+ * 
+ * \param dr Pointeur vers la structure
+ * \return Rien
+ */
+void dynamicResolutionFree(dynamicResolution *dr)
+{
+	if (dr != NULL)
+	{
+		iterationBufferFree(dr->low);
+		free(dr);
+	}
+}
+
+/**
+ * \fn void dynamicResolutionMeasure(dynamicResolution *dr, long pixels, Uint32 time);
+ * \brief Prend en compte la durée d'un calcul dans le débit moyen
+ * 
+ * \param dr Pointeur vers la structure
+ * \param pixels Nombre de pixels calculés
+ * \param time Durée du calcul en millisecondes
+ * \return Rien
+ */
+void dynamicResolutionMeasure(dynamicResolution *dr, long pixels, Uint32 time)
+{
+	double sample = (double) pixels / (time > 0 ? time : 1);
+	
+	if (dr->throughput <= 0)
+		dr->throughput = sample;
+	else
+		dr->throughput = (dr->throughput + sample) / 2.0;
+}
+
+/**
+ * \fn int dynamicResolutionChoose(dynamicResolution *dr, int width, int height, Uint32 budget);
+ * \brief Choisit le diviseur de résolution qui tient dans le temps accordé
+ * 
+ * \param dr Pointeur vers la structure
+ * \param width Largeur de l'écran en pixels
+ * \param height Hauteur de l'écran en pixels
+ * \param budget Temps de calcul accordé en millisecondes
+ * \return Le diviseur, 1 pour la résolution de l'écran
+ */
+int dynamicResolutionChoose(dynamicResolution *dr, int width, int height, Uint32 budget)
+{
+	int scale;
+	
+	/* Rien de mesuré : on calcule à la résolution de l'écran */
+	if (dr->throughput <= 0)
+		return 1;
+	
+	/* Le coût est proportionnel au nombre de pixels, soit 1 / scale² */
+	scale = (int) ceil(sqrt((double) width * height / (dr->throughput * budget)));
+	
+	if (scale < 1)
+		scale = 1;
+	if (scale > DYNRES_SCALE_MAX)
+		scale = DYNRES_SCALE_MAX;
+	
+	return scale;
+}
+
+/**
+ * \fn void dynamicResolutionRender(dynamicResolution *dr, fractalSettings view, iterationBuffer *buffer, int scale);
+ * \brief Calcule la vue à résolution réduite et l'agrandit dans le tampon
+ * 
+ * Chaque pixel calculé remplit un carré de scale x scale pixels.
+ * 
+ * \param dr Pointeur vers la structure
+ * \param view Paramètres de la vue à l'écran
+ * \param buffer Tampon recevant les indices, à la taille de l'écran
+ * \param scale Diviseur de la résolution
+ * \return Rien
+ */
+void dynamicResolutionRender(dynamicResolution *dr, fractalSettings view, iterationBuffer *buffer, int scale)
+{
+	fractalSettings low = view;
+	double pixelWidth = (view.realMax - view.realMin) / view.screenWidth;
+	double pixelHeight = (view.imagMax - view.imagMin) / view.screenHeight;
+	unsigned short *row;
+	int x, y;
+	Uint32 start;
+	
+	/* Le repère couvre scale x scale pixels de l'écran par pixel calculé */
+	low.screenWidth = (buffer->width + scale - 1) / scale;
+	low.screenHeight = (buffer->height + scale - 1) / scale;
+	low.realMax = view.realMin + low.screenWidth * scale * pixelWidth;
+	low.imagMax = view.imagMin + low.screenHeight * scale * pixelHeight;
+	
+	dr->low->width = low.screenWidth;
+	dr->low->height = low.screenHeight;
+	
+	start = SDL_GetTicks();
+	computeComplexParallel(low, dr->low);
+	dynamicResolutionMeasure(dr, (long) low.screenWidth * low.screenHeight, SDL_GetTicks() - start);
+	
+	for (y = 0; y < buffer->height; y++)
+	{
+		row = dr->low->data + (y / scale) * dr->low->width;
+		
+		for (x = 0; x < buffer->width; x++)
+			buffer->data[y * buffer->width + x] = row[x / scale];
+	}
+	
+	dr->scale = scale;
+	dr->refine = true;
+	dr->lastRender = SDL_GetTicks();
+}
+
+/**
+ * \fn void dynamicResolutionNative(dynamicResolution *dr);
+ * \brief Indique que l'image affichée est à la résolution de l'écran
+ * 
+ * \param dr Pointeur vers la structure
+ * \return Rien
+ */
+void dynamicResolutionNative(dynamicResolution *dr)
+{
+	dr->scale = 1;
+	dr->refine = false;
+}
+
+/**
+ * \fn bool dynamicResolutionSettled(dynamicResolution *dr);
+ * \brief Indique s'il est temps de recalculer à la résolution de l'écran
+ * 
+ * \param dr Pointeur vers la structure
+ * \return Vrai si l'image est réduite et qu'aucun calcul réduit n'a eu lieu depuis DYNRES_SETTLE ms
+ */
+bool dynamicResolutionSettled(dynamicResolution *dr)
+{
+	return dr->refine && SDL_GetTicks() - dr->lastRender >= DYNRES_SETTLE;
+}
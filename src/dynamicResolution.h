@@ -0,0 +1,70 @@
+/**
+ * \file dynamicResolution.h
+ * \brief Fichier d'entête, résolution de calcul adaptée au temps disponible
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Chaque calcul mesure le nombre de pixels calculés par milliseconde.
+ * Pendant une interaction, la fractale est calculée à une résolution
+ * réduite (un pixel sur DYNRES_SCALE_MAX au plus dans chaque direction),
+ * choisie pour tenir en DYNRES_BUDGET millisecondes, puis agrandie.
+ * Une fois l'utilisateur immobile, elle est recalculée à la résolution
+ * de l'écran.
+ * 
+ */
+
+#ifndef H_DYNAMIC_RESOLUTION
+#define H_DYNAMIC_RESOLUTION
+
+#include "engine.h"
+
+/* Macros */
+
+/**
+ * \def DYNRES_BUDGET
+ * \brief Temps de calcul visé pour une image pendant une interaction, en millisecondes
+ */
+#define DYNRES_BUDGET 20
+
+/**
+ * \def DYNRES_SCALE_MAX
+ * \brief Plus grand diviseur de la résolution de calcul
+ */
+#define DYNRES_SCALE_MAX 8
+
+/**
+ * \def DYNRES_SETTLE
+ * \brief Temps sans interaction avant de recalculer à la résolution de l'écran, en millisecondes
+ */
+#define DYNRES_SETTLE 200
+
+/* Structures */
+
+/**
+ * \struct dynamicResolution
+ * \brief Mesure du débit de calcul et résolution de la dernière image
+ * 
+*/
+typedef struct
+{
+	double		throughput;	/*!< Pixels calculés par milliseconde (moyenne), 0 si inconnu */
+	int		scale;		/*!< Diviseur de la résolution de la dernière image (1 : écran) */
+	bool		refine;		/*!< Vrai si l'image affichée est à recalculer à la résolution de l'écran */
+	Uint32		lastRender;	/*!< Instant du dernier calcul réduit (SDL_GetTicks) */
+	iterationBuffer	*low;		/*!< Indices calculés à résolution réduite */
+} dynamicResolution;
+
+/* Prototypes */
+
+dynamicResolution* dynamicResolutionCreate(int width, int height);
+void dynamicResolutionFree(dynamicResolution *dr);
+void dynamicResolutionMeasure(dynamicResolution *dr, long pixels, Uint32 time);
+int dynamicResolutionChoose(dynamicResolution *dr, int width, int height, Uint32 budget);
+void dynamicResolutionRender(dynamicResolution *dr, fractalSettings view, iterationBuffer *buffer, int scale);
+void dynamicResolutionNative(dynamicResolution *dr);
+bool dynamicResolutionSettled(dynamicResolution *dr);
+
+#endif /* H_DYNAMIC_RESOLUTION */
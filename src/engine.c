@@ -14,31 +14,124 @@
 
 #include "engine.h"
 
+/* Surface de la fenêtre en mode logiciel, NULL en mode OpenGL */
+static SDL_Surface *framebuffer = NULL;
+
+/* Surface dans laquelle dessinent les primitives en mode logiciel */
+static SDL_Surface *target = NULL;
+
+/* Calque de la fractale : texture (OpenGL) ou surface (logiciel) */
+static GLuint layerList = 0;
+static GLuint layerTexture = 0;
+static SDL_Surface *layerSurface = NULL;
+
+/* Minuteur de rafraîchissement des informations */
+static SDL_TimerID overlayTimer = NULL;
+
+/* Images dont la texture est en mémoire vidéo */
+static image *residentImages[TEXTURE_MAX] = {NULL};
+static long residentBytes = 0;
+static unsigned int textureClock = 0;
+
+/* Textures des caractères, une par police ouverte */
+static glyphAtlas *atlases[ATLAS_MAX] = {NULL};
+
+
+/**
+ * \fn static SDL_Surface* assetSurface(const char *name);
+ * \brief Crée une surface sur une image décodée du paquet de ressources
+ * \remark Les pixels ne sont pas copiés, la surface reste valide jusqu'à assetsClose.
+ * 
+ * \param name Chemin d'origine de l'image
+ * \return La surface RGBA, NULL si l'image n'est pas dans le paquet
+ */
+static SDL_Surface* assetSurface(const char *name)
+{
+	const assetEntry *entry = assetsFind(name);
+	
+	if (entry == NULL || entry->type != ASSET_RGBA)
+		return NULL;
+	
+	/* Les octets sont dans l'ordre R, V, B, A */
+	#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+		return SDL_CreateRGBSurfaceFrom((void*) assetsData(entry),
+			entry->width, entry->height, 32, 4 * entry->width,
+			0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff);
+	#else
+		return SDL_CreateRGBSurfaceFrom((void*) assetsData(entry),
+			entry->width, entry->height, 32, 4 * entry->width,
+			0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+	#endif
+}
+
+/**
+ * \fn static bool pngSize(const char *filename, int *w, int *h);
+ * \brief Lit la taille d'une image PNG sans la décoder (en-tête IHDR)
+ * 
+ * \param filename Chemin vers le fichier image
+ * \param w Largeur lue
+ * \param h Hauteur lue
+ * \return Vrai si le fichier est un PNG valide, Faux sinon
+ */
+static bool pngSize(const char *filename, int *w, int *h)
+{
+	static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+	unsigned char header[24];
+	FILE *file = fopen(filename, "rb");
+	
+	if (file == NULL)
+		return false;
+	
+	if (fread(header, 1, 24, file) != 24
+		|| memcmp(header, signature, 8) != 0
+		|| memcmp(header + 12, "IHDR", 4) != 0)
+	{
+		fclose(file);
+		return false;
+	}
+	
+	fclose(file);
+	
+	/* Entiers gros-boutistes */
+	*w = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+	*h = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+	
+	return *w > 0 && *h > 0;
+}
+
 
 /**
- * \fn window createWindow(int width, int height, const char* title);
+ * \fn window createWindow(int width, int height, const char* title, bool software);
  * \brief Permet de créer une fenêtre
  * 
  * \param width Largeur de la fenêtre
  * \param height Hauteur de la fenêtre
  * \param title Titre de la fenêtre
+ * \param software Vrai pour dessiner sans OpenGL, dans la surface SDL
  * \return window
  */
-void createWindow(int width, int height, const char* title)
+void createWindow(int width, int height, const char* title, bool software)
 {
 	SDL_Surface *w = NULL;
 	SDL_Surface *icon = NULL;
 	
 	
-	/* Initialisation de la SDL ou FSAA est une constante */
-	SDL_Init(SDL_INIT_VIDEO);
+	/* Initialisation de la SDL ou FSAA est une constante
+	 * (le minuteur réveille la boucle d'affichage) */
+	SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER);
 	
 	/* Anti-aliasing activé */
-	SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS,  1);
-	SDL_GL_SetAttribute(SDL_GL_MULTISAMPLESAMPLES,  FSAA);
+	if (!software)
+	{
+		SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS,  1);
+		SDL_GL_SetAttribute(SDL_GL_MULTISAMPLESAMPLES,  FSAA);
+	}
 	
-	/* On charge l'icone et on vérifie quelle est bien chargé */
-	icon = SDL_LoadBMP("img/icon.bmp");
+	/* On charge l'icone (depuis le paquet de ressources si possible)
+	 * et on vérifie quelle est bien chargé */
+	icon = assetSurface("img/icon.bmp");
+	if (icon == NULL)
+		icon = SDL_LoadBMP("img/icon.bmp");
 	if (icon == NULL)
 	{
 		fprintf(stderr, "Erreur lors du chargement de l'icone du programme : %s\n", SDL_GetError());
@@ -48,8 +141,11 @@ void createWindow(int width, int height, const char* title)
 	/* On applique l'icone */
 	SDL_WM_SetIcon(icon, NULL);
 	
-	/* On affecte le mode vidéo souhaité (OPENGL) */
-	w = SDL_SetVideoMode(width, height, 32, SDL_OPENGL | SDL_GL_DOUBLEBUFFER);
+	/* On affecte le mode vidéo souhaité (OPENGL ou surface logicielle 32 bits) */
+	if (software)
+		w = SDL_SetVideoMode(width, height, 32, SDL_SWSURFACE);
+	else
+		w = SDL_SetVideoMode(width, height, 32, SDL_OPENGL | SDL_GL_DOUBLEBUFFER);
 	
 	
 	/* On vérifie les erreurs possibles */
@@ -70,6 +166,14 @@ void createWindow(int width, int height, const char* title)
 		exit(EXIT_FAILURE);  
 	} 
 	
+	/* En mode logiciel, on dessine directement dans la surface de la fenêtre */
+	if (software)
+	{
+		framebuffer = w;
+		target = w;
+		return;
+	}
+	
 	/* On charge la matrice identité de OpenGL */
 	glLoadIdentity();
         glMatrixMode(GL_PROJECTION);
@@ -120,6 +224,8 @@ void startLoop()
 
 	/* On démarre le moteur */
 	engine->running = true;
+	engine->startupTime = 0;
+	engine->renderScale = 1;
 	
 	/* On appelle la fonction de la boucle
 	 * principale
@@ -221,7 +327,8 @@ void showEngineInfos(engineSettings* engine)
 	TTF_Font* font	= engine->font1;
 	
 	/* Affiché en 10x et -20y */
-	sprintf(infosString, "LiFE v%s - %s OpenGL", VERSION, driverName);
+	sprintf(infosString, "LiFE v%s - %s %s", VERSION, driverName,
+			engineSoftwareMode() ? "logiciel" : "OpenGL");
 	fontPrint(font, infosString, 10, sHeight - 20, white);
 	
 	sprintf(infosString,
@@ -229,26 +336,630 @@ void showEngineInfos(engineSettings* engine)
 		sWidth,
 		sHeight,
 		sBpp,
-		FSAA);
+		engineSoftwareMode() ? 1 : FSAA);
 	fontPrint(font, infosString, 10, sHeight - 38, white);
 	
-	sprintf(infosString, "FPS: %d", getFrameRate());
-	fontPrint(font, infosString, 10, sHeight - 56, white);
+	sprintf(infosString, "FPS: %d", getFrameRate());
+	fontPrint(font, infosString, 10, sHeight - 56, white);
+	
+	sprintf(infosString, "Démarrage: %u ms", engine->startupTime);
+	fontPrint(font, infosString, 10, sHeight - 74, white);
+	
+	/* Résolution réduite pendant les interactions */
+	sprintf(infosString, "Calcul: 1/%d (%dx%d)", engine->renderScale,
+		(sWidth + engine->renderScale - 1) / engine->renderScale,
+		(sHeight + engine->renderScale - 1) / engine->renderScale);
+	fontPrint(font, infosString, 10, sHeight - 92, white);
+}
+
+/**
+ * \fn void engineWakeUp(int code);
+ * \brief Réveille la boucle d'affichage en attente d'un événement
+ * \remark Peut être appelée depuis un autre thread.
+ * 
+ * \param code Code de l'événement SDL_USEREVENT envoyé
+ * \return Rien
+ */
+void engineWakeUp(int code)
+{
+	SDL_Event event;
+	
+	event.type = SDL_USEREVENT;
+	event.user.code = code;
+	event.user.data1 = NULL;
+	event.user.data2 = NULL;
+	
+	SDL_PushEvent(&event);
+}
+
+/**
+ * \fn static Uint32 overlayTick(Uint32 interval, void *param);
+ * \brief Minuteur des informations, appelé dans le thread du minuteur SDL
+ * 
+ * \param interval Période actuelle (ms)
+ * \param param Inutilisé
+ * \return La période suivante (ms)
+ */
+static Uint32 overlayTick(Uint32 interval, void *param)
+{
+	(void) param;
+	
+	engineWakeUp(EVENT_OVERLAY_TIMER);
+	
+	return interval;
+}
+
+/**
+ * \fn void engineOverlayTimer(bool enable);
+ * \brief Démarre ou arrête le minuteur des informations (OVERLAY_REFRESH)
+ * 
+ * \param enable Vrai pour démarrer le minuteur, Faux pour l'arrêter
+ * \return Rien
+ */
+void engineOverlayTimer(bool enable)
+{
+	if (enable && overlayTimer == NULL)
+		overlayTimer = SDL_AddTimer(OVERLAY_REFRESH, overlayTick, NULL);
+	
+	if (!enable && overlayTimer != NULL)
+	{
+		SDL_RemoveTimer(overlayTimer);
+		overlayTimer = NULL;
+	}
+}
+
+/**
+ * \fn void destroyWindow();
+ * \brief Permet de détruire la fenêtre et décharger la SDL/OpenGL
+ * 
+ * \return Rien
+ */
+void destroyWindow()
+{
+	/* On arrête le minuteur des informations */
+	engineOverlayTimer(false);
+	
+	/* On libère le calque de la fractale */
+	fractalLayerFree();
+	
+	/* On libère le système de police */
+	TTF_Quit();
+	
+	/* On libère le contexte OpenGL et SDL */
+	SDL_Quit();
+}
+
+/**
+ * \fn bool engineSoftwareMode(void);
+ * \brief Indique si le moteur dessine sans OpenGL
+ * 
+ * \return Vrai en mode logiciel, Faux en mode OpenGL
+ */
+bool engineSoftwareMode(void)
+{
+	return framebuffer != NULL;
+}
+
+/**
+ * \fn SDL_Surface* engineTarget(void);
+ * \brief Renvoie la surface dans laquelle dessinent les primitives
+ * 
+ * \return La surface cible en mode logiciel, NULL en mode OpenGL
+ */
+SDL_Surface* engineTarget(void)
+{
+	return target;
+}
+
+/**
+ * \fn void clearWindow(void);
+ * \brief Efface le contenu de la fenêtre
+ * 
+ * \return Rien
+ */
+void clearWindow(void)
+{
+	if (framebuffer != NULL)
+		SDL_FillRect(framebuffer, NULL, 0);
+	else
+		glClear(GL_COLOR_BUFFER_BIT);
+}
+
+/**
+ * \fn void refreshWindow(void);
+ * \brief Affiche à l'écran l'image dessinée
+ * 
+ * \return Rien
+ */
+void refreshWindow(void)
+{
+	if (framebuffer != NULL)
+		SDL_Flip(framebuffer);
+	else
+	{
+		/* On envoie tout au GPU */
+		glFlush();
+		SDL_GL_SwapBuffers();
+	}
+}
+
+/**
+ * \fn void softwarePixel(int x, int y, Uint32 color);
+ * \brief Colorie un pixel de la surface cible (mode logiciel)
+ * \remark La surface doit être verrouillée. y est compté depuis le bas.
+ * 
+ * \param x Position horizontale du pixel
+ * \param y Position verticale du pixel
+ * \param color Couleur au format de la surface
+ * \return Rien
+ */
+static void softwarePixel(int x, int y, Uint32 color)
+{
+	Uint8 *row;
+	
+	if (x < 0 || y < 0 || x >= target->w || y >= target->h)
+		return;
+	
+	/* Les lignes SDL sont comptées depuis le haut */
+	row = (Uint8*) target->pixels + (target->h - 1 - y) * target->pitch;
+	((Uint32*) row)[x] = color;
+}
+
+/**
+ * \fn void softwareShade(int x, int y, int w, int h, double opacity);
+ * \brief Assombrit un rectangle de la surface cible (mode logiciel)
+ * 
+ * \param x Bord gauche du rectangle
+ * \param y Bord bas du rectangle
+ * \param w Largeur du rectangle
+ * \param h Hauteur du rectangle
+ * \param opacity Opacité du noir appliqué [0 à 1]
+ * \return Rien
+ */
+static void softwareShade(int x, int y, int w, int h, double opacity)
+{
+	int i, j;
+	Uint8 r, g, b;
+	Uint32 *pixel;
+	SDL_PixelFormat *fmt = target->format;
+	int keep = (int)(256 * (1.0 - opacity));
+	
+	SDL_LockSurface(target);
+	
+	for (j = y; j < y + h; j++)
+	{
+		if (j < 0 || j >= target->h)
+			continue;
+		
+		pixel = (Uint32*)((Uint8*) target->pixels + (target->h - 1 - j) * target->pitch);
+		
+		for (i = x; i < x + w; i++)
+		{
+			if (i < 0 || i >= target->w)
+				continue;
+			
+			r = ((((pixel[i] & fmt->Rmask) >> fmt->Rshift) * keep) >> 8);
+			g = ((((pixel[i] & fmt->Gmask) >> fmt->Gshift) * keep) >> 8);
+			b = ((((pixel[i] & fmt->Bmask) >> fmt->Bshift) * keep) >> 8);
+			pixel[i] = SDL_MapRGB(fmt, r, g, b);
+		}
+	}
+	
+	SDL_UnlockSurface(target);
+}
+
+/**
+ * \fn void softwareGlyph(glyphAtlas *atlas, glyphInfo *glyph, int x, int y, colorRGB c);
+ * \brief Dessine un caractère de la texture d'une police (mode logiciel)
+ * 
+ * \param atlas Texture des caractères
+ * \param glyph Caractère à dessiner
+ * \param x Position horizontale du caractère
+ * \param y Position verticale du bas du caractère
+ * \param c Couleur du texte
+ * \return Rien
+ */
+static void softwareGlyph(glyphAtlas *atlas, glyphInfo *glyph, int x, int y, colorRGB c)
+{
+	int i, j, row, alpha;
+	Uint8 r, g, b;
+	Uint8 *source;
+	Uint32 *pixel;
+	SDL_PixelFormat *fmt = target->format;
+	
+	SDL_LockSurface(target);
+	
+	for (j = 0; j < atlas->height; j++)
+	{
+		/* La ligne j du caractère est comptée depuis le haut */
+		row = target->h - (y + atlas->height) + j;
+		if (row < 0 || row >= target->h)
+			continue;
+		
+		source = (Uint8*) atlas->surface->pixels + (glyph->y + j) * atlas->surface->pitch + 4 * glyph->x;
+		pixel = (Uint32*)((Uint8*) target->pixels + row * target->pitch);
+		
+		for (i = 0; i < glyph->w; i++)
+		{
+			/* Octets R, V, B, A : seule la transparence nous intéresse */
+			alpha = source[4 * i + 3];
+			if (alpha == 0 || x + i < 0 || x + i >= target->w)
+				continue;
+			
+			r = (((pixel[x + i] & fmt->Rmask) >> fmt->Rshift) * (255 - alpha) + c.red * alpha) / 255;
+			g = (((pixel[x + i] & fmt->Gmask) >> fmt->Gshift) * (255 - alpha) + c.green * alpha) / 255;
+			b = (((pixel[x + i] & fmt->Bmask) >> fmt->Bshift) * (255 - alpha) + c.blue * alpha) / 255;
+			pixel[x + i] = SDL_MapRGB(fmt, r, g, b);
+		}
+	}
+	
+	SDL_UnlockSurface(target);
+}
+
+/**
+ * \fn void drawLine(float x1, float y1, float x2, float y2, colorRGB c);
+ * \brief Dessine un segment
+ * 
+ * \param x1 Abscisse du premier point
+ * \param y1 Ordonnée du premier point
+ * \param x2 Abscisse du second point
+ * \param y2 Ordonnée du second point
+ * \param c Couleur du segment
+ * \return Rien
+ */
+void drawLine(float x1, float y1, float x2, float y2, colorRGB c)
+{
+	int x, y, xEnd, yEnd, dx, dy, sx, sy, err, e2;
+	Uint32 color;
+	
+	if (target == NULL)
+	{
+		glColor3ub(c.red, c.green, c.blue);
+		glBegin(GL_LINES);
+			glVertex2f(x1, y1);
+			glVertex2f(x2, y2);
+		glEnd();
+		return;
+	}
+	
+	/* Algorithme de Bresenham */
+	x = (int) floor(x1);
+	y = (int) floor(y1);
+	xEnd = (int) floor(x2);
+	yEnd = (int) floor(y2);
+	dx = abs(xEnd - x);
+	dy = -abs(yEnd - y);
+	sx = x < xEnd ? 1 : -1;
+	sy = y < yEnd ? 1 : -1;
+	err = dx + dy;
+	color = SDL_MapRGB(target->format, c.red, c.green, c.blue);
+	
+	SDL_LockSurface(target);
+	
+	while (true)
+	{
+		softwarePixel(x, y, color);
+		
+		if (x == xEnd && y == yEnd)
+			break;
+		
+		e2 = 2 * err;
+		if (e2 >= dy)
+		{
+			err += dy;
+			x += sx;
+		}
+		if (e2 <= dx)
+		{
+			err += dx;
+			y += sy;
+		}
+	}
+	
+	SDL_UnlockSurface(target);
+}
+
+/**
+ * \fn void drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3, colorRGB c);
+ * \brief Dessine un triangle plein
+ * 
+ * \param x1 Abscisse du premier sommet
+ * \param y1 Ordonnée du premier sommet
+ * \param x2 Abscisse du deuxième sommet
+ * \param y2 Ordonnée du deuxième sommet
+ * \param x3 Abscisse du troisième sommet
+ * \param y3 Ordonnée du troisième sommet
+ * \param c Couleur du triangle
+ * \return Rien
+ */
+void drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3, colorRGB c)
+{
+	int x, y, xMin, xMax, yMin, yMax;
+	float px, py, e1, e2, e3;
+	Uint32 color;
+	
+	if (target == NULL)
+	{
+		glColor3ub(c.red, c.green, c.blue);
+		glBegin(GL_TRIANGLES);
+			glVertex2f(x1, y1);
+			glVertex2f(x2, y2);
+			glVertex2f(x3, y3);
+		glEnd();
+		return;
+	}
+	
+	/* Rectangle englobant le triangle */
+	xMin = (int) floor(fmin(x1, fmin(x2, x3)));
+	xMax = (int) ceil(fmax(x1, fmax(x2, x3)));
+	yMin = (int) floor(fmin(y1, fmin(y2, y3)));
+	yMax = (int) ceil(fmax(y1, fmax(y2, y3)));
+	color = SDL_MapRGB(target->format, c.red, c.green, c.blue);
+	
+	SDL_LockSurface(target);
+	
+	/* Un pixel est dessiné si son centre est du même côté des trois arêtes */
+	for (y = yMin; y < yMax; y++)
+	{
+		for (x = xMin; x < xMax; x++)
+		{
+			px = x + 0.5;
+			py = y + 0.5;
+			e1 = (x2 - x1) * (py - y1) - (y2 - y1) * (px - x1);
+			e2 = (x3 - x2) * (py - y2) - (y3 - y2) * (px - x2);
+			e3 = (x1 - x3) * (py - y3) - (y1 - y3) * (px - x3);
+			
+			if ((e1 >= 0 && e2 >= 0 && e3 >= 0) || (e1 <= 0 && e2 <= 0 && e3 <= 0))
+				softwarePixel(x, y, color);
+		}
+	}
+	
+	SDL_UnlockSurface(target);
+}
+
+/**
+ * \fn void drawRect(float x1, float y1, float x2, float y2, colorRGB c);
+ * \brief Dessine un rectangle plein
+ * 
+ * \param x1 Abscisse du coin inférieur gauche
+ * \param y1 Ordonnée du coin inférieur gauche
+ * \param x2 Abscisse du coin supérieur droit
+ * \param y2 Ordonnée du coin supérieur droit
+ * \param c Couleur du rectangle
+ * \return Rien
+ */
+void drawRect(float x1, float y1, float x2, float y2, colorRGB c)
+{
+	SDL_Rect rect;
+	int left, right, bottom, top;
+	
+	if (target == NULL)
+	{
+		glColor3ub(c.red, c.green, c.blue);
+		glBegin(GL_QUADS);
+			glVertex2f(x1, y1);
+			glVertex2f(x2, y1);
+			glVertex2f(x2, y2);
+			glVertex2f(x1, y2);
+		glEnd();
+		return;
+	}
+	
+	left = (int) floor(x1 + 0.5);
+	right = (int) floor(x2 + 0.5);
+	bottom = (int) floor(y1 + 0.5);
+	top = (int) floor(y2 + 0.5);
+	
+	if (right <= left || top <= bottom)
+		return;
+	
+	/* Conversion vers le repère SDL (origine en haut à gauche) */
+	rect.x = left;
+	rect.y = target->h - top;
+	rect.w = right - left;
+	rect.h = top - bottom;
+	
+	SDL_FillRect(target, &rect, SDL_MapRGB(target->format, c.red, c.green, c.blue));
+}
+
+/**
+ * \fn void fractalLayerBegin(void);
+ * \brief Commence l'enregistrement du calque de la fractale
+ * 
+ * En mode OpenGL les primitives sont compilées dans une liste de vertex,
+ * dessinée une fois puis copiée dans une texture. En mode logiciel elles
+ * sont dessinées dans une surface conservée.
+ * 
+ * \return Rien
+ */
+void fractalLayerBegin(void)
+{
+	SDL_PixelFormat *fmt;
+	
+	if (framebuffer == NULL)
+	{
+		/* Si la liste de vertex existe déjà on la supprime */
+		if (layerList != 0)
+			glDeleteLists(layerList, 1);
+		
+		/* Commence la liste, en spécifiant quelle sera compilée,
+		 * et non directement affiché à l'écran */
+		layerList = glGenLists(1);
+		glNewList(layerList, GL_COMPILE);
+		return;
+	}
+	
+	/* On alloue la surface du calque, au format de la fenêtre */
+	if (layerSurface == NULL)
+	{
+		fmt = framebuffer->format;
+		layerSurface = SDL_CreateRGBSurface(SDL_SWSURFACE, framebuffer->w,
+				framebuffer->h, 32, fmt->Rmask, fmt->Gmask,
+				fmt->Bmask, 0);
+		
+		if (layerSurface == NULL)
+		{
+			fprintf(stderr, "Erreur lors de la création du calque : %s\n",
+					SDL_GetError());
+			exit(EXIT_FAILURE);
+		}
+	}
+	
+	/* Les primitives dessinent désormais dans le calque */
+	SDL_FillRect(layerSurface, NULL, 0);
+	target = layerSurface;
+}
+
+/**
+ * \fn void fractalLayerEnd(void);
+ * \brief Termine l'enregistrement du calque de la fractale
+ * 
+ * \return Rien
+ */
+void fractalLayerEnd(void)
+{
+	SDL_Surface *screen = NULL;
+	
+	if (framebuffer != NULL)
+	{
+		target = framebuffer;
+		return;
+	}
+	
+	glEndList();
+	
+	/* On dessine la liste une seule fois et on garde l'image dans une
+	 * texture : les images suivantes n'affichent qu'un rectangle */
+	screen = SDL_GetVideoSurface();
+	
+	glClear(GL_COLOR_BUFFER_BIT);
+	glCallList(layerList);
+	
+	if (layerTexture == 0)
+		glGenTextures(1, &layerTexture);
+	
+	glBindTexture(GL_TEXTURE_2D, layerTexture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+	glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, 0, 0, screen->w, screen->h, 0);
+	
+	/* La liste n'est plus utile */
+	glDeleteLists(layerList, 1);
+	layerList = 0;
+}
+
+/**
+ * \fn void fractalLayerDraw(void);
+ * \brief Affiche le calque de la fractale
+ * 
+ * \return Rien
+ */
+void fractalLayerDraw(void)
+{
+	SDL_Surface *screen = SDL_GetVideoSurface();
+	
+	if (framebuffer != NULL && layerSurface != NULL)
+		SDL_BlitSurface(layerSurface, NULL, framebuffer, NULL);
+	else
+		fractalLayerDrawRect(0, 0, screen->w, screen->h);
+}
+
+/**
+ * \fn void fractalLayerDrawRect(float x, float y, float w, float h);
+ * \brief Affiche le calque de la fractale étiré dans un rectangle
+ * 
+ * Le rectangle peut déborder de la fenêtre (zoom continu).
+ * 
+ * \param x Abscisse du coin bas gauche
+ * \param y Ordonnée du coin bas gauche
+ * \param w Largeur du rectangle
+ * \param h Hauteur du rectangle
+ * \return Rien
+ */
+void fractalLayerDrawRect(float x, float y, float w, float h)
+{
+	int left, right, top, bottom, i, j, sx, sy;
+	Uint32 *source, *dest;
+	
+	if (framebuffer == NULL)
+	{
+		if (layerTexture == 0)
+			return;
+		
+		glColor4ub(255, 255, 255, 255);
+		glEnable(GL_TEXTURE_2D);
+		glBindTexture(GL_TEXTURE_2D, layerTexture);
+		
+		/* La texture a la taille de la fenêtre, origine en bas à gauche */
+		glBegin(GL_QUADS);
+			glTexCoord2d(0, 0); glVertex2f(x, y);
+			glTexCoord2d(1, 0); glVertex2f(x + w, y);
+			glTexCoord2d(1, 1); glVertex2f(x + w, y + h);
+			glTexCoord2d(0, 1); glVertex2f(x, y + h);
+		glEnd();
+		
+		glDisable(GL_TEXTURE_2D);
+		return;
+	}
+	
+	if (layerSurface == NULL || w <= 0 || h <= 0)
+		return;
+	
+	/* Rectangle dans le repère SDL, limité à la fenêtre */
+	left = (int) floor(x + 0.5);
+	right = (int) floor(x + w + 0.5);
+	top = (int) floor(framebuffer->h - y - h + 0.5);
+	bottom = (int) floor(framebuffer->h - y + 0.5);
+	
+	left = left > 0 ? left : 0;
+	top = top > 0 ? top : 0;
+	right = right < framebuffer->w ? right : framebuffer->w;
+	bottom = bottom < framebuffer->h ? bottom : framebuffer->h;
+	
+	/* Pixel le plus proche : les deux surfaces sont en 32 bits */
+	SDL_LockSurface(framebuffer);
+	
+	for (j = top; j < bottom; j++)
+	{
+		sy = (int) ((j + 0.5 - (framebuffer->h - y - h)) * layerSurface->h / h);
+		if (sy < 0 || sy >= layerSurface->h)
+			continue;
+		
+		source = (Uint32*)((Uint8*) layerSurface->pixels + sy * layerSurface->pitch);
+		dest = (Uint32*)((Uint8*) framebuffer->pixels + j * framebuffer->pitch);
+		
+		for (i = left; i < right; i++)
+		{
+			sx = (int) ((i + 0.5 - x) * layerSurface->w / w);
+			if (sx >= 0 && sx < layerSurface->w)
+				dest[i] = source[sx];
+		}
+	}
+	
+	SDL_UnlockSurface(framebuffer);
 }
 
 /**
- * \fn void destroyWindow();
- * \brief Permet de détruire la fenêtre et décharger la SDL/OpenGL
+ * \fn void fractalLayerFree(void);
+ * \brief Libère le calque de la fractale
  * 
  * \return Rien
  */
-void destroyWindow()
+void fractalLayerFree(void)
 {
-	/* On libère le système de police */
-	TTF_Quit();
+	if (layerList != 0)
+		glDeleteLists(layerList, 1);
+	layerList = 0;
 	
-	/* On libère le contexte OpenGL et SDL */
-	SDL_Quit();
+	if (layerTexture != 0)
+		glDeleteTextures(1, &layerTexture);
+	layerTexture = 0;
+	
+	if (layerSurface != NULL)
+		SDL_FreeSurface(layerSurface);
+	layerSurface = NULL;
 }
 
 /**
@@ -261,8 +972,14 @@ void destroyWindow()
  */
 TTF_Font* fontOpen(char* name, int size)
 {
-	/* On charge la police */
-	TTF_Font* font = TTF_OpenFont(name, size);
+	TTF_Font* font = NULL;
+	const assetEntry *entry = assetsFind(name);
+	
+	/* On charge la police, depuis le paquet de ressources si possible */
+	if (entry != NULL && entry->type == ASSET_RAW)
+		font = TTF_OpenFontRW(SDL_RWFromConstMem(assetsData(entry), entry->size), 1, size);
+	else
+		font = TTF_OpenFont(name, size);
 	 
 	/* On vérifie le bon chargement */
 	if (font == NULL)
@@ -285,15 +1002,197 @@ TTF_Font* fontOpen(char* name, int size)
  */
 void fontClose(TTF_Font* font)
 {
+	int i;
+	
+	/* On libère la texture des caractères de la police */
+	for (i = 0; i < ATLAS_MAX; i++)
+	{
+		if (atlases[i] != NULL && atlases[i]->font == font)
+		{
+			if (atlases[i]->texture != 0)
+				glDeleteTextures(1, &atlases[i]->texture);
+			SDL_FreeSurface(atlases[i]->surface);
+			free(atlases[i]);
+			atlases[i] = NULL;
+		}
+	}
+	
 	/* On décharge la police */
 	if (font != NULL)
 		TTF_CloseFont(font);
 }
 
+/**
+ * \fn glyphAtlas* fontAtlas(TTF_Font* font);
+ * \brief Renvoie la texture des caractères d'une police, construite au premier appel
+ * 
+ * \param font Pointeur vers la police
+ * \return La texture des caractères, NULL si elle n'a pas pu être construite
+ */
+glyphAtlas* fontAtlas(TTF_Font* font)
+{
+	int i, slot = -1, penX = 0, penY = 0, advance;
+	char string[3];
+	SDL_Color white = {255, 255, 255, 0};
+	SDL_Surface *glyph = NULL;
+	SDL_Rect position;
+	glyphAtlas *atlas = NULL;
+	
+	/* On cherche la police parmi celles déjà en cache */
+	for (i = 0; i < ATLAS_MAX; i++)
+	{
+		if (atlases[i] != NULL && atlases[i]->font == font)
+			return atlases[i];
+		if (atlases[i] == NULL && slot < 0)
+			slot = i;
+	}
+	
+	if (slot < 0)
+		return NULL;
+	
+	atlas = (glyphAtlas*) calloc(1, sizeof(glyphAtlas));
+	if (atlas == NULL)
+		return NULL;
+	
+	atlas->font = font;
+	atlas->height = TTF_FontHeight(font);
+	
+	/* Surface RGBA (octets dans l'ordre R, V, B, A) assez haute pour
+	 * 256 caractères, même très larges */
+	#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+		atlas->surface = SDL_CreateRGBSurface(SDL_SWSURFACE, ATLAS_WIDTH,
+			ATLAS_GLYPHS * (atlas->height + 1) / 8, 32,
+			0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff);
+	#else
+		atlas->surface = SDL_CreateRGBSurface(SDL_SWSURFACE, ATLAS_WIDTH,
+			ATLAS_GLYPHS * (atlas->height + 1) / 8, 32,
+			0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+	#endif
+	
+	if (atlas->surface == NULL)
+	{
+		free(atlas);
+		return NULL;
+	}
+	
+	SDL_FillRect(atlas->surface, NULL, 0);
+	
+	/* On dessine chaque caractère une seule fois, côte à côte */
+	for (i = 1; i < ATLAS_GLYPHS; i++)
+	{
+		/* Les caractères de contrôle ne sont pas dessinables */
+		if (i < 0x20 || (i >= 0x7F && i < 0xA0))
+			continue;
+		
+		if (TTF_GlyphMetrics(font, i, NULL, NULL, NULL, NULL, &advance) < 0)
+			continue;
+		
+		/* Encodage UTF-8 du caractère */
+		if (i < 0x80)
+		{
+			string[0] = i;
+			string[1] = '\0';
+		}
+		else
+		{
+			string[0] = 0xC0 | (i >> 6);
+			string[1] = 0x80 | (i & 0x3F);
+			string[2] = '\0';
+		}
+		
+		glyph = TTF_RenderUTF8_Blended(font, string, white);
+		if (glyph == NULL)
+			continue;
+		
+		/* Ligne suivante si le caractère ne tient pas (1 pixel de marge) */
+		if (penX + glyph->w + 1 > ATLAS_WIDTH)
+		{
+			penX = 0;
+			penY += atlas->height + 1;
+		}
+		
+		if (penY + glyph->h > atlas->surface->h)
+		{
+			SDL_FreeSurface(glyph);
+			break;
+		}
+		
+		/* Copie sans mélange : on conserve la transparence du caractère */
+		SDL_SetAlpha(glyph, 0, 0);
+		position.x = penX;
+		position.y = penY;
+		SDL_BlitSurface(glyph, NULL, atlas->surface, &position);
+		
+		atlas->glyphs[i].x = penX;
+		atlas->glyphs[i].y = penY;
+		atlas->glyphs[i].w = glyph->w;
+		atlas->glyphs[i].advance = advance;
+		atlas->glyphs[i].present = true;
+		
+		penX += glyph->w + 1;
+		SDL_FreeSurface(glyph);
+	}
+	
+	/* En mode OpenGL, la surface est envoyée une fois pour toutes */
+	if (framebuffer == NULL)
+	{
+		glGenTextures(1, &atlas->texture);
+		glBindTexture(GL_TEXTURE_2D, atlas->texture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlas->surface->w,
+				atlas->surface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+				atlas->surface->pixels);
+	}
+	
+	atlases[slot] = atlas;
+	
+	return atlas;
+}
 
 /**
- * \fn void fontPrint(TTF_Font* font, const char* string, int x, int y, colorRGB c);
- * \brief Dessine le texte à l'écran, selon une police choisie.
+ * \fn int fontDecode(const char* string, int* codes, int size);
+ * \brief Décode une chaine UTF-8 en codes de caractères
+ * 
+ * \param string Chaine UTF-8
+ * \param codes Tableau recevant les codes
+ * \param size Taille du tableau
+ * \return Le nombre de caractères, -1 si un caractère est hors de la texture
+ */
+static int fontDecode(const char* string, int* codes, int size)
+{
+	const unsigned char *p = (const unsigned char*) string;
+	int count = 0;
+	
+	while (*p != '\0')
+	{
+		if (count >= size)
+			return -1;
+		
+		/* Caractère ASCII */
+		if (*p < 0x80)
+			codes[count++] = *p++;
+		/* Caractère sur 2 octets */
+		else if ((*p & 0xE0) == 0xC0 && (p[1] & 0xC0) == 0x80)
+		{
+			codes[count++] = ((p[0] & 0x1F) << 6) | (p[1] & 0x3F);
+			p += 2;
+		}
+		else
+			return -1;
+		
+		if (codes[count - 1] >= ATLAS_GLYPHS)
+			return -1;
+	}
+	
+	return count;
+}
+
+
+/**
+ * \fn void fontPrintSurface(TTF_Font* font, const char* string, int x, int y, colorRGB c);
+ * \brief Dessine le texte à l'écran en le rendant entièrement avec SDL_ttf.
+ * \remark Utilisé pour les caractères absents de la texture de la police.
  * 
  * \param font Pointeur vers la police à utiliser.
  * \param string Chaine de caractères représantant le texte à afficher.
@@ -302,11 +1201,11 @@ void fontClose(TTF_Font* font)
  * \param c Couleur du texte à afficher.
  * \return Rien
  */
-void fontPrint(	TTF_Font* font,
-		const char* string,
-		int x,
-		int y,
-		colorRGB c)
+static void fontPrintSurface(	TTF_Font* font,
+				const char* string,
+				int x,
+				int y,
+				colorRGB c)
 {
 	/* On déclare une couleur format SDL */
 	SDL_Color color = {c.red, c.green, c.blue, 0};
@@ -331,6 +1230,17 @@ void fontPrint(	TTF_Font* font,
 		return;
 	}
 	
+	/* En mode logiciel : fond assombri puis copie avec transparence */
+	if (target != NULL)
+	{
+		SDL_Rect position = {x, target->h - y - surface->h, 0, 0};
+		
+		softwareShade(x - 2, y - 1, surface->w + 4, surface->h + 2, 0.6);
+		SDL_BlitSurface(surface, NULL, target, &position);
+		SDL_FreeSurface(surface);
+		return;
+	}
+	
 	/* Couleur noir et opacité alpha 30% */
 	glColor4f(0,0,0, 0.6);
 	
@@ -394,6 +1304,102 @@ void fontPrint(	TTF_Font* font,
 	
 }
 
+/**
+ * \fn void fontPrint(TTF_Font* font, const char* string, int x, int y, colorRGB c);
+ * \brief Dessine le texte à l'écran, selon une police choisie.
+ * 
+ * Les caractères sont lus dans la texture de la police (voir fontAtlas),
+ * la chaine n'est donc pas rendue à nouveau à chaque image.
+ * 
+ * \param font Pointeur vers la police à utiliser.
+ * \param string Chaine de caractères représantant le texte à afficher.
+ * \param x Position horizontale du texte.
+ * \param y Position verticale du texte.
+ * \param c Couleur du texte à afficher.
+ * \return Rien
+ */
+void fontPrint(	TTF_Font* font,
+		const char* string,
+		int x,
+		int y,
+		colorRGB c)
+{
+	int codes[256];
+	int count, i, width = 0, penX;
+	float u1, u2, v1, v2;
+	glyphInfo *g;
+	glyphAtlas *atlas = fontAtlas(font);
+	
+	/* Sans texture, ou avec des caractères absents, on rend toute la chaine */
+	count = fontDecode(string, codes, 256);
+	if (atlas == NULL || count < 0)
+	{
+		fontPrintSurface(font, string, x, y, c);
+		return;
+	}
+	
+	/* Largeur totale de la chaine */
+	for (i = 0; i < count; i++)
+		width += atlas->glyphs[codes[i]].advance;
+	
+	/* En mode logiciel, on mélange chaque caractère avec le fond */
+	if (target != NULL)
+	{
+		softwareShade(x - 2, y - 1, width + 4, atlas->height + 2, 0.6);
+		
+		for (i = 0, penX = x; i < count; i++)
+		{
+			g = &atlas->glyphs[codes[i]];
+			if (g->present)
+				softwareGlyph(atlas, g, penX, y, c);
+			penX += g->advance;
+		}
+		return;
+	}
+	
+	/* Couleur noir et opacité alpha 30% */
+	glColor4f(0,0,0, 0.6);
+	
+	/* On crée un vertex OpenGl pour asombrir le fond de la police
+	 * Plus large de 2 px et haut de 1 px */
+	glBegin(GL_QUADS);
+		glVertex2f(x - 2, y + atlas->height + 1);
+		glVertex2f(x - 2, y - 1 );
+		glVertex2f(x + width + 2, y - 1);
+		glVertex2f(x + width + 2, y + atlas->height + 1);
+	glEnd();
+	
+	/* La couleur du texte module les caractères blancs de la texture */
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, atlas->texture);
+	glColor4ub(c.red, c.green, c.blue, 255);
+	
+	/* Tous les caractères en un seul lot de quads */
+	glBegin(GL_QUADS);
+	for (i = 0, penX = x; i < count; i++)
+	{
+		g = &atlas->glyphs[codes[i]];
+		
+		if (g->present)
+		{
+			u1 = (float) g->x / atlas->surface->w;
+			u2 = (float) (g->x + g->w) / atlas->surface->w;
+			v1 = (float) g->y / atlas->surface->h;
+			v2 = (float) (g->y + atlas->height) / atlas->surface->h;
+			
+			glTexCoord2f(u1, v1); glVertex2f(penX, y + atlas->height);
+			glTexCoord2f(u1, v2); glVertex2f(penX, y);
+			glTexCoord2f(u2, v2); glVertex2f(penX + g->w, y);
+			glTexCoord2f(u2, v1); glVertex2f(penX + g->w, y + atlas->height);
+		}
+		
+		penX += g->advance;
+	}
+	glEnd();
+	
+	glDisable(GL_TEXTURE_2D);
+}
+
 /**
  * \fn image* imageLoad(char* filename);
  * \brief Charge en mémoire une image.
@@ -404,37 +1410,92 @@ void fontPrint(	TTF_Font* font,
 image* imageLoad(char* filename)
 {
 	image *img = NULL;
-	SDL_Surface *surface = NULL;
+	const assetEntry *entry = NULL;
 	
 	/* On alloue la structure image */
 	img = (image*) malloc (sizeof(image));
 	
-	if (img == NULL)
+	if (img != NULL)
+		img->filename = strdup(filename);
+	
+	if (img == NULL || img->filename == NULL)
 	{
 		fprintf(stderr, "Erreur lors de l'allocation de l'image"
 				": \"%s\"\n", filename);
 		exit(EXIT_FAILURE);
 	}
 	
-	/* On charge l'image dans la surface SDL */
-	surface = IMG_Load(filename);
+	img->surface = NULL;
+	img->x = 0;
+	img->y = 0;
+	
+	/* La texture sera envoyée au premier affichage */
+	img->texture = 0;
+	img->lastUse = 0;
+	
+	/* Seule la taille est lue maintenant : dans le paquet de ressources,
+	 * ou dans l'en-tête du PNG. Sinon on décode l'image tout de suite. */
+	entry = assetsFind(filename);
+	if (entry != NULL && entry->type == ASSET_RGBA)
+	{
+		img->w = entry->width;
+		img->h = entry->height;
+	}
+	else if (!pngSize(filename, &img->w, &img->h))
+	{
+		imageSurface(img);
+		img->w = img->surface->w;
+		img->h = img->surface->h;
+	}
+	
+	/* On renvoit le pointeur */
+	return img;	
+}
+
+/**
+ * \fn SDL_Surface* imageSurface(image *img);
+ * \brief Renvoie la surface de l'image, décodée au premier appel
+ * 
+ * \param img Pointeur vers l'image en mémoire
+ * \return La surface SDL de l'image
+ */
+SDL_Surface* imageSurface(image *img)
+{
+	SDL_Surface *surface = NULL;
+	
+	if (img->surface != NULL)
+		return img->surface;
+	
+	/* Pixels déjà décodés dans le paquet, sinon on charge le fichier */
+	surface = assetSurface(img->filename);
+	if (surface == NULL)
+		surface = IMG_Load(img->filename);
 	
 	/* On vérifie les erreurs possibles */
 	if (surface == NULL)
 	{
 		fprintf(stderr, "Erreur lors du chargement de l'image"
 				" \"%s\" : "
-				"%s\n", filename , IMG_GetError());
+				"%s\n", img->filename , IMG_GetError());
 		exit(EXIT_FAILURE);
 	}
 	
-	/* On remplit la structure image */
+	/* En mode logiciel, on convertit l'image au format de la fenêtre
+	 * une fois pour toutes, la copie à l'écran est alors directe */
+	if (framebuffer != NULL)
+	{
+		SDL_Surface *converted = SDL_DisplayFormatAlpha(surface);
+		
+		if (converted != NULL)
+		{
+			SDL_FreeSurface(surface);
+			surface = converted;
+		}
+	}
+	
 	img->surface = surface;
-	img->w = surface->w;
-	img->h = surface->h;
 	
-	/* On renvoit le pointeur */
-	return img;	
+	return surface;
 }
 
 /**
@@ -451,28 +1512,83 @@ void imageFree(image *img)
 	 */
 	if (img != NULL)
 	{
+		/* On libère la texture en mémoire vidéo */
+		imageRelease(img);
+		
 		if (img->surface != NULL)
 			SDL_FreeSurface(img->surface);
 		
+		free(img->filename);
 		free(img);
 	}
 }
 
 /**
- * \fn void imageDraw(image *img);
- * \brief Affiche l'image à l'écran.
+ * \fn void imageRelease(image *img);
+ * \brief Libère la texture d'une image (l'image reste chargée)
  * 
  * \param img Pointeur vers l'image en mémoire
  * \return Rien
  */
-void imageDraw(image *img)
+void imageRelease(image *img)
 {
-	/* Déclaration de la texture */
-	GLuint texture;
+	int i;
+	
+	if (img->texture == 0)
+		return;
+	
+	glDeleteTextures(1, &img->texture);
+	img->texture = 0;
+	residentBytes -= 4L * img->w * img->h;
+	
+	/* On retire l'image de la liste des textures en mémoire vidéo */
+	for (i = 0; i < TEXTURE_MAX; i++)
+		if (residentImages[i] == img)
+			residentImages[i] = NULL;
+}
+
+/**
+ * \fn void imageUpload(image *img);
+ * \brief Envoie l'image en mémoire vidéo, en respectant TEXTURE_BUDGET
+ * 
+ * \param img Pointeur vers l'image en mémoire
+ * \return Rien
+ */
+void imageUpload(image *img)
+{
+	int i, slot, oldest;
+	long bytes = 4L * img->w * img->h;
+	
+	/* On libère les textures les plus anciennes jusqu'à avoir la place */
+	while (true)
+	{
+		slot = -1;
+		oldest = -1;
+		
+		for (i = 0; i < TEXTURE_MAX; i++)
+		{
+			if (residentImages[i] == NULL)
+			{
+				if (slot < 0)
+					slot = i;
+			}
+			else if (oldest < 0 || residentImages[i]->lastUse < residentImages[oldest]->lastUse)
+				oldest = i;
+		}
+		
+		if (slot >= 0 && residentBytes + bytes <= TEXTURE_BUDGET)
+			break;
+		
+		/* Plus rien à libérer : l'image dépasse seule le budget */
+		if (oldest < 0)
+			break;
+		
+		imageRelease(residentImages[oldest]);
+	}
 	
 	/* On génère la texture */
-	glGenTextures(1, &texture);
-	glBindTexture(GL_TEXTURE_2D, texture);
+	glGenTextures(1, &img->texture);
+	glBindTexture(GL_TEXTURE_2D, img->texture);
 	
 	/* On lui applique les paramètres par défaut */
 	glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -480,11 +1596,8 @@ void imageDraw(image *img)
 	glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	
-	/* On reset la couleur par defaut */
-	glColor4ub(255,255,255,255);
-	
-	/* On vérouille la surface */
-	SDL_LockSurface(img->surface);
+	/* On vérouille la surface (décodée si besoin) */
+	SDL_LockSurface(imageSurface(img));
 	
 	/* On stocke la texture en mémoire */	
 	glTexImage2D (GL_TEXTURE_2D, 0, GL_RGBA8, img->w, img->h, 0,
@@ -493,9 +1606,40 @@ void imageDraw(image *img)
 	/* On dévérouille la surface */
 	SDL_UnlockSurface(img->surface);
 	
+	residentBytes += bytes;
+	if (slot >= 0)
+		residentImages[slot] = img;
+}
+
+/**
+ * \fn void imageDraw(image *img);
+ * \brief Affiche l'image à l'écran.
+ * 
+ * \param img Pointeur vers l'image en mémoire
+ * \return Rien
+ */
+void imageDraw(image *img)
+{
+	/* En mode logiciel, on copie l'image dans la surface */
+	if (target != NULL)
+	{
+		SDL_Rect position = {img->x, target->h - img->y - img->h, 0, 0};
+		
+		SDL_BlitSurface(imageSurface(img), NULL, target, &position);
+		return;
+	}
+	
+	/* La texture n'est envoyée qu'au premier affichage */
+	img->lastUse = ++textureClock;
+	if (img->texture == 0)
+		imageUpload(img);
+	
+	/* On reset la couleur par defaut */
+	glColor4ub(255,255,255,255);
+	
 	/* On active le mode texture de OpenGL */
 	glEnable (GL_TEXTURE_2D);
-	glBindTexture(GL_TEXTURE_2D, texture);
+	glBindTexture(GL_TEXTURE_2D, img->texture);
 	
 	/* On spécifie les vertex */
 	glBegin (GL_QUADS);
@@ -505,11 +1649,8 @@ void imageDraw(image *img)
 		glTexCoord2d (1,0); glVertex2f(img->x + img->w, img->y + img->h);
 	glEnd ();
 	
-	/* On désactive le mode texture et
-	 * on libère la texture
-	 */
+	/* On désactive le mode texture */
 	glDisable (GL_TEXTURE_2D);
-	glDeleteTextures(1, &texture);
 }
 
 /**
@@ -525,6 +1666,7 @@ void imageDraw(image *img)
 void drawZoomBox(engineSettings* engine, int x, int y, double sizeBox)
 {
 	int width, height;
+	colorRGB red = {255, 0, 0};
 	
 	/* Evite le facteur de zoom négatif */
 	if (sizeBox > 1.0)
@@ -534,154 +1676,113 @@ void drawZoomBox(engineSettings* engine, int x, int y, double sizeBox)
 	width = engine->screen.width * sizeBox / 2;
 	height = engine->screen.height * sizeBox / 2;
 	
-	/* Couleur rouge */
-	glColor3ub(255,0,0);
+	/* Ligne gauche */
+	drawLine(x - width, y - height, x - width, y + height, red);
 	
+	/* Ligne haut */
+	drawLine(x - width, y + height, x + width, y + height, red);
 	
-	glBegin(GL_LINES);
-		/* Ligne gauche */
-		glVertex2f(x - width, y - height);
-		glVertex2f(x - width, y + height);
-		
-		/* Ligne haut */
-		glVertex2f(x - width, y + height);
-		glVertex2f(x + width, y + height);
-		
-		/* Ligne droite */
-		glVertex2f(x + width, y + height);
-		glVertex2f(x + width, y - height);
-		
-		/* Ligne bas */
-		glVertex2f(x + width, y - height);
-		glVertex2f(x - width, y - height);
-	glEnd();
+	/* Ligne droite */
+	drawLine(x + width, y + height, x + width, y - height, red);
+	
+	/* Ligne bas */
+	drawLine(x + width, y - height, x - width, y - height, red);
 }
 
 
 /**
- * \fn void setNewScale(fractalSettings* zoom, int x, int y, double sizeZoom);
- * \brief Met à jour le repère complexe en fonction des valeurs du zoom
+ * \fn void zoomStackClear(zoomStack* stack);
+ * \brief Retire tous les élements de la pile
  * 
- * \param zoom Pointeur vers les valeurs du repère à modifier
- * \param x Centre horizontal du repère
- * \param y Centre vertical du repère
- * \param size Facteur de zoom [0 à 1]
+ * \param stack Pointeur vers la pile
  * \return Rien
  */
-void setNewScale(fractalSettings *zoom, int x, int y, double sizeZoom)
+void zoomStackClear(zoomStack *stack)
 {
-	/* Récupération de la résolution de la fenêtre */
-	double scrW = zoom->screenWidth;
-	double scrH = zoom->screenHeight;
-	
-	/* Récupération des anciennes valeurs du repère */
-	double lastRealMin = zoom->realMin;
-	double lastRealMax = zoom->realMax;
-	double lastImagMin = zoom->imagMin;
-	double lastImagMax = zoom->imagMax;
-	
-	/* Calcul de la dimension de la boite de zoom en pixel */
-	double offsetHeight = scrH / 2.0 * sizeZoom; 
-	double offsetWidth = scrW / 2.0 * sizeZoom; 
-	
-	/* On inverse l'axe des ordonnées OpenGL */
-	y = scrH - y;
-	
-	/* On met à jour les nouvelle limites du repère */
-	zoom->realMin = ((x - offsetWidth) / scrW) * (lastRealMax - lastRealMin) + lastRealMin;
-	zoom->realMax = ((x + offsetWidth) / scrW) * (lastRealMax - lastRealMin) + lastRealMin;
-	zoom->imagMin = ((y - offsetHeight) / scrH) * (lastImagMax - lastImagMin) + lastImagMin;
-	zoom->imagMax = ((y + offsetHeight) / scrH) * (lastImagMax - lastImagMin) + lastImagMin;
+	stack->first = 0;
+	stack->count = 0;
 }
 
-
 /**
- * \fn void zoomStackClear(zoomStack** stack);
- * \brief Retire tous les élements de la pile
+ * \fn bool zoomStackEmpty(zoomStack* stack);
+ * \brief Indique si la pile est vide
  * 
- * \param stack Adresse du pointeur de la pile
- * \return Rien
+ * \param stack Pointeur vers la pile
+ * \return Vrai si aucun zoom n'est empilé
  */
-void zoomStackClear(zoomStack **stack)
+bool zoomStackEmpty(zoomStack *stack)
 {
-	while (*stack != NULL)
-	{
-		zoomStackPop(stack,NULL,NULL,NULL,NULL);
-	}
+	return stack->count == 0;
 }
 
 /**
- * \fn void zoomStackPush(zoomStack** stack, double xMin, double xMax, double yMin, double yMax);
+ * \fn void zoomStackPush(zoomStack* stack, double xMin, double xMax, double yMin, double yMax);
  * \brief Empile un élement dans la pile
+ * \remark Si la pile est pleine, l'élement le plus ancien est remplacé.
  * 
- * \param stack Adresse du pointeur de la pile
+ * \param stack Pointeur vers la pile
  * \param xMin Valeur minimum  en abscisse du repère à stocker
  * \param xMax Valeur maximum  en abscisse du repère à stocker
  * \param yMin Valeur minimum  en ordonnée du repère à stocker
  * \param yMax Valeur maximum  en ordonnée du repère à stocker
  * \return Rien
  */
-void zoomStackPush(	zoomStack **stack,
+void zoomStackPush(	zoomStack *stack,
 			double xMin,
 			double xMax,
 			double yMin,
 			double yMax)
 {
-	zoomStack* newElement = NULL;
-	
-	newElement = (zoomStack*) malloc( sizeof(zoomStack) );
+	zoomEntry *entry = NULL;
 	
-	if (newElement != NULL)
+	/* Pile pleine : on oublie le zoom le plus ancien */
+	if (stack->count == ZOOM_STACK_SIZE)
 	{
-		newElement->xMin = xMin;
-		newElement->xMax = xMax;
-		newElement->yMin = yMin;
-		newElement->yMax = yMax;
-		
-		newElement->previous = *stack;
-		*stack = newElement;
-	}
-	else
-	{
-		fprintf(stderr, "Erreur d'allocation lors de l'ajout des "
-				"valeurs de zoom dans la pile\n");
-		exit(EXIT_FAILURE);
+		stack->first = (stack->first + 1) % ZOOM_STACK_SIZE;
+		stack->count--;
 	}
+	
+	entry = &stack->entries[(stack->first + stack->count) % ZOOM_STACK_SIZE];
+	entry->xMin = xMin;
+	entry->xMax = xMax;
+	entry->yMin = yMin;
+	entry->yMax = yMax;
+	
+	stack->count++;
 }
 
 /**
- * \fn void zoomStackPop(zoomStack** stack, double* xMin, double* xMax, double* yMin, double* yMax);
+ * \fn void zoomStackPop(zoomStack* stack, double* xMin, double* xMax, double* yMin, double* yMax);
  * \brief Dépile un élement de la pile
  * 
- * \param stack Adresse du pointeur de la pile
+ * \param stack Pointeur vers la pile
  * \param xMin Pointeur vers la valeur minimum  en abscisse du repère à stocker
  * \param xMax Pointeur vers la valeur maximum  en abscisse du repère à stocker
  * \param yMin Pointeur vers la valeur minimum  en ordonnée du repère à stocker
  * \param yMax Pointeur vers la valeur maximum  en ordonnée du repère à stocker
  * \return Rien
  */
-void zoomStackPop(	zoomStack **stack,
+void zoomStackPop(	zoomStack *stack,
 			double *xMin,
 			double *xMax,
 			double *yMin,
 			double *yMax)
 {
-	if (*stack != NULL)
+	zoomEntry *entry = NULL;
+	
+	if (stack->count == 0)
+		return;
+	
+	stack->count--;
+	entry = &stack->entries[(stack->first + stack->count) % ZOOM_STACK_SIZE];
+	
+	if (xMin != NULL && xMax != NULL && yMin != NULL && yMax != NULL)
 	{
-		zoomStack* tmp = (*stack)->previous;
-		if (xMin != NULL && xMax != NULL && yMin != NULL && yMax != NULL)
-		{
-			*xMin = (*stack)->xMin;
-			*xMax = (*stack)->xMax;
-			*yMin = (*stack)->yMin;
-			*yMax = (*stack)->yMax;
-		}
-		free(*stack);
-		*stack = tmp;
-		
-		
+		*xMin = entry->xMin;
+		*xMax = entry->xMax;
+		*yMin = entry->yMin;
+		*yMax = entry->yMax;
 	}
-
 }
 
 
@@ -10,6 +10,9 @@
  * Contient toutes les fonctions permettant de dessiner avec SDL/OpenGL
  * Ainsi que la création de fenêtre et la gestion clavier/souris
  * 
+ * Le dessin peut aussi se faire sans OpenGL, directement dans la surface
+ * SDL de la fenêtre (mode logiciel, choisi au lancement).
+ * 
  */
 
 #ifndef H_ENGINE
@@ -28,6 +31,8 @@
 
 #include "complex.h"
 #include "colors.h"
+#include "viewport.h"
+#include "assets.h"
 
 /* Macros */
 
@@ -46,6 +51,59 @@
  */
 #define VERSION "1.2"
 
+/**
+ * \def TEXTURE_BUDGET
+ * \brief Mémoire vidéo maximum occupée par les textures des images (octets)
+ * 
+ * Au delà, les textures utilisées le moins récemment sont libérées.
+ */
+#define TEXTURE_BUDGET (64 * 1024 * 1024)
+
+/**
+ * \def TEXTURE_MAX
+ * \brief Nombre maximum d'images ayant une texture en mémoire vidéo
+ */
+#define TEXTURE_MAX 64
+
+/**
+ * \def ATLAS_GLYPHS
+ * \brief Nombre de caractères mis en cache par police (Latin-1, 0 à 255)
+ */
+#define ATLAS_GLYPHS 256
+
+/**
+ * \def ATLAS_WIDTH
+ * \brief Largeur en pixels de la texture des caractères d'une police
+ */
+#define ATLAS_WIDTH 512
+
+/**
+ * \def ATLAS_MAX
+ * \brief Nombre maximum de polices ayant leur texture de caractères
+ */
+#define ATLAS_MAX 4
+
+/**
+ * \def OVERLAY_REFRESH
+ * \brief Période de rafraîchissement des informations affichées (ms)
+ * 
+ * La fenêtre n'est redessinée que lorsque quelque chose change, ce minuteur
+ * réveille la boucle pour mettre à jour le compteur d'images.
+ */
+#define OVERLAY_REFRESH 500
+
+/**
+ * \def EVENT_OVERLAY_TIMER
+ * \brief Code de l'événement SDL_USEREVENT envoyé par le minuteur des informations
+ */
+#define EVENT_OVERLAY_TIMER 1
+
+/**
+ * \def ZOOM_STACK_SIZE
+ * \brief Nombre de zooms gardés dans l'historique pour dézoomer
+ */
+#define ZOOM_STACK_SIZE 256
+
 
 /* Typedef */
 typedef colorRGB** screenBuffer;
@@ -82,6 +140,8 @@ typedef struct
 	bool running;		/*!< Etat du moteur graphique */
 	screenInfos screen;	/*!< Informations sur l'écran */
 	TTF_Font* font1;	/*!< Pointeur vers la police à utiliser */
+	unsigned int startupTime;	/*!< Temps écoulé jusqu'à la première image (ms), 0 avant */
+	int renderScale;		/*!< Diviseur de la résolution de calcul de l'image affichée (1 : écran) */
 } engineSettings;
 
 /**
@@ -90,86 +150,133 @@ typedef struct
  * 
  * La structure \e image permet de stocker une image facilement.
  * La taille de l'image et la position de celle-ci peuvent être enregistré.
+ * L'image n'est décodée qu'au premier affichage (seule sa taille est lue
+ * au chargement), la texture OpenGL est alors envoyée puis conservée.
  * 
 */
 typedef struct
 {
-	SDL_Surface *surface;	/*!< Surface SDL */
+	SDL_Surface *surface;	/*!< Surface SDL, NULL tant que l'image n'est pas décodée */
+	char *filename;		/*!< Chemin de l'image, pour le décodage différé */
 	int x;			/*!< Position horizontale de l'image */
 	int y;			/*!< Position verticale de l'image */
 	int w;			/*!< Largeur de l'image */
 	int h;			/*!< Hauteur de l'image */
+	GLuint texture;		/*!< Texture OpenGL, 0 si elle n'est pas en mémoire vidéo */
+	unsigned int lastUse;	/*!< Date du dernier affichage (pour libérer les plus anciennes) */
 } image;
 
 
 /**
- * \struct fractalSettings
- * \brief Stocke les paramètres généraux de la fractale
- * 
- * La structure \e screenInfos permet de stocker les paramètres tel que, les
- * coordonnées de la fractale dans le repère complexe, le nombre d'itérations
- * par pixels ...
+ * \struct glyphInfo
+ * \brief Position et dimensions d'un caractère dans la texture d'une police
  * 
 */
 typedef struct
 {
-	double	realMax;	/*!< Largeur de l'écran */
-	double	realMin;	/*!< Hauteur de l'écran */
-	double	imagMax;	/*!< Nombre de bits par pixels */
-	double	imagMin;	/*!< Nombre de bits par pixels */
-	
-	int	screenWidth;	/*!< Largeur de l'écran */
-	int	screenHeight;	/*!< Hauteur de l'écran */
-	
-	int	iterMax;	/*!< Nombre d'itérations */
-} fractalSettings;
+	int x;		/*!< Position horizontale dans la texture */
+	int y;		/*!< Position verticale dans la texture */
+	int w;		/*!< Largeur du caractère */
+	int advance;	/*!< Avancée du curseur après le caractère */
+	bool present;	/*!< Faux si la police ne contient pas ce caractère */
+} glyphInfo;
 
 /**
- * \struct zoomStack
- * \brief Stocke les valeur de zoom, pour permettre de dézoomer
- * \remark *previous est NULL si c'est l'élement en tête de liste.
+ * \struct glyphAtlas
+ * \brief Stocke tous les caractères d'une police dans une seule texture
  * 
- * La structure \e zoomStack est utilisé conjointement avec une liste chainée. (pile)
- * Cela pour pouvoir faire des zoom arrières
+ * La structure \e glyphAtlas est construite une seule fois par police.
+ * Les caractères y sont dessinés en blanc, la couleur du texte est appliquée
+ * à l'affichage. Une chaine est alors dessinée en un seul lot de quads.
  * 
 */
-typedef struct zoomStack
+typedef struct
+{
+	TTF_Font	*font;			/*!< Police d'origine */
+	SDL_Surface	*surface;		/*!< Caractères en RGBA */
+	GLuint		texture;		/*!< Texture OpenGL (0 en mode logiciel) */
+	int		height;			/*!< Hauteur d'une ligne de texte */
+	glyphInfo	glyphs[ATLAS_GLYPHS];	/*!< Caractères indexés par leur code */
+} glyphAtlas;
+
+/**
+ * \struct zoomEntry
+ * \brief Stocke les valeur d'un zoom, pour permettre de dézoomer
+ * 
+*/
+typedef struct
 {
 	double xMin;			/*!< Valeur du zoom minimum en abscisse */
 	double xMax;			/*!< Valeur du zoom maximum en abscisse */
 	double yMin;			/*!< Valeur du zoom minimum en ordonnée */
 	double yMax;			/*!< Valeur du zoom maximum en ordonnée */
-	struct zoomStack *previous;	/*!< Pointeur vers le zoomStack précedent */
+} zoomEntry;
+
+/**
+ * \struct zoomStack
+ * \brief Historique des zooms (pile), pour pouvoir faire des zoom arrières
+ * 
+ * La pile est un tableau circulaire de ZOOM_STACK_SIZE éléments, sans
+ * allocation. Quand elle est pleine, le zoom le plus ancien est oublié.
+ * 
+*/
+typedef struct
+{
+	zoomEntry entries[ZOOM_STACK_SIZE];	/*!< Zooms empilés */
+	int first;				/*!< Indice du zoom le plus ancien */
+	int count;				/*!< Nombre de zooms empilés */
 } zoomStack;
 
 /* Prototypes */
 
 /* Fonctions internes au moteur */
-void createWindow(int width, int height, const char* title);
+void createWindow(int width, int height, const char* title, bool software);
 void startLoop();
 extern void mainLoop(engineSettings* engine);
 void destroyWindow();
+bool engineSoftwareMode(void);
+SDL_Surface* engineTarget(void);
+void clearWindow(void);
+void refreshWindow(void);
 int getFrameRate();
 void limitFrameRate(int framesPerSecond);
 void showEngineInfos(engineSettings* engine);
+void engineWakeUp(int code);
+void engineOverlayTimer(bool enable);
 
 /* Affichage de texte */
 TTF_Font* fontOpen(char* name, int size);
 void fontClose(TTF_Font* font);
 void fontPrint(TTF_Font* font, const char* string, int x, int y, colorRGB c);
+glyphAtlas* fontAtlas(TTF_Font* font);
 
 /* Affichage d'images */
 image* imageLoad(char* filename);
 void imageFree(image *img);
 void imageDraw(image *img);
+SDL_Surface* imageSurface(image *img);
+void imageUpload(image *img);
+void imageRelease(image *img);
+
+/* Primitives de dessin (repère OpenGL, origine en bas à gauche) */
+void drawLine(float x1, float y1, float x2, float y2, colorRGB c);
+void drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3, colorRGB c);
+void drawRect(float x1, float y1, float x2, float y2, colorRGB c);
+
+/* Calque de la fractale, calculé une fois et réaffiché sous les informations */
+void fractalLayerBegin(void);
+void fractalLayerEnd(void);
+void fractalLayerDraw(void);
+void fractalLayerDrawRect(float x, float y, float w, float h);
+void fractalLayerFree(void);
 
 /* Gestion des fractales */
 void drawZoomBox(engineSettings* engine, int x, int y, double size);
-void setNewScale(fractalSettings *zoom, int x, int y, double sizeZoom);
 
 /* Pile pour le dézoom */
-void zoomStackClear(zoomStack **stack);
-void zoomStackPush(zoomStack **stack, double xMin, double xMax, double yMin, double yMax);
-void zoomStackPop(zoomStack **stack, double *xMin, double *xMax, double *yMin, double *yMax);
+void zoomStackClear(zoomStack *stack);
+bool zoomStackEmpty(zoomStack *stack);
+void zoomStackPush(zoomStack *stack, double xMin, double xMax, double yMin, double yMax);
+void zoomStackPop(zoomStack *stack, double *xMin, double *xMax, double *yMin, double *yMax);
 
 #endif /* H_ENGINE */
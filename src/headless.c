@@ -0,0 +1,393 @@
+/**
+ * \file headless.c
+ * \brief Fichier source, calcul d'une image sans fenêtre (LiFE --render)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Calcule une fractale complexe par le processeur et l'écrit dans un
+ * fichier image, sans initialiser la SDL ni OpenGL : le programme peut
+ * tourner sur un serveur sans écran.
+ * 
+ */
+
+#include "headless.h"
+#include "poster.h"
+#include "pyramid.h"
+#include "cluster.h"
+#include "iterationField.h"
+#include "life.h"
+
+#include <time.h>
+
+/**
+ * \fn double headlessNowMs(void);
+ * \brief Horloge monotone en millisecondes
+ * 
+ * \return Le temps écoulé depuis une origine fixe
+ */
+double headlessNowMs(void)
+{
+	struct timespec now;
+	
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000.0 + now.tv_nsec / 1e6;
+}
+
+/**
+ * \fn static void headlessUsage(void);
+ * \brief Affiche les options du mode sans fenêtre
+ * 
+ * \return Rien
+ */
+static void headlessUsage(void)
+{
+	fprintf(stderr,
+		"Utilisation : LiFE --render [options]\n"
+		"  --fractal NOM      mandelbrot, julia, burningship ou newton (mandelbrot)\n"
+		"  --size LxH         taille de l'image en pixels (%dx%d)\n"
+		"  --view x0,x1,y0,y1 repère complexe, y0 en haut de l'image (celui de la fractale)\n"
+		"  --iter N           nombre d'itérations (celui de la fractale)\n"
+		"  --julia re,im      constante de la fractale de Julia (0.3,0.6)\n"
+		"  --power N          degré du polynome de la fractale de Newton (%d)\n"
+		"  --threads N        nombre de threads (un par coeur)\n"
+		"  --output FICHIER   fichier écrit (%s)\n"
+		"  --format FORMAT    png, ppm, raw ou field (celui de l'extension)\n"
+		"                     field : itérations, module final, itérations lissées et\n"
+		"                     racine de chaque pixel, écrits par tuiles (voir --tile)\n"
+		"  --poster           calcul par tuiles dans un BigTIFF (format tiff, ou raw\n"
+		"                     pour les indices sur 16 bits), repris s'il est interrompu\n"
+		"  --tile N           côté des tuiles, multiple de 16 (%d)\n"
+		"  --pyramid N        pyramide de tuiles %dx%d des niveaux 0 à N (%d au plus),\n"
+		"                     dans le dossier de sortie, ou une archive s'il finit par .pyr\n"
+		"  --listen ADRESSE   tuiles calculées par les travailleurs (LiFE --worker ADRESSE)\n"
+		"                     connectés à unix:CHEMIN, HÔTE:PORT ou PORT\n",
+		HEADLESS_WIDTH, HEADLESS_HEIGHT, DEFAULT_NEWTON_POWER, HEADLESS_OUTPUT, POSTER_TILE,
+		PYRAMID_TILE, PYRAMID_TILE, PYRAMID_LEVELS_MAX);
+}
+
+/**
+ * \fn int headlessFractalId(const char *name);
+ * \brief Identifiant d'une fractale complexe d'après son nom
+ * 
+ * \param name Nom de la fractale (mandelbrot, julia, burningship, newton)
+ * \return L'identifiant, 0 si le nom est inconnu
+ */
+int headlessFractalId(const char *name)
+{
+	if (strcmp(name, "mandelbrot") == 0)
+		return COMPLEX_MANDELBROT;
+	if (strcmp(name, "julia") == 0)
+		return COMPLEX_JULIA;
+	if (strcmp(name, "burningship") == 0)
+		return COMPLEX_BURNING_SHIP;
+	if (strcmp(name, "newton") == 0)
+		return COMPLEX_NEWTON;
+	
+	return 0;
+}
+
+/**
+ * \fn void renderJobInit(renderJob *job);
+ * \brief Valeurs par défaut d'une image à calculer
+ * 
+ * \param job Pointeur vers l'image à calculer
+ * \return Rien
+ */
+void renderJobInit(renderJob *job)
+{
+	memset(job, 0, sizeof(renderJob));
+	
+	job->fractalId = COMPLEX_MANDELBROT;
+	job->width = HEADLESS_WIDTH;
+	job->height = HEADLESS_HEIGHT;
+	job->cstJulia = complexSet(0.3, 0.6);
+	job->newtonPower = DEFAULT_NEWTON_POWER;
+	job->output = HEADLESS_OUTPUT;
+	job->tileSize = POSTER_TILE;
+}
+
+/**
+ * \fn bool renderJobParse(renderJob *job, int argc, char *argv[]);
+ * \brief Lit les options d'une image à calculer
+ * 
+ * Les options non données gardent leur valeur. "--render" est ignoré,
+ * "--poster" n'a pas de valeur.
+ * 
+ * \param job Pointeur vers l'image à calculer
+ * \param argc Nombre d'arguments
+ * \param argv Arguments, argv[0] compris
+ * \return Faux si une option est inconnue ou sa valeur invalide (message sur stderr)
+ */
+bool renderJobParse(renderJob *job, int argc, char *argv[])
+{
+	const char *option, *value;
+	bool valid;
+	char end;
+	int i;
+	
+	for (i = 1; i < argc; i++)
+	{
+		option = argv[i];
+		
+		if (strcmp(option, "--render") == 0)
+			continue;
+		
+		if (strcmp(option, "--poster") == 0)
+		{
+			job->poster = true;
+			continue;
+		}
+		
+		if (i + 1 >= argc)
+		{
+			fprintf(stderr, "Option %s : valeur manquante\n", option);
+			return false;
+		}
+		value = argv[++i];
+		
+		if (strcmp(option, "--fractal") == 0)
+			valid = (job->fractalId = headlessFractalId(value)) != 0;
+		else if (strcmp(option, "--size") == 0)
+			valid = sscanf(value, "%dx%d%c", &job->width, &job->height, &end) == 2
+				&& job->width > 0 && job->height > 0;
+		else if (strcmp(option, "--view") == 0)
+			valid = job->hasView = sscanf(value, "%lf,%lf,%lf,%lf%c", &job->view[0], &job->view[1],
+					&job->view[2], &job->view[3], &end) == 4
+				&& job->view[0] < job->view[1] && job->view[2] < job->view[3];
+		else if (strcmp(option, "--iter") == 0)
+			valid = sscanf(value, "%d%c", &job->iterMax, &end) == 1 && job->iterMax > 0;
+		else if (strcmp(option, "--julia") == 0)
+			valid = sscanf(value, "%lf,%lf%c", &job->cstJulia.real, &job->cstJulia.imag, &end) == 2;
+		else if (strcmp(option, "--power") == 0)
+			valid = sscanf(value, "%d%c", &job->newtonPower, &end) == 1 && job->newtonPower >= 2;
+		else if (strcmp(option, "--threads") == 0)
+			valid = sscanf(value, "%d%c", &job->threads, &end) == 1 && job->threads >= 0;
+		else if (strcmp(option, "--output") == 0)
+			valid = (job->output = value)[0] != '\0';
+		else if (strcmp(option, "--format") == 0)
+			valid = (job->format = imageFormatFromName(value)) != 0;
+		else if (strcmp(option, "--tile") == 0)
+			valid = sscanf(value, "%d%c", &job->tileSize, &end) == 1 && job->tileSize >= 16
+				&& job->tileSize <= POSTER_TILE_MAX && job->tileSize % 16 == 0;
+		else if (strcmp(option, "--pyramid") == 0)
+			valid = sscanf(value, "%d%c", &job->pyramidLevels, &end) == 1 && job->pyramidLevels > 0
+				&& job->pyramidLevels <= PYRAMID_LEVELS_MAX;
+		else if (strcmp(option, "--listen") == 0)
+			valid = (job->listen = value)[0] != '\0';
+		else
+		{
+			fprintf(stderr, "Option inconnue : %s\n", option);
+			return false;
+		}
+		
+		if (!valid)
+		{
+			fprintf(stderr, "Option %s : valeur invalide (%s)\n", option, value);
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+/**
+ * \fn fractalSettings renderJobSettings(renderJob *job);
+ * \brief Paramètres de la fractale à calculer
+ * 
+ * Sans repère donné, c'est celui de la fractale au lancement, à la
+ * proportion de l'image.
+ * 
+ * \param job Pointeur vers l'image à calculer
+ * \return Les paramètres de la fractale
+ */
+fractalSettings renderJobSettings(renderJob *job)
+{
+	fractalSettings fSet;
+	
+	memset(&fSet, 0, sizeof(fractalSettings));
+	viewportInit(&fSet, job->fractalId, job->width, job->height);
+	
+	if (job->hasView)
+	{
+		fSet.realMin = job->view[0];
+		fSet.realMax = job->view[1];
+		fSet.imagMin = job->view[2];
+		fSet.imagMax = job->view[3];
+	}
+	
+	if (job->iterMax > 0)
+		fSet.iterMax = job->iterMax;
+	
+	fSet.cstJulia = job->cstJulia;
+	fSet.newtonPower = job->newtonPower;
+	
+	return fSet;
+}
+
+/**
+ * \fn bool renderJobRun(renderJob *job);
+ * \brief Calcule l'image et l'écrit dans son fichier
+ * 
+ * \param job Pointeur vers l'image à calculer
+ * \return Vrai si le fichier est entièrement écrit (sinon message sur stderr)
+ */
+bool renderJobRun(renderJob *job)
+{
+	fractalSettings fSet = renderJobSettings(job);
+	int format = job->format != 0 ? job->format : imageFormatFromName(job->output);
+	iterationBuffer *buffer = NULL;
+	lifeRenderer *renderer = NULL;
+	palette *pal = NULL;
+	bool success;
+	int status;
+	
+	/* Les indices sont sur 16 bits, pas les itérations d'un champ */
+	if (format != IMAGE_FORMAT_FIELD && paletteSize(fSet) > 65536)
+	{
+		fprintf(stderr, "Trop d'itérations (%d) pour des indices sur 16 bits\n", fSet.iterMax);
+		return false;
+	}
+	
+	/* Pyramide : des tuiles PNG dans un dossier ou une archive */
+	if (job->pyramidLevels > 0)
+	{
+		if (job->listen != NULL)
+		{
+			fprintf(stderr, "--listen ne s'applique pas aux pyramides de tuiles\n");
+			return false;
+		}
+		
+		return pyramidRender(job, fSet);
+	}
+	
+	if (format == 0)
+	{
+		fprintf(stderr, "%s : format inconnu (png, ppm ou raw)\n", job->output);
+		return false;
+	}
+	
+	/* Champ d'itérations : toujours par tuiles, directement dans le fichier */
+	if (format == IMAGE_FORMAT_FIELD)
+	{
+		if (job->poster || job->listen != NULL)
+		{
+			fprintf(stderr, "%s : le format field ne s'utilise ni avec --poster ni avec --listen\n", job->output);
+			return false;
+		}
+		
+		success = fieldWrite(job->output, fSet, job->tileSize, job->threads);
+		if (!success)
+			fprintf(stderr, "Erreur lors de l'écriture de %s\n", job->output);
+		
+		return success;
+	}
+	
+	computeComplexThreads(job->threads);
+	
+	/* Par tuiles : l'image entière n'est jamais en mémoire */
+	if (job->poster)
+	{
+		if (format != IMAGE_FORMAT_TIFF && format != IMAGE_FORMAT_RAW)
+		{
+			fprintf(stderr, "%s : le calcul par tuiles écrit un BigTIFF (tiff ou raw)\n", job->output);
+			return false;
+		}
+		
+		return posterRender(job, fSet, format);
+	}
+	
+	if (format == IMAGE_FORMAT_TIFF)
+	{
+		fprintf(stderr, "%s : le format tiff demande --poster\n", job->output);
+		return false;
+	}
+	
+	/* L'image entière est en mémoire, indexée par des int */
+	if ((size_t) fSet.screenWidth * fSet.screenHeight > HEADLESS_PIXELS_MAX)
+	{
+		fprintf(stderr, "%s : image trop grande (%dx%d) pour un calcul en une fois, utiliser --poster\n",
+			job->output, fSet.screenWidth, fSet.screenHeight);
+		return false;
+	}
+	
+	buffer = iterationBufferCreate(fSet.screenWidth, fSet.screenHeight);
+	if (buffer == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation du tampon d'itérations (%dx%d)\n",
+			fSet.screenWidth, fSet.screenHeight);
+		exit(EXIT_FAILURE);
+	}
+	
+	/* Calcul réparti : les tuiles reviennent des travailleurs */
+	if (job->listen != NULL)
+	{
+		if (!clusterComputeFrame(job->listen, fSet, job->tileSize, buffer))
+		{
+			iterationBufferFree(buffer);
+			return false;
+		}
+	}
+	else
+	{
+		/* Calcul local par bandes, directement dans le tampon */
+		renderer = lifeRendererCreate(job->threads);
+		if (renderer == NULL)
+		{
+			fprintf(stderr, "Erreur lors de l'allocation du moteur de calcul\n");
+			exit(EXIT_FAILURE);
+		}
+		
+		status = lifeRenderIndices(renderer, fSet, buffer->data, buffer->width, NULL, NULL);
+		lifeRendererFree(renderer);
+		
+		if (status != LIFE_OK)
+		{
+			fprintf(stderr, "%s : paramètres de la fractale invalides\n", job->output);
+			iterationBufferFree(buffer);
+			return false;
+		}
+	}
+	
+	pal = paletteCreate(fSet);
+	if (pal == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation de la palette\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	success = imageFileWrite(job->output, format, buffer, pal);
+	
+	if (!success)
+		fprintf(stderr, "Erreur lors de l'écriture de %s\n", job->output);
+	
+	paletteFree(pal);
+	iterationBufferFree(buffer);
+	
+	return success;
+}
+
+/**
+ * \fn int headlessRender(int argc, char *argv[]);
+ * \brief Entrée du mode sans fenêtre
+ * 
+ * \param argc Nombre d'arguments
+ * \param argv Arguments de la ligne de commande
+ * \return EXIT_SUCCESS si l'image est écrite, EXIT_FAILURE sinon
+ */
+int headlessRender(int argc, char *argv[])
+{
+	renderJob job;
+	
+	renderJobInit(&job);
+	
+	if (!renderJobParse(&job, argc, argv))
+	{
+		headlessUsage();
+		return EXIT_FAILURE;
+	}
+	
+	return renderJobRun(&job) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,86 @@
+/**
+ * \file headless.h
+ * \brief Fichier d'entête, calcul d'une image sans fenêtre (LiFE --render)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Calcule une fractale complexe par le processeur et l'écrit dans un
+ * fichier image, sans initialiser la SDL ni OpenGL : le programme peut
+ * tourner sur un serveur sans écran.
+ * 
+ */
+
+#ifndef H_HEADLESS
+#define H_HEADLESS
+
+#include <limits.h>
+
+#include "viewport.h"
+#include "imageFile.h"
+
+/* Macros */
+
+/**
+ * \def HEADLESS_WIDTH
+ * \brief Largeur de l'image par défaut
+ */
+#define HEADLESS_WIDTH 1280
+
+/**
+ * \def HEADLESS_HEIGHT
+ * \brief Hauteur de l'image par défaut
+ */
+#define HEADLESS_HEIGHT 720
+
+/**
+ * \def HEADLESS_OUTPUT
+ * \brief Fichier écrit par défaut
+ */
+#define HEADLESS_OUTPUT "life.png"
+
+/**
+ * \def HEADLESS_PIXELS_MAX
+ * \brief Nombre maximum de pixels d'une image calculée en une fois (au delà : --poster)
+ */
+#define HEADLESS_PIXELS_MAX (INT_MAX / sizeof(unsigned short))
+
+/* Structures */
+
+/**
+ * \struct renderJob
+ * \brief Image à calculer, telle que décrite sur la ligne de commande
+ * 
+*/
+typedef struct
+{
+	int		fractalId;	/*!< Identifiant de la fractale */
+	int		width;		/*!< Largeur de l'image en pixels */
+	int		height;		/*!< Hauteur de l'image en pixels */
+	int		iterMax;	/*!< Nombre d'itérations, 0 pour celui de la fractale */
+	bool		hasView;	/*!< Vrai si le repère est donné, sinon celui de la fractale */
+	double		view[4];	/*!< Repère : realMin, realMax, imagMin, imagMax */
+	complex		cstJulia;	/*!< Constante complexe (fractale de Julia) */
+	int		newtonPower;	/*!< Degré du polynome (fractale de Newton) */
+	int		threads;	/*!< Nombre de threads, 0 pour un par coeur */
+	const char	*output;	/*!< Chemin du fichier écrit */
+	int		format;		/*!< Format de l'image, 0 pour celui de l'extension */
+	bool		poster;		/*!< Vrai pour un calcul par tuiles (voir poster.h) */
+	int		tileSize;	/*!< Côté des tuiles du calcul par tuiles */
+	int		pyramidLevels;	/*!< Niveau le plus profond d'une pyramide de tuiles, 0 sinon (voir pyramid.h) */
+	const char	*listen;	/*!< Adresse du coordinateur d'un calcul réparti, NULL sinon (voir cluster.h) */
+} renderJob;
+
+/* Prototypes */
+
+double headlessNowMs(void);
+int headlessFractalId(const char *name);
+void renderJobInit(renderJob *job);
+bool renderJobParse(renderJob *job, int argc, char *argv[]);
+fractalSettings renderJobSettings(renderJob *job);
+bool renderJobRun(renderJob *job);
+int headlessRender(int argc, char *argv[]);
+
+#endif /* H_HEADLESS */
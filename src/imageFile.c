@@ -0,0 +1,717 @@
+/**
+ * \file imageFile.c
+ * \brief Fichier source, écriture des fractales complexes dans un fichier image
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les images sont écrites ligne par ligne, sans garder l'image entière en
+ * mémoire : PNG (couleurs, compression deflate à codes de Huffman fixes,
+ * sans bibliothèque externe), PPM binaire (couleurs) ou brut (indices de couleur sur 16 bits,
+ * dans l'ordre des octets de la machine, sans en-tête).
+ * 
+ */
+
+#include "imageFile.h"
+
+#include <strings.h>
+
+/* Longueurs et distances de base des codes deflate, et leurs bits supplémentaires */
+static const int pngLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+					35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const int pngLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+					3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const int pngDistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+					257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const int pngDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+					7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+/**
+ * \fn static uint32_t crc32Update(uint32_t crc, const unsigned char *data, size_t size);
+ * \brief Prolonge un CRC-32 (celui des segments PNG) sur des données
+ * 
+ * \param crc CRC des données précédentes, 0 au départ
+ * \param data Données suivantes
+ * \param size Taille des données en octets
+ * \return Le CRC prolongé
+ */
+static uint32_t crc32Update(uint32_t crc, const unsigned char *data, size_t size)
+{
+	static uint32_t table[256];
+	static bool tableReady = false;
+	uint32_t c;
+	size_t i;
+	int n, k;
+	
+	if (!tableReady)
+	{
+		for (n = 0; n < 256; n++)
+		{
+			c = (uint32_t) n;
+			for (k = 0; k < 8; k++)
+				c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+			table[n] = c;
+		}
+		tableReady = true;
+	}
+	
+	crc = ~crc;
+	for (i = 0; i < size; i++)
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	
+	return ~crc;
+}
+
+/**
+ * \fn static void putUint32(unsigned char *dest, uint32_t value);
+ * \brief Écrit un entier de 32 bits, octet de poids fort en premier
+ * 
+ * \param dest Destination (4 octets)
+ * \param value Valeur à écrire
+ * \return Rien
+ */
+static void putUint32(unsigned char *dest, uint32_t value)
+{
+	dest[0] = value >> 24;
+	dest[1] = value >> 16;
+	dest[2] = value >> 8;
+	dest[3] = value;
+}
+
+/**
+ * \fn static void pngChunk(imageWriter *writer, const char *type, const unsigned char *data, uint32_t size);
+ * \brief Écrit un segment PNG : taille, type, données et CRC
+ * 
+ * \param writer Pointeur vers l'écriture en cours
+ * \param type Type du segment (4 caractères)
+ * \param data Données du segment
+ * \param size Taille des données en octets
+ * \return Rien
+ */
+static void pngChunk(imageWriter *writer, const char *type, const unsigned char *data, uint32_t size)
+{
+	unsigned char header[8], footer[4];
+	uint32_t crc;
+	
+	putUint32(header, size);
+	memcpy(header + 4, type, 4);
+	
+	crc = crc32Update(0, header + 4, 4);
+	crc = crc32Update(crc, data, size);
+	putUint32(footer, crc);
+	
+	if (fwrite(header, 1, 8, writer->file) != 8
+		|| (size > 0 && fwrite(data, 1, size, writer->file) != size)
+		|| fwrite(footer, 1, 4, writer->file) != 4)
+		writer->error = true;
+}
+
+/**
+ * \fn static void pngBits(imageWriter *writer, unsigned char *out, int *size, uint32_t value, int count);
+ * \brief Ajoute des bits au flux deflate, bit de poids faible en premier
+ * 
+ * Les bits qui ne complètent pas un octet attendent le segment suivant.
+ * 
+ * \param writer Pointeur vers l'écriture en cours
+ * \param out Octets du segment en cours
+ * \param size Nombre d'octets de out, mis à jour
+ * \param value Bits à ajouter
+ * \param count Nombre de bits (16 au plus)
+ * \return Rien
+ */
+static void pngBits(imageWriter *writer, unsigned char *out, int *size, uint32_t value, int count)
+{
+	writer->bits |= value << writer->bitCount;
+	writer->bitCount += count;
+	
+	while (writer->bitCount >= 8)
+	{
+		out[(*size)++] = writer->bits & 0xFF;
+		writer->bits >>= 8;
+		writer->bitCount -= 8;
+	}
+}
+
+/**
+ * \fn static void pngCode(imageWriter *writer, unsigned char *out, int *size, uint32_t code, int count);
+ * \brief Ajoute un code de Huffman au flux deflate, bit de poids fort en premier
+ * 
+ * \param writer Pointeur vers l'écriture en cours
+ * \param out Octets du segment en cours
+ * \param size Nombre d'octets de out, mis à jour
+ * \param code Code de Huffman
+ * \param count Longueur du code en bits
+ * \return Rien
+ */
+static void pngCode(imageWriter *writer, unsigned char *out, int *size, uint32_t code, int count)
+{
+	uint32_t reversed = 0;
+	int i;
+	
+	for (i = 0; i < count; i++)
+		reversed |= ((code >> i) & 1) << (count - 1 - i);
+	
+	pngBits(writer, out, size, reversed, count);
+}
+
+/**
+ * \fn static int pngSymbolBits(int symbol);
+ * \brief Longueur du code de Huffman fixe d'un symbole littéral ou longueur
+ * 
+ * \param symbol Symbole (0 à 285)
+ * \return Longueur du code en bits
+ */
+static int pngSymbolBits(int symbol)
+{
+	if (symbol < 144)
+		return 8;
+	if (symbol < 256)
+		return 9;
+	if (symbol < 280)
+		return 7;
+	
+	return 8;
+}
+
+/**
+ * \fn static void pngSymbol(imageWriter *writer, unsigned char *out, int *size, int symbol);
+ * \brief Ajoute le code de Huffman fixe d'un symbole littéral ou longueur
+ * 
+ * \param writer Pointeur vers l'écriture en cours
+ * \param out Octets du segment en cours
+ * \param size Nombre d'octets de out, mis à jour
+ * \param symbol Symbole (0 à 285)
+ * \return Rien
+ */
+static void pngSymbol(imageWriter *writer, unsigned char *out, int *size, int symbol)
+{
+	if (symbol < 144)
+		pngCode(writer, out, size, 0x30 + symbol, 8);
+	else if (symbol < 256)
+		pngCode(writer, out, size, 0x190 + symbol - 144, 9);
+	else if (symbol < 280)
+		pngCode(writer, out, size, symbol - 256, 7);
+	else
+		pngCode(writer, out, size, 0xC0 + symbol - 280, 8);
+}
+
+/**
+ * \fn static int pngLengthCode(int length);
+ * \brief Code deflate d'une longueur de répétition
+ * 
+ * \param length Longueur (3 à PNG_MATCH_MAX)
+ * \return L'indice du code dans pngLengthBase, le symbole étant 257 + indice
+ */
+static int pngLengthCode(int length)
+{
+	int code = 0;
+	
+	while (code < 28 && pngLengthBase[code + 1] <= length)
+		code++;
+	
+	return code;
+}
+
+/**
+ * \fn static int pngDistanceCode(int distance);
+ * \brief Code deflate d'une distance de répétition
+ * 
+ * \param distance Distance (1 à PNG_WINDOW)
+ * \return Le code de la distance (0 à 29)
+ */
+static int pngDistanceCode(int distance)
+{
+	int code = 0;
+	
+	while (code < 29 && pngDistanceBase[code + 1] <= distance)
+		code++;
+	
+	return code;
+}
+
+/**
+ * \fn static int pngHash(const unsigned char *data);
+ * \brief Empreinte des 3 octets d'une répétition possible
+ * 
+ * \param data Premier des 3 octets
+ * \return L'empreinte (moins de 2^PNG_HASH_BITS)
+ */
+static int pngHash(const unsigned char *data)
+{
+	return ((data[0] << 10) ^ (data[1] << 5) ^ data[2]) & ((1 << PNG_HASH_BITS) - 1);
+}
+
+/**
+ * \fn static void pngInsert(imageWriter *writer, int end);
+ * \brief Indexe les positions de block dont les 3 octets sont connus
+ * 
+ * \param writer Pointeur vers l'écriture en cours
+ * \param end Position suivant le dernier octet connu
+ * \return Rien
+ */
+static void pngInsert(imageWriter *writer, int end)
+{
+	int hash;
+	
+	for (; writer->hashed + 2 < end; writer->hashed++)
+	{
+		hash = pngHash(writer->block + writer->hashed);
+		writer->prev[writer->hashed] = writer->head[hash];
+		writer->head[hash] = writer->hashed;
+	}
+}
+
+/**
+ * \fn static int pngTokens(imageWriter *writer, int *bits);
+ * \brief Découpe les données en attente en littéraux et répétitions (LZ77)
+ * 
+ * Chaque position cherche la plus longue répétition parmi les
+ * PNG_CHAIN dernières positions de même empreinte, à moins de PNG_WINDOW
+ * octets, données déjà compressées comprises.
+ * 
+ * \param writer Pointeur vers l'écriture en cours
+ * \param bits Reçoit la taille du bloc codé en Huffman fixe, en bits
+ * \return Le nombre de symboles rangés dans writer->tokens
+ */
+static int pngTokens(imageWriter *writer, int *bits)
+{
+	unsigned char *data = writer->block;
+	int end = writer->history + writer->blockSize;
+	int pos = writer->history, count = 0;
+	int candidate, chain, length, bestLength, bestDistance, limit, code;
+	
+	/* En-tête du bloc et fin de bloc (symbole 256) */
+	*bits = 3 + 7;
+	
+	pngInsert(writer, end);
+	
+	while (pos < end)
+	{
+		bestLength = 0;
+		bestDistance = 0;
+		limit = end - pos < PNG_MATCH_MAX ? end - pos : PNG_MATCH_MAX;
+		candidate = pos + 2 < end ? writer->prev[pos] : -1;
+		
+		for (chain = 0; chain < PNG_CHAIN && candidate >= 0 && pos - candidate <= PNG_WINDOW; chain++)
+		{
+			for (length = 0; length < limit && data[candidate + length] == data[pos + length]; length++)
+				;
+			
+			if (length > bestLength)
+			{
+				bestLength = length;
+				bestDistance = pos - candidate;
+				if (length == limit)
+					break;
+			}
+			
+			candidate = writer->prev[candidate];
+		}
+		
+		if (bestLength >= 3)
+		{
+			writer->tokens[count++] = (uint32_t) bestDistance << 9 | bestLength;
+			
+			code = pngLengthCode(bestLength);
+			*bits += pngSymbolBits(257 + code) + pngLengthExtra[code];
+			code = pngDistanceCode(bestDistance);
+			*bits += 5 + pngDistanceExtra[code];
+			
+			pos += bestLength;
+		}
+		else
+		{
+			writer->tokens[count++] = data[pos];
+			*bits += pngSymbolBits(data[pos]);
+			pos++;
+		}
+	}
+	
+	return count;
+}
+
+/**
+ * \fn static void pngFlush(imageWriter *writer, bool last);
+ * \brief Compresse les données en attente en un bloc deflate, écrit dans un segment IDAT
+ * 
+ * Le bloc utilise les codes de Huffman fixes, ou reste "stocké" si la
+ * compression ne le réduit pas. Le flux zlib est réparti sur plusieurs
+ * segments IDAT : l'en-tête zlib précède le premier bloc, la somme
+ * Adler-32 suit le dernier.
+ * 
+ * \param writer Pointeur vers l'écriture en cours
+ * \param last Vrai pour le dernier bloc du flux
+ * \return Rien
+ */
+static void pngFlush(imageWriter *writer, bool last)
+{
+	unsigned char chunk[2 + 8 + 5 + PNG_BLOCK + 4];
+	unsigned char *data = writer->block + writer->history;
+	uint32_t token;
+	int size = 0, count, bits, i, code, length, distance, shift, hash;
+	
+	if (!writer->zlibHeader)
+	{
+		/* Fenêtre de 32 Ko, compression rapide */
+		chunk[size++] = 0x78;
+		chunk[size++] = 0x01;
+		writer->zlibHeader = true;
+	}
+	
+	count = pngTokens(writer, &bits);
+	
+	if (bits < 3 + 7 + 32 + 8 * writer->blockSize)
+	{
+		/* Bloc à codes de Huffman fixes (type 1) */
+		pngBits(writer, chunk, &size, (last ? 1 : 0) | 1 << 1, 3);
+		
+		for (i = 0; i < count; i++)
+		{
+			token = writer->tokens[i];
+			length = token & 0x1FF;
+			distance = token >> 9;
+			
+			if (distance == 0)
+			{
+				pngSymbol(writer, chunk, &size, length);
+				continue;
+			}
+			
+			code = pngLengthCode(length);
+			pngSymbol(writer, chunk, &size, 257 + code);
+			pngBits(writer, chunk, &size, length - pngLengthBase[code], pngLengthExtra[code]);
+			
+			code = pngDistanceCode(distance);
+			pngCode(writer, chunk, &size, code, 5);
+			pngBits(writer, chunk, &size, distance - pngDistanceBase[code], pngDistanceExtra[code]);
+		}
+		
+		pngSymbol(writer, chunk, &size, 256);
+	}
+	else
+	{
+		/* Bloc stocké (type 0) : taille et son complément, sur un octet entier */
+		pngBits(writer, chunk, &size, last ? 1 : 0, 3);
+		pngBits(writer, chunk, &size, 0, (8 - writer->bitCount) % 8);
+		pngBits(writer, chunk, &size, writer->blockSize, 16);
+		pngBits(writer, chunk, &size, ~writer->blockSize & 0xFFFF, 16);
+		
+		memcpy(chunk + size, data, writer->blockSize);
+		size += writer->blockSize;
+	}
+	
+	if (last)
+	{
+		/* Le flux se termine sur un octet entier */
+		pngBits(writer, chunk, &size, 0, (8 - writer->bitCount) % 8);
+		putUint32(chunk + size, writer->adler);
+		size += 4;
+	}
+	
+	/* On ne garde que les PNG_WINDOW derniers octets pour les répétitions */
+	writer->history += writer->blockSize;
+	writer->blockSize = 0;
+	shift = writer->history - PNG_WINDOW;
+	
+	if (shift > 0)
+	{
+		memmove(writer->block, writer->block + shift, PNG_WINDOW);
+		memmove(writer->prev, writer->prev + shift, PNG_WINDOW * sizeof(int));
+		
+		for (i = 0; i < PNG_WINDOW; i++)
+			writer->prev[i] = writer->prev[i] >= shift ? writer->prev[i] - shift : -1;
+		for (hash = 0; hash < 1 << PNG_HASH_BITS; hash++)
+			writer->head[hash] = writer->head[hash] >= shift ? writer->head[hash] - shift : -1;
+		
+		writer->history = PNG_WINDOW;
+		writer->hashed -= shift;
+	}
+	
+	pngChunk(writer, "IDAT", chunk, size);
+}
+
+/**
+ * \fn static void pngWrite(imageWriter *writer, const unsigned char *data, int size);
+ * \brief Ajoute des données d'image au flux PNG
+ * 
+ * \param writer Pointeur vers l'écriture en cours
+ * \param data Données (lignes précédées de leur octet de filtre)
+ * \param size Taille des données en octets
+ * \return Rien
+ */
+static void pngWrite(imageWriter *writer, const unsigned char *data, int size)
+{
+	uint32_t a = writer->adler & 0xFFFF, b = writer->adler >> 16;
+	int i, part;
+	
+	for (i = 0; i < size; i++)
+	{
+		a = (a + data[i]) % 65521;
+		b = (b + a) % 65521;
+	}
+	writer->adler = (b << 16) | a;
+	
+	while (size > 0)
+	{
+		part = PNG_BLOCK - writer->blockSize < size ? PNG_BLOCK - writer->blockSize : size;
+		memcpy(writer->block + writer->history + writer->blockSize, data, part);
+		writer->blockSize += part;
+		data += part;
+		size -= part;
+		
+		if (writer->blockSize == PNG_BLOCK)
+			pngFlush(writer, false);
+	}
+}
+
+/**
+ * \fn int imageFormatFromName(const char *name);
+ * \brief Déduit le format d'image d'un nom ("png", "ppm", "raw", "tiff", "field") ou de l'extension d'un fichier
+ * 
+ * \param name Nom du format ou chemin du fichier
+ * \return L'identifiant du format, 0 s'il est inconnu
+ */
+int imageFormatFromName(const char *name)
+{
+	const char *extension = strrchr(name, '.');
+	
+	if (extension != NULL)
+		name = extension + 1;
+	
+	if (strcasecmp(name, "png") == 0)
+		return IMAGE_FORMAT_PNG;
+	if (strcasecmp(name, "ppm") == 0)
+		return IMAGE_FORMAT_PPM;
+	if (strcasecmp(name, "raw") == 0)
+		return IMAGE_FORMAT_RAW;
+	if (strcasecmp(name, "tif") == 0 || strcasecmp(name, "tiff") == 0)
+		return IMAGE_FORMAT_TIFF;
+	if (strcasecmp(name, "field") == 0)
+		return IMAGE_FORMAT_FIELD;
+	
+	return 0;
+}
+
+/**
+ * \fn imageWriter* imageWriterOpen(FILE *file, int format, int width, int height);
+ * \brief Commence l'écriture d'une image et écrit son en-tête
+ * 
+ * \param file Fichier de destination, ouvert en écriture binaire
+ * \param format Format de l'image (IMAGE_FORMAT_...)
+ * \param width Largeur de l'image en pixels
+ * \param height Hauteur de l'image en pixels
+ * \return Un pointeur vers l'écriture en cours
+ */
+imageWriter* imageWriterOpen(FILE *file, int format, int width, int height)
+{
+	imageWriter *writer = (imageWriter*) malloc(sizeof(imageWriter));
+	unsigned char header[13];
+	const unsigned char signature[8] = {137, 'P', 'N', 'G', '\r', '\n', 26, '\n'};
+	
+	if (writer != NULL)
+	{
+		memset(writer, 0, sizeof(imageWriter));
+		writer->line = (unsigned char*) malloc(1 + 3 * (size_t) width);
+		
+		if (format == IMAGE_FORMAT_PNG)
+		{
+			writer->block = (unsigned char*) malloc(PNG_WINDOW + PNG_BLOCK);
+			writer->head = (int*) malloc(sizeof(int) << PNG_HASH_BITS);
+			writer->prev = (int*) malloc((PNG_WINDOW + PNG_BLOCK) * sizeof(int));
+			writer->tokens = (uint32_t*) malloc(PNG_BLOCK * sizeof(uint32_t));
+		}
+	}
+	
+	if (writer == NULL || writer->line == NULL || (format == IMAGE_FORMAT_PNG
+		&& (writer->block == NULL || writer->head == NULL || writer->prev == NULL || writer->tokens == NULL)))
+	{
+		fprintf(stderr, "Erreur lors de l'allocation de l'écriture d'image (%dx%d)\n", width, height);
+		exit(EXIT_FAILURE);
+	}
+	
+	writer->file = file;
+	writer->format = format;
+	writer->width = width;
+	writer->height = height;
+	writer->adler = 1;
+	
+	switch (format)
+	{
+		case IMAGE_FORMAT_PNG:
+			/* Aucune répétition connue */
+			memset(writer->head, 0xFF, sizeof(int) << PNG_HASH_BITS);
+			
+			if (fwrite(signature, 1, 8, file) != 8)
+				writer->error = true;
+		
+			/* Couleurs RGB sur 8 bits, sans entrelacement */
+			putUint32(header, width);
+			putUint32(header + 4, height);
+			header[8] = 8;
+			header[9] = 2;
+			header[10] = 0;
+			header[11] = 0;
+			header[12] = 0;
+			pngChunk(writer, "IHDR", header, 13);
+			break;
+		
+		case IMAGE_FORMAT_PPM:
+			if (fprintf(file, "P6\n%d %d\n255\n", width, height) < 0)
+				writer->error = true;
+			break;
+	}
+	
+	return writer;
+}
+
+/**
+ * \fn void imageWriterRow(imageWriter *writer, const unsigned short *indices, palette *pal);
+ * \brief Écrit la ligne suivante de l'image
+ * 
+ * \param writer Pointeur vers l'écriture en cours
+ * \param indices Indices de couleur de la ligne (largeur de l'image)
+ * \param pal Palette des indices (inutilisée au format brut)
+ * \return Rien
+ */
+void imageWriterRow(imageWriter *writer, const unsigned short *indices, palette *pal)
+{
+	unsigned char *pixel = writer->line + 1;
+	colorRGB black = {0, 0, 0}, color;
+	int x;
+	
+	writer->rows++;
+	
+	if (writer->format == IMAGE_FORMAT_RAW)
+	{
+		if (fwrite(indices, sizeof(unsigned short), writer->width, writer->file) != (size_t) writer->width)
+			writer->error = true;
+		return;
+	}
+	
+	for (x = 0; x < writer->width; x++)
+	{
+		color = indices[x] < pal->size ? pal->colors[indices[x]] : black;
+		*pixel++ = color.red;
+		*pixel++ = color.green;
+		*pixel++ = color.blue;
+	}
+	
+	if (writer->format == IMAGE_FORMAT_PNG)
+	{
+		/* Ligne sans filtre */
+		writer->line[0] = 0;
+		pngWrite(writer, writer->line, 1 + 3 * writer->width);
+	}
+	else if (fwrite(writer->line + 1, 3, writer->width, writer->file) != (size_t) writer->width)
+		writer->error = true;
+}
+
+/**
+ * \fn bool imageWriterClose(imageWriter *writer);
+ * \brief Termine l'écriture de l'image et libère l'écriture en cours
+ * 
+ * Le fichier reste ouvert.
+ * 
+ * \param writer Pointeur vers l'écriture en cours
+ * \return Vrai si toutes les lignes ont été écrites sans erreur
+ */
+bool imageWriterClose(imageWriter *writer)
+{
+	bool success;
+	
+	if (writer->format == IMAGE_FORMAT_PNG)
+	{
+		pngFlush(writer, true);
+		pngChunk(writer, "IEND", NULL, 0);
+	}
+	
+	success = !writer->error && writer->rows == writer->height;
+	
+	free(writer->line);
+	free(writer->block);
+	free(writer->head);
+	free(writer->prev);
+	free(writer->tokens);
+	free(writer);
+	
+	return success;
+}
+
+/**
+ * \fn bool imageFileWrite(const char *path, int format, iterationBuffer *buffer, palette *pal);
+ * \brief Écrit un tampon d'itérations dans un fichier image
+ * 
+ * \param path Chemin du fichier
+ * \param format Format de l'image (IMAGE_FORMAT_...)
+ * \param buffer Tampon d'itérations, la ligne 0 en haut de l'image
+ * \param pal Palette des indices
+ * \return Vrai si le fichier est entièrement écrit
+ */
+bool imageFileWrite(const char *path, int format, iterationBuffer *buffer, palette *pal)
+{
+	FILE *file = fopen(path, "wb");
+	imageWriter *writer;
+	bool success;
+	int y;
+	
+	if (file == NULL)
+		return false;
+	
+	writer = imageWriterOpen(file, format, buffer->width, buffer->height);
+	
+	for (y = 0; y < buffer->height; y++)
+		imageWriterRow(writer, buffer->data + (size_t) y * buffer->width, pal);
+	
+	success = imageWriterClose(writer);
+	
+	if (fclose(file) != 0)
+		success = false;
+	
+	return success;
+}
+
+/**
+ * \fn bool imageFileEncode(int format, iterationBuffer *buffer, palette *pal, char **data, size_t *size);
+ * \brief Écrit un tampon d'itérations dans une image en mémoire
+ * 
+ * \param format Format de l'image (IMAGE_FORMAT_...)
+ * \param buffer Tampon d'itérations, la ligne 0 en haut de l'image
+ * \param pal Palette des indices
+ * \param data Reçoit l'image, à libérer par free() (NULL en cas d'échec)
+ * \param size Reçoit la taille de l'image en octets
+ * \return Vrai si l'image est entièrement écrite
+ */
+bool imageFileEncode(int format, iterationBuffer *buffer, palette *pal, char **data, size_t *size)
+{
+	FILE *memory;
+	imageWriter *writer;
+	bool success;
+	int y;
+	
+	*data = NULL;
+	*size = 0;
+	
+	memory = open_memstream(data, size);
+	if (memory == NULL)
+		return false;
+	
+	writer = imageWriterOpen(memory, format, buffer->width, buffer->height);
+	
+	for (y = 0; y < buffer->height; y++)
+		imageWriterRow(writer, buffer->data + (size_t) y * buffer->width, pal);
+	
+	success = imageWriterClose(writer);
+	
+	if (fclose(memory) != 0)
+		success = false;
+	
+	if (!success)
+	{
+		free(*data);
+		*data = NULL;
+	}
+	
+	return success;
+}
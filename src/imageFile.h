@@ -0,0 +1,124 @@
+/**
+ * \file imageFile.h
+ * \brief Fichier d'entête, écriture des fractales complexes dans un fichier image
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les images sont écrites ligne par ligne, sans garder l'image entière en
+ * mémoire : PNG (couleurs, compression deflate à codes de Huffman fixes,
+ * sans bibliothèque externe), PPM binaire (couleurs) ou brut (indices de couleur sur 16 bits,
+ * dans l'ordre des octets de la machine, sans en-tête).
+ * 
+ */
+
+#ifndef H_IMAGE_FILE
+#define H_IMAGE_FILE
+
+#include <stdint.h>
+
+#include "palette.h"
+
+/* Macros */
+
+/**
+ * \def IMAGE_FORMAT_PNG
+ * \brief Identifiant du format PNG
+ */
+#define IMAGE_FORMAT_PNG 1
+
+/**
+ * \def IMAGE_FORMAT_PPM
+ * \brief Identifiant du format PPM binaire
+ */
+#define IMAGE_FORMAT_PPM 2
+
+/**
+ * \def IMAGE_FORMAT_RAW
+ * \brief Identifiant du format brut (indices de couleur)
+ */
+#define IMAGE_FORMAT_RAW 3
+
+/**
+ * \def IMAGE_FORMAT_TIFF
+ * \brief Identifiant du format BigTIFF tuilé (calcul par tuiles seulement, voir poster.h)
+ */
+#define IMAGE_FORMAT_TIFF 4
+
+/**
+ * \def IMAGE_FORMAT_FIELD
+ * \brief Identifiant du champ d'itérations brut (voir iterationField.h)
+ */
+#define IMAGE_FORMAT_FIELD 5
+
+/**
+ * \def PNG_BLOCK
+ * \brief Données compressées en un bloc deflate, soit un segment IDAT, en octets
+ */
+#define PNG_BLOCK 65535
+
+/**
+ * \def PNG_WINDOW
+ * \brief Distance maximale d'une répétition deflate, en octets
+ */
+#define PNG_WINDOW 32768
+
+/**
+ * \def PNG_MATCH_MAX
+ * \brief Longueur maximale d'une répétition deflate, en octets
+ */
+#define PNG_MATCH_MAX 258
+
+/**
+ * \def PNG_HASH_BITS
+ * \brief Nombre de bits des empreintes servant à chercher les répétitions
+ */
+#define PNG_HASH_BITS 15
+
+/**
+ * \def PNG_CHAIN
+ * \brief Nombre de positions de même empreinte essayées pour une répétition
+ */
+#define PNG_CHAIN 16
+
+/* Structures */
+
+/**
+ * \struct imageWriter
+ * \brief Écriture en cours d'une image, ligne par ligne
+ * 
+*/
+typedef struct
+{
+	FILE		*file;		/*!< Fichier de destination */
+	int		format;		/*!< Format de l'image (IMAGE_FORMAT_...) */
+	int		width;		/*!< Largeur de l'image en pixels */
+	int		height;		/*!< Hauteur de l'image en pixels */
+	int		rows;		/*!< Nombre de lignes déjà écrites */
+	unsigned char	*line;		/*!< Ligne en cours de conversion */
+	unsigned char	*block;		/*!< Données PNG déjà compressées (history octets) puis en attente */
+	int		history;	/*!< Octets déjà compressés gardés pour les répétitions */
+	int		blockSize;	/*!< Nombre d'octets en attente */
+	int		hashed;		/*!< Position suivant la dernière position indexée */
+	int		*head;		/*!< Dernière position de chaque empreinte, -1 si aucune */
+	int		*prev;		/*!< Position précédente de même empreinte, pour chaque position */
+	uint32_t	*tokens;	/*!< Littéraux et répétitions du bloc en cours */
+	uint32_t	bits;		/*!< Bits du flux deflate n'ayant pas encore formé un octet */
+	int		bitCount;	/*!< Nombre de ces bits */
+	bool		zlibHeader;	/*!< Vrai si l'en-tête zlib est écrit */
+	uint32_t		adler;		/*!< Somme de contrôle Adler-32 des données PNG */
+	bool		error;		/*!< Vrai si une écriture a échoué */
+} imageWriter;
+
+/* Prototypes */
+
+int imageFormatFromName(const char *name);
+imageWriter* imageWriterOpen(FILE *file, int format, int width, int height);
+void imageWriterRow(imageWriter *writer, const unsigned short *indices, palette *pal);
+bool imageWriterClose(imageWriter *writer);
+bool imageFileWrite(const char *path, int format, iterationBuffer *buffer, palette *pal);
+bool imageFileEncode(int format, iterationBuffer *buffer, palette *pal, char **data, size_t *size);
+
+#endif /* H_IMAGE_FILE */
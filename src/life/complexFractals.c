@@ -0,0 +1,768 @@
+/**
+ * \file complexFractals.c
+ * \brief Fichier source, contient toutes les fractales de type complexe
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 2.0
+ * \date 02/02/2012
+ * 
+ * Dessine les fractales complexes dans le plan Complexe, ou la partie
+ * réelle est sur l'axe des abscisses et la partie imaginaire est sur
+ * l'axe des ordonnées.
+ * 
+ */
+
+#include "complexFractals.h"
+
+#include <pthread.h>
+
+/**
+ * \struct computeTask
+ * \brief Part d'un calcul parallèle confiée à un thread
+ * 
+*/
+typedef struct
+{
+	fractalSettings	fSet;		/*!< Paramètres de la fractale */
+	iterationBuffer	*buffer;	/*!< Tampon recevant les indices */
+	int		firstRow;	/*!< Première ligne du thread */
+	int		lastRow;	/*!< Ligne suivant la dernière ligne à calculer */
+	int		step;		/*!< Écart entre deux lignes du thread */
+} computeTask;
+
+/* Nombre de threads des calculs parallèles, 0 tant qu'il n'est pas fixé */
+static int threadCount = 0;
+
+/**
+ * \fn iterationBuffer* iterationBufferCreate(int width, int height);
+ * \brief Alloue un tampon d'itérations
+ * 
+ * \param width Largeur du tampon en pixels
+ * \param height Hauteur du tampon en pixels
+ * \return Un pointeur vers le tampon alloué, NULL si la mémoire manque
+ */
+iterationBuffer* iterationBufferCreate(int width, int height)
+{
+	iterationBuffer *buffer = NULL;
+	
+	buffer = (iterationBuffer*) malloc(sizeof(iterationBuffer));
+	
+	if (buffer != NULL)
+		buffer->data = (unsigned short*) calloc((size_t) width * height, sizeof(unsigned short));
+	
+	if (buffer == NULL || buffer->data == NULL)
+	{
+		free(buffer);
+		return NULL;
+	}
+	
+	buffer->width = width;
+	buffer->height = height;
+	
+	return buffer;
+}
+
+/**
+ * \fn void iterationBufferFree(iterationBuffer *buffer);
+ * \brief Libère un tampon d'itérations
+ * 
+ * \param buffer Pointeur vers le tampon
+ * \return Rien
+ */
+void iterationBufferFree(iterationBuffer *buffer)
+{
+	if (buffer != NULL)
+	{
+		free(buffer->data);
+		free(buffer);
+	}
+}
+
+/**
+ * \fn void computeComplexFractal(fractalSettings fSet, iterationBuffer *buffer);
+ * \brief Calcule la fractale complexe désignée par fSet.fractalId
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur
+ * \return Rien
+ */
+void computeComplexFractal(fractalSettings fSet, iterationBuffer *buffer)
+{
+	computeComplexRows(fSet, buffer, 0, fSet.screenHeight);
+}
+
+/**
+ * \fn static void* computeWorker(void *arg);
+ * \brief Calcule les lignes d'une part de calcul parallèle
+ * 
+ * Les lignes sont entrelacées d'un thread à l'autre : les lignes du
+ * centre, souvent plus coûteuses, sont partagées entre tous les threads.
+ * 
+ * \param arg Pointeur vers la part de calcul (computeTask)
+ * \return NULL
+ */
+static void* computeWorker(void *arg)
+{
+	computeTask *task = (computeTask*) arg;
+	int y;
+	
+	for (y = task->firstRow; y < task->lastRow; y += task->step)
+		computeComplexRows(task->fSet, task->buffer, y, y + 1);
+	
+	return NULL;
+}
+
+/**
+ * \fn bool computeComplexSymmetric(fractalSettings fSet);
+ * \brief Indique si la vue est symétrique par rapport à l'origine
+ * 
+ * La fractale de Julia est symétrique par rapport à l'origine (z et -z
+ * ont la même suite au carré près). Si la vue est centrée sur l'origine,
+ * le pixel (x, y) est l'opposé du pixel (largeur - x, hauteur - y).
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \return Vrai si la moitié de la vue suffit à la calculer entièrement
+ */
+bool computeComplexSymmetric(fractalSettings fSet)
+{
+	double pixelWidth = (fSet.realMax - fSet.realMin) / fSet.screenWidth;
+	double pixelHeight = (fSet.imagMax - fSet.imagMin) / fSet.screenHeight;
+	
+	return fSet.fractalId == COMPLEX_JULIA
+		&& fabs(fSet.realMin + fSet.realMax) < pixelWidth * 1e-3
+		&& fabs(fSet.imagMin + fSet.imagMax) < pixelHeight * 1e-3;
+}
+
+/**
+ * \fn static fractalSettings gridSettings(fractalSettings fSet, int x, int y, int columns, int rows, int stepX, int stepY);
+ * \brief Paramètres de la petite fractale formée par une grille de pixels
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param x Colonne du premier pixel
+ * \param y Ligne du premier pixel
+ * \param columns Nombre de colonnes de la grille
+ * \param rows Nombre de lignes de la grille
+ * \param stepX Écart entre deux colonnes en pixels
+ * \param stepY Écart entre deux lignes en pixels
+ * \return Les paramètres dont le pixel (i, j) est le pixel (x + i * stepX, y + j * stepY) de fSet
+ */
+static fractalSettings gridSettings(fractalSettings fSet, int x, int y, int columns, int rows, int stepX, int stepY)
+{
+	fractalSettings grid = fSet;
+	double pixelWidth = (fSet.realMax - fSet.realMin) / fSet.screenWidth;
+	double pixelHeight = (fSet.imagMax - fSet.imagMin) / fSet.screenHeight;
+	
+	grid.screenWidth = columns;
+	grid.screenHeight = rows;
+	grid.realMin = fSet.realMin + x * pixelWidth;
+	grid.realMax = grid.realMin + columns * stepX * pixelWidth;
+	grid.imagMin = fSet.imagMin + y * pixelHeight;
+	grid.imagMax = grid.imagMin + rows * stepY * pixelHeight;
+	
+	return grid;
+}
+
+/**
+ * \fn static void gridCopy(iterationBuffer *buffer, iterationBuffer *part, int x, int y, int stepX, int stepY);
+ * \brief Recopie les indices d'une grille de pixels à leur place dans le tampon
+ * 
+ * \param buffer Tampon recevant les indices de couleur
+ * \param part Indices de la grille (voir gridSettings())
+ * \param x Colonne du premier pixel
+ * \param y Ligne du premier pixel
+ * \param stepX Écart entre deux colonnes en pixels
+ * \param stepY Écart entre deux lignes en pixels
+ * \return Rien
+ */
+static void gridCopy(iterationBuffer *buffer, iterationBuffer *part, int x, int y, int stepX, int stepY)
+{
+	int columns = part->width, i, j;
+	
+	for (j = 0; j < part->height; j++)
+	{
+		if (stepX == 1)
+			memcpy(buffer->data + (size_t) (y + j * stepY) * buffer->width + x, part->data + (size_t) j * columns,
+				columns * sizeof(unsigned short));
+		else
+			for (i = 0; i < columns; i++)
+				buffer->data[(size_t) (y + j * stepY) * buffer->width + x + i * stepX] = part->data[(size_t) j * columns + i];
+	}
+}
+
+/**
+ * \fn void computeComplexThreads(int count);
+ * \brief Fixe le nombre de threads des calculs parallèles
+ * 
+ * \param count Nombre de threads, 0 pour un par coeur
+ * \return Rien
+ */
+void computeComplexThreads(int count)
+{
+	if (count <= 0)
+		count = sysconf(_SC_NPROCESSORS_ONLN);
+	
+	threadCount = count > 1 ? count : 1;
+	if (threadCount > COMPUTE_THREADS_MAX)
+		threadCount = COMPUTE_THREADS_MAX;
+}
+
+/**
+ * \fn static void computeRowsParallel(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow);
+ * \brief Calcule une bande de lignes sur tous les coeurs
+ * 
+ * Les lignes sont réparties entre les threads (voir computeComplexThreads()),
+ * le thread appelant compris. Une bande plus courte que le nombre de
+ * threads n'en démarre pas plus que de lignes.
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur
+ * \param firstRow Première ligne à calculer
+ * \param lastRow Ligne suivant la dernière ligne à calculer
+ * \return Rien
+ */
+static void computeRowsParallel(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow)
+{
+	pthread_t threads[COMPUTE_THREADS_MAX];
+	computeTask tasks[COMPUTE_THREADS_MAX];
+	int count, started, i;
+	
+	if (threadCount == 0)
+		computeComplexThreads(0);
+	
+	count = lastRow - firstRow < threadCount ? lastRow - firstRow : threadCount;
+	if (count <= 0)
+		return;
+	
+	for (i = 0; i < count; i++)
+	{
+		tasks[i].fSet = fSet;
+		tasks[i].buffer = buffer;
+		tasks[i].firstRow = firstRow + i;
+		tasks[i].lastRow = lastRow;
+		tasks[i].step = count;
+	}
+	
+	/* La part 0 revient au thread appelant */
+	for (started = 1; started < count; started++)
+		if (pthread_create(&threads[started], NULL, computeWorker, &tasks[started]) != 0)
+			break;
+	
+	/* Ainsi que les parts dont le thread n'a pas pu être créé */
+	computeWorker(&tasks[0]);
+	for (i = started; i < count; i++)
+		computeWorker(&tasks[i]);
+	
+	for (i = 1; i < started; i++)
+		pthread_join(threads[i], NULL);
+}
+
+/**
+ * \fn void computeComplexParallel(fractalSettings fSet, iterationBuffer *buffer);
+ * \brief Calcule la fractale désignée par fSet.fractalId sur tous les coeurs
+ * 
+ * Même résultat que computeComplexFractal(). Les lignes sont réparties
+ * entre les threads (voir computeComplexThreads()), le thread
+ * appelant compris. Une fractale de Julia centrée sur l'origine n'est
+ * calculée qu'à moitié, le reste est recopié par symétrie.
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur
+ * \return Rien
+ */
+void computeComplexParallel(fractalSettings fSet, iterationBuffer *buffer)
+{
+	int width = fSet.screenWidth, height = fSet.screenHeight;
+	int lastRow = height, x, y;
+	unsigned short *src, *dest;
+	bool symmetric = computeComplexSymmetric(fSet);
+	
+	/* Symétrie : les lignes 0 à height / 2 suffisent */
+	if (symmetric)
+		lastRow = height / 2 + 1;
+	
+	computeRowsParallel(fSet, buffer, 0, lastRow);
+	
+	if (!symmetric)
+		return;
+	
+	/* Ligne y, colonne x : opposé de la ligne height - y, colonne width - x */
+	for (y = lastRow; y < height; y++)
+	{
+		src = buffer->data + (size_t) (height - y) * buffer->width;
+		dest = buffer->data + (size_t) y * buffer->width;
+		
+		for (x = 1; x < width; x++)
+			dest[x] = src[width - x];
+	}
+	
+	/* La colonne 0 n'a pas d'opposé dans la vue */
+	computeComplexGrid(fSet, buffer, 0, lastRow, 1, height - lastRow, 1, 1);
+}
+
+/**
+ * \fn void computeComplexRegionParallel(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int w, int h);
+ * \brief Calcule un rectangle de pixels sur tous les coeurs
+ * 
+ * Même résultat que computeComplexRegion(), les lignes du rectangle sont
+ * réparties entre les threads. À n'appeler que depuis un seul thread.
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur (taille de l'écran de fSet)
+ * \param x Colonne du coin haut gauche du rectangle
+ * \param y Ligne du coin haut gauche du rectangle
+ * \param w Largeur du rectangle
+ * \param h Hauteur du rectangle
+ * \return Rien
+ */
+void computeComplexRegionParallel(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int w, int h)
+{
+	if (w <= 0 || h <= 0)
+		return;
+	
+	/* Lignes entières : directement dans le tampon */
+	if (x == 0 && w == fSet.screenWidth)
+		computeRowsParallel(fSet, buffer, y, y + h);
+	else
+		computeComplexGridParallel(fSet, buffer, x, y, w, h, 1, 1);
+}
+
+/**
+ * \fn void computeComplexGridParallel(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int columns, int rows, int stepX, int stepY);
+ * \brief Calcule une grille de pixels espacés sur tous les coeurs
+ * 
+ * Même résultat que computeComplexGrid(), la petite fractale est calculée
+ * par computeComplexParallel(). À n'appeler que depuis un seul thread.
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur (taille de l'écran de fSet)
+ * \param x Colonne du premier pixel
+ * \param y Ligne du premier pixel
+ * \param columns Nombre de colonnes de la grille
+ * \param rows Nombre de lignes de la grille
+ * \param stepX Écart entre deux colonnes en pixels
+ * \param stepY Écart entre deux lignes en pixels
+ * \return Rien
+ */
+void computeComplexGridParallel(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int columns, int rows, int stepX, int stepY)
+{
+	iterationBuffer *part = NULL;
+	
+	if (columns <= 0 || rows <= 0)
+		return;
+	
+	/* Sans mémoire pour la petite fractale, la grille est calculée sur place */
+	part = iterationBufferCreate(columns, rows);
+	if (part == NULL)
+	{
+		computeComplexGrid(fSet, buffer, x, y, columns, rows, stepX, stepY);
+		return;
+	}
+	
+	computeComplexParallel(gridSettings(fSet, x, y, columns, rows, stepX, stepY), part);
+	gridCopy(buffer, part, x, y, stepX, stepY);
+	iterationBufferFree(part);
+}
+
+/**
+ * \fn void computeComplexRows(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow);
+ * \brief Calcule une bande de lignes de la fractale désignée par fSet.fractalId
+ * 
+ * Les lignes sont indépendantes : plusieurs bandes peuvent être calculées
+ * en même temps dans le même tampon.
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur
+ * \param firstRow Première ligne à calculer
+ * \param lastRow Ligne suivant la dernière ligne à calculer
+ * \return Rien
+ */
+void computeComplexRows(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow)
+{
+	switch(fSet.fractalId)
+	{
+		case COMPLEX_MANDELBROT:
+			computeMandelbrot(fSet, buffer, firstRow, lastRow);
+			break;
+			
+		case COMPLEX_BURNING_SHIP:
+			computeBurningShip(fSet, buffer, firstRow, lastRow);
+			break;
+		
+		case COMPLEX_JULIA:
+			computeJulia(fSet, fSet.cstJulia, buffer, firstRow, lastRow);
+			break;
+			
+		case COMPLEX_NEWTON:
+			computeNewton(fSet, fSet.newtonPower, buffer, firstRow, lastRow);
+			break;
+	}
+}
+
+/**
+ * \fn static unsigned short computeComplexIndex(fractalSettings fSet, complex *roots, int x, int y);
+ * \brief Indice de couleur d'un pixel de la fractale désignée par fSet.fractalId
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param roots Racines du polynome (fractale de Newton, voir newtonComputeRoots())
+ * \param x Colonne du pixel
+ * \param y Ligne du pixel
+ * \return L'indice du pixel, le même que celui des fonctions computeMandelbrot() ...
+ */
+static unsigned short computeComplexIndex(fractalSettings fSet, complex *roots, int x, int y)
+{
+	complex point = computeComplexPixel(fSet, x, y), z;
+	int iteration;
+	
+	switch(fSet.fractalId)
+	{
+		case COMPLEX_MANDELBROT:
+			return mandelbrotPoint(point, fSet.iterMax, &z);
+		
+		case COMPLEX_BURNING_SHIP:
+			return burningShipPoint(point, fSet.iterMax, &z);
+		
+		case COMPLEX_JULIA:
+			return juliaPoint(point, fSet.cstJulia, fSet.iterMax, &z);
+		
+		case COMPLEX_NEWTON:
+			iteration = newtonPoint(point, roots, fSet.newtonPower, fSet.iterMax, &z);
+			return newtonPaletteIndex(newtonFindRoot(roots, z, fSet.newtonPower), iteration, fSet.iterMax);
+	}
+	
+	return 0;
+}
+
+/**
+ * \fn void computeComplexBand(fractalSettings fSet, unsigned short *indices, int stride, int firstRow, int lastRow);
+ * \brief Calcule une bande de lignes dans un tableau qui ne contient qu'elle
+ * 
+ * Même résultat que computeComplexRows(), mais la ligne firstRow est
+ * écrite au début de \e indices : la bande n'a pas besoin d'un tampon de
+ * la taille de l'écran.
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param indices Indices de la bande, (lastRow - firstRow) * stride au moins
+ * \param stride Nombre d'indices entre deux lignes (fSet.screenWidth au moins)
+ * \param firstRow Première ligne à calculer
+ * \param lastRow Ligne suivant la dernière ligne à calculer
+ * \return Rien
+ */
+void computeComplexBand(fractalSettings fSet, unsigned short *indices, int stride, int firstRow, int lastRow)
+{
+	int power = fSet.fractalId == COMPLEX_NEWTON ? fSet.newtonPower : 1;
+	complex roots[power];
+	int x, y;
+	
+	if (fSet.fractalId == COMPLEX_NEWTON)
+		newtonComputeRoots(roots, power);
+	
+	for (y = firstRow; y < lastRow; y++)
+		for (x = 0; x < fSet.screenWidth; x++)
+			indices[(size_t) (y - firstRow) * stride + x] = computeComplexIndex(fSet, roots, x, y);
+}
+
+/**
+ * \fn void computeComplexRegion(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int w, int h);
+ * \brief Calcule un rectangle de pixels de la fractale désignée par fSet.fractalId
+ * 
+ * Le rectangle est calculé comme une petite fractale dont le repère est
+ * la partie correspondante de celui de \e fSet, puis copié dans le tampon.
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur (taille de l'écran de fSet)
+ * \param x Colonne du coin haut gauche du rectangle
+ * \param y Ligne du coin haut gauche du rectangle
+ * \param w Largeur du rectangle
+ * \param h Hauteur du rectangle
+ * \return Rien
+ */
+void computeComplexRegion(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int w, int h)
+{
+	if (w <= 0 || h <= 0)
+		return;
+	
+	/* Lignes entières : directement dans le tampon */
+	if (x == 0 && w == fSet.screenWidth)
+		computeComplexRows(fSet, buffer, y, y + h);
+	else
+		computeComplexGrid(fSet, buffer, x, y, w, h, 1, 1);
+}
+
+/**
+ * \fn void computeComplexGrid(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int columns, int rows, int stepX, int stepY);
+ * \brief Calcule une grille de pixels espacés de la fractale désignée par fSet.fractalId
+ * 
+ * Les pixels calculés sont (x + i * stepX, y + j * stepY), pour i < columns
+ * et j < rows. La grille est calculée comme une petite fractale, écrite
+ * directement à sa place dans le tampon.
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur (taille de l'écran de fSet)
+ * \param x Colonne du premier pixel
+ * \param y Ligne du premier pixel
+ * \param columns Nombre de colonnes de la grille
+ * \param rows Nombre de lignes de la grille
+ * \param stepX Écart entre deux colonnes en pixels
+ * \param stepY Écart entre deux lignes en pixels
+ * \return Rien
+ */
+void computeComplexGrid(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int columns, int rows, int stepX, int stepY)
+{
+	fractalSettings grid = gridSettings(fSet, x, y, columns, rows, stepX, stepY);
+	int power = fSet.fractalId == COMPLEX_NEWTON ? fSet.newtonPower : 1;
+	complex roots[power];
+	int i, j;
+	
+	if (columns <= 0 || rows <= 0)
+		return;
+	
+	if (fSet.fractalId == COMPLEX_NEWTON)
+		newtonComputeRoots(roots, power);
+	
+	for (j = 0; j < rows; j++)
+		for (i = 0; i < columns; i++)
+			buffer->data[(size_t) (y + j * stepY) * buffer->width + x + i * stepX] =
+				computeComplexIndex(grid, roots, i, j);
+}
+
+/**
+ * \fn complex computeComplexPixel(fractalSettings fSet, int x, int y);
+ * \brief Point du plan complexe correspondant à un pixel
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param x Colonne du pixel
+ * \param y Ligne du pixel (la ligne 0 est imagMin)
+ * \return Le point du pixel
+ */
+complex computeComplexPixel(fractalSettings fSet, int x, int y)
+{
+	complex point;
+	
+	point.real = ((double)(x)/(fSet.screenWidth))*(fSet.realMax-fSet.realMin)+fSet.realMin;
+	point.imag = ((double)(y)/(fSet.screenHeight))*(fSet.imagMax-fSet.imagMin)+fSet.imagMin;
+	
+	return point;
+}
+
+/**
+ * \fn int mandelbrotPoint(complex c, int iterMax, complex *last);
+ * \brief Itère la suite de Mandelbrot en un point
+ * 
+ * \param c Point du plan complexe
+ * \param iterMax Nombre d'itérations maximum
+ * \param last Reçoit le dernier terme de la suite
+ * \return Le nombre d'itérations avant divergence, iterMax si la suite ne diverge pas
+ */
+int mandelbrotPoint(complex c, int iterMax, complex *last)
+{
+	complex z = complexSet(0.0, 0.0);
+	int iteration = 0;
+	double temp;
+	
+	/* On itère la suite pour déterminer si elle converge */
+	while((iteration < iterMax) && (complexAbs(z) < 2))
+	{
+		temp = (z.real*z.real-z.imag*z.imag) + c.real;
+		z.imag=(2*z.real*z.imag) + c.imag;
+		z.real = temp;
+		iteration++;
+	}
+	
+	*last = z;
+	return iteration;
+}
+
+/**
+ * \fn int burningShipPoint(complex c, int iterMax, complex *last);
+ * \brief Itère la suite du "burning ship" en un point
+ * 
+ * \param c Point du plan complexe
+ * \param iterMax Nombre d'itérations maximum
+ * \param last Reçoit le dernier terme de la suite
+ * \return Le nombre d'itérations avant divergence, iterMax si la suite ne diverge pas
+ */
+int burningShipPoint(complex c, int iterMax, complex *last)
+{
+	complex z = complexSet(0.0, 0.0);
+	int iteration = 0;
+	
+	/*Tant que l'on atteint pas une valeur "infinie", on continue le calul de z*/
+	while( (iteration < iterMax) && ( complexAbs(z) < 2) )
+	{
+		/*valeur absolue de la somme du réel de z et de l'imaginaire de z, le tout au carré, plus la constante*/
+		z = complexSet(fabs(complexRe(z)), fabs(complexIm(z)));
+		z = complexAdd(complexMul(z,z), c);
+		
+		iteration++;
+	}
+	
+	*last = z;
+	return iteration;
+}
+
+/**
+ * \fn int juliaPoint(complex z, complex c, int iterMax, complex *last);
+ * \brief Itère la suite de Julia depuis un point
+ * 
+ * \param z Point du plan complexe, premier terme de la suite
+ * \param c Constante complexe
+ * \param iterMax Nombre d'itérations maximum
+ * \param last Reçoit le dernier terme de la suite
+ * \return Le nombre d'itérations avant divergence, iterMax si la suite ne diverge pas
+ */
+int juliaPoint(complex z, complex c, int iterMax, complex *last)
+{
+	int iteration = 0;
+	double temp;
+	
+	while((iteration < iterMax) && ((z.real*z.real+z.imag*z.imag) < 4))
+	{
+		temp = (z.real*z.real-z.imag*z.imag) + c.real;
+		z.imag=(2*z.real*z.imag) + c.imag;
+		z.real = temp;
+		iteration++;
+	}
+	
+	*last = z;
+	return iteration;
+}
+
+/**
+ * \fn int newtonPoint(complex z, complex *roots, int power, int iterMax, complex *last);
+ * \brief Itère la méthode de Newton depuis un point
+ * 
+ * \param z Point du plan complexe, premier terme de la suite
+ * \param roots Racines du polynome (voir newtonComputeRoots())
+ * \param power Degré du polynome
+ * \param iterMax Nombre d'itérations maximum
+ * \param last Reçoit le dernier terme de la suite
+ * \return Le nombre d'itérations avant d'atteindre une racine, iterMax si aucune n'est atteinte
+ */
+int newtonPoint(complex z, complex *roots, int power, int iterMax, complex *last)
+{
+	complex zn, zd;
+	int iteration = 0;
+	
+	/* On itère la suite */
+	while((iteration < iterMax) && newtonCheckRoots(roots, z, power))
+	{
+		if (complexAbs(z) > 0)
+		{
+			/* On calcule le numérateur */
+			zn = complexAdd(complexMul(complexSet(power-1,0),complexPow(z,power)),complexSet(1,0));
+			
+			/* On calcule le dénominateur */
+			zd = complexMul(complexSet(power,0),complexPow(z,power-1));
+			
+			/* On calcule le quotient des deux */
+			z = complexDiv(zn, zd);
+		}
+		iteration++;
+	}
+	
+	*last = z;
+	return iteration;
+}
+
+/**
+ * \fn void computeMandelbrot(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow);
+ * \brief Construit la fractale de Mandelbrot
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur
+ * \param firstRow Première ligne à calculer
+ * \param lastRow Ligne suivant la dernière ligne à calculer
+ * \return Rien
+ */
+void computeMandelbrot(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow)
+{
+	complex z;
+	int x, y;
+	
+	/* Pour chaque pixels de l'écran */
+	for (y = firstRow; y < lastRow; y++)
+		for (x = 0; x < fSet.screenWidth; x++)
+		{
+			/* On stocke le nombre d'itérations, la palette fera la coloration */
+			buffer->data[(size_t) y * buffer->width + x] =
+				mandelbrotPoint(computeComplexPixel(fSet, x, y), fSet.iterMax, &z);
+		}
+}
+
+/**
+ * \fn void computeBurningShip(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow);
+ * \brief Construit la fractale du "burning ship"
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur
+ * \param firstRow Première ligne à calculer
+ * \param lastRow Ligne suivant la dernière ligne à calculer
+ * \return Rien
+ */
+void computeBurningShip(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow)
+{
+	complex z;
+	int x, y;
+	
+	/*On parcourt tous les pixels de la fenêtre pour vérifier si la fonction en ce pixel converge ou diverge*/
+	for (y = firstRow; y < lastRow; y++)
+		for (x = 0; x < fSet.screenWidth; x++)
+			buffer->data[(size_t) y * buffer->width + x] =
+				burningShipPoint(computeComplexPixel(fSet, x, y), fSet.iterMax, &z);
+}
+
+/**
+ * \fn void computeJulia(fractalSettings fSet, complex c, iterationBuffer *buffer, int firstRow, int lastRow);
+ * \brief Construit la fractale de Julia
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param c Constante complexe
+ * \param buffer Tampon recevant les indices de couleur
+ * \param firstRow Première ligne à calculer
+ * \param lastRow Ligne suivant la dernière ligne à calculer
+ * \return Rien
+ */
+void computeJulia(fractalSettings fSet, complex c, iterationBuffer *buffer, int firstRow, int lastRow)
+{
+	complex z;
+	int x, y;
+	
+	/* Pour chaque pixels de l'écran, il faut juste inverser c et z0 */
+	for (y = firstRow; y < lastRow; y++)
+		for (x = 0; x < fSet.screenWidth; x++)
+			buffer->data[(size_t) y * buffer->width + x] =
+				juliaPoint(computeComplexPixel(fSet, x, y), c, fSet.iterMax, &z);
+}
+
+/**
+ * \fn void computeNewton(fractalSettings fSet, int power, iterationBuffer *buffer, int firstRow, int lastRow);
+ * \brief Construit la fractale de Newton
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param power Degré du polynome
+ * \param buffer Tampon recevant les indices de couleur
+ * \param firstRow Première ligne à calculer
+ * \param lastRow Ligne suivant la dernière ligne à calculer
+ * \return Rien
+ */
+void computeNewton(fractalSettings fSet, int power, iterationBuffer *buffer, int firstRow, int lastRow)
+{
+	complex z;
+	int x, y, iteration;
+	complex r[power];
+	
+	/* On calcule les racines complexes du polynome, que l'on stocke dans le tableau r */
+	newtonComputeRoots(r, power);
+	
+	/* Pour chaque pixel de l'écran */
+	for (y = firstRow; y < lastRow; y++)
+		for (x = 0; x < fSet.screenWidth; x++)
+		{
+			iteration = newtonPoint(computeComplexPixel(fSet, x, y), r, power, fSet.iterMax, &z);
+			
+			/* La racine atteinte et le nombre d'itérations donnent la couleur (newton.c) */
+			buffer->data[(size_t) y * buffer->width + x] =
+				newtonPaletteIndex(newtonFindRoot(r, z, power), iteration, fSet.iterMax);
+		}
+}
@@ -0,0 +1,131 @@
+/**
+ * \file complexFractals.h
+ * \brief Fichier d'entête, contient toutes les fractales de type complexe
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 2.0
+ * \date 02/02/2012
+ * 
+ * Dessine les fractales complexes dans le plan Complexe, ou la partie
+ * réelle est sur l'axe des abscisses et la partie imaginaire est sur
+ * l'axe des ordonnées.
+ * 
+ */
+
+#ifndef H_COMPLEX_FRACTALS
+#define H_COMPLEX_FRACTALS
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "complex.h"
+#include "newton.h"
+
+/* Macros */
+
+/**
+ * \def COMPLEX_MANDELBROT
+ * \brief Identifiant de la fractale de mandelbrot
+ */
+#define COMPLEX_MANDELBROT 1
+
+/**
+ * \def COMPLEX_BURNING_SHIP
+ * \brief Identifiant de la fractale du "burning ship"
+ */
+#define COMPLEX_BURNING_SHIP 2
+
+/**
+ * \def COMPLEX_JULIA
+ * \brief Identifiant de la fractale de Julia
+ */
+#define COMPLEX_JULIA 3
+
+/**
+ * \def COMPLEX_NEWTON
+ * \brief Identifiant de la fractale de Newton
+ */
+#define COMPLEX_NEWTON 4
+
+/**
+ * \def COMPUTE_THREADS_MAX
+ * \brief Nombre maximum de threads pour un calcul au premier plan
+ */
+#define COMPUTE_THREADS_MAX 16
+
+/* Structures */
+
+/**
+ * \struct fractalSettings
+ * \brief Stocke les paramètres généraux de la fractale
+ * 
+ * La structure \e screenInfos permet de stocker les paramètres tel que, les
+ * coordonnées de la fractale dans le repère complexe, le nombre d'itérations
+ * par pixels ...
+ * 
+*/
+typedef struct
+{
+	double	realMax;	/*!< Largeur de l'écran */
+	double	realMin;	/*!< Hauteur de l'écran */
+	double	imagMax;	/*!< Nombre de bits par pixels */
+	double	imagMin;	/*!< Nombre de bits par pixels */
+	
+	int	screenWidth;	/*!< Largeur de l'écran */
+	int	screenHeight;	/*!< Hauteur de l'écran */
+	
+	int	iterMax;	/*!< Nombre d'itérations */
+	
+	int	fractalId;	/*!< Identifiant de la fractale à calculer */
+	complex	cstJulia;	/*!< Constante complexe (fractale de Julia) */
+	int	newtonPower;	/*!< Degré du polynome (fractale de Newton) */
+} fractalSettings;
+
+/**
+ * \struct iterationBuffer
+ * \brief Stocke le résultat du calcul d'une fractale complexe
+ * 
+ * Chaque pixel est représenté par un indice de couleur sur 16 bits
+ * (le nombre d'itérations, ou la racine et le nombre d'itérations pour
+ * Newton), qu'une \e palette transforme en couleur à l'affichage.
+ * La ligne 0 correspond à \e imagMin, soit le haut de l'écran.
+ * 
+*/
+typedef struct
+{
+	int		width;		/*!< Largeur du tampon en pixels */
+	int		height;		/*!< Hauteur du tampon en pixels */
+	unsigned short	*data;		/*!< Indices de couleur, ligne par ligne */
+} iterationBuffer;
+
+/* Prototypes */
+
+iterationBuffer* iterationBufferCreate(int width, int height);
+void iterationBufferFree(iterationBuffer *buffer);
+
+void computeComplexFractal(fractalSettings fSet, iterationBuffer *buffer);
+void computeComplexThreads(int count);
+void computeComplexParallel(fractalSettings fSet, iterationBuffer *buffer);
+bool computeComplexSymmetric(fractalSettings fSet);
+void computeComplexRows(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow);
+void computeComplexBand(fractalSettings fSet, unsigned short *indices, int stride, int firstRow, int lastRow);
+void computeComplexRegion(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int w, int h);
+void computeComplexGrid(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int columns, int rows, int stepX, int stepY);
+void computeComplexRegionParallel(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int w, int h);
+void computeComplexGridParallel(fractalSettings fSet, iterationBuffer *buffer, int x, int y, int columns, int rows, int stepX, int stepY);
+complex computeComplexPixel(fractalSettings fSet, int x, int y);
+int mandelbrotPoint(complex c, int iterMax, complex *last);
+int burningShipPoint(complex c, int iterMax, complex *last);
+int juliaPoint(complex z, complex c, int iterMax, complex *last);
+int newtonPoint(complex z, complex *roots, int power, int iterMax, complex *last);
+void computeMandelbrot(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow);
+void computeBurningShip(fractalSettings fSet, iterationBuffer *buffer, int firstRow, int lastRow);
+void computeJulia(fractalSettings fSet, complex c, iterationBuffer *buffer, int firstRow, int lastRow);
+void computeNewton(fractalSettings fSet, int power, iterationBuffer *buffer, int firstRow, int lastRow);
+
+
+#endif /* H_COMPLEX_FRACTALS */
@@ -0,0 +1,530 @@
+/**
+ * \file iterationField.c
+ * \brief Fichier source, valeurs brutes des fractales complexes dans un fichier projetable en mémoire
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les suites sont celles de complexFractals.c, aux mêmes conditions
+ * d'arrêt : le plan FIELD_ITERATIONS est égal aux indices d'une image
+ * (hors fractale de Newton, dont l'indice mêle racine et itérations).
+ * 
+ */
+
+#include "iterationField.h"
+
+#include <math.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * \fn static uint64_t fieldAlign(uint64_t offset);
+ * \brief Arrondit une position du fichier au multiple de FIELD_ALIGN suivant
+ * 
+ * \param offset Position dans le fichier
+ * \return La position alignée
+ */
+static uint64_t fieldAlign(uint64_t offset)
+{
+	return (offset + FIELD_ALIGN - 1) / FIELD_ALIGN * FIELD_ALIGN;
+}
+
+/**
+ * \fn fieldHeader fieldHeaderCreate(fractalSettings fSet);
+ * \brief En-tête et disposition des plans du champ d'une fractale
+ * 
+ * \param fSet Paramètres de la fractale
+ * \return L'en-tête, complete à 0
+ */
+fieldHeader fieldHeaderCreate(fractalSettings fSet)
+{
+	fieldHeader header;
+	uint64_t planeSize = (uint64_t) fSet.screenWidth * fSet.screenHeight * 4;
+	int plane;
+	
+	memset(&header, 0, sizeof(fieldHeader));
+	memcpy(header.magic, FIELD_MAGIC, sizeof(FIELD_MAGIC));
+	header.version = FIELD_VERSION;
+	header.byteOrder = FIELD_BYTE_ORDER;
+	header.headerSize = sizeof(fieldHeader);
+	header.width = fSet.screenWidth;
+	header.height = fSet.screenHeight;
+	header.fractalId = fSet.fractalId;
+	header.iterMax = fSet.iterMax;
+	header.newtonPower = fSet.newtonPower;
+	header.planes = FIELD_PLANES;
+	header.realMin = fSet.realMin;
+	header.realMax = fSet.realMax;
+	header.imagMin = fSet.imagMin;
+	header.imagMax = fSet.imagMax;
+	header.juliaReal = fSet.cstJulia.real;
+	header.juliaImag = fSet.cstJulia.imag;
+	
+	header.offset[0] = fieldAlign(sizeof(fieldHeader));
+	for (plane = 1; plane < FIELD_PLANES; plane++)
+		header.offset[plane] = fieldAlign(header.offset[plane - 1] + planeSize);
+	header.fileSize = header.offset[FIELD_PLANES - 1] + planeSize;
+	
+	return header;
+}
+
+/**
+ * \fn fieldTile* fieldTileCreate(int width, int height);
+ * \brief Alloue les plans d'une tuile
+ * 
+ * \param width Largeur de la tuile en pixels
+ * \param height Hauteur de la tuile en pixels
+ * \return Un pointeur vers la tuile allouée, NULL si la mémoire manque
+ */
+fieldTile* fieldTileCreate(int width, int height)
+{
+	fieldTile *tile = (fieldTile*) malloc(sizeof(fieldTile));
+	size_t count = (size_t) width * height;
+	
+	if (tile != NULL)
+	{
+		tile->width = width;
+		tile->height = height;
+		tile->iterations = (uint32_t*) malloc(count * sizeof(uint32_t));
+		tile->modulus = (float*) malloc(count * sizeof(float));
+		tile->smooth = (float*) malloc(count * sizeof(float));
+		tile->root = (int32_t*) malloc(count * sizeof(int32_t));
+	}
+	
+	if (tile == NULL || tile->iterations == NULL || tile->modulus == NULL
+		|| tile->smooth == NULL || tile->root == NULL)
+	{
+		fieldTileFree(tile);
+		return NULL;
+	}
+	
+	return tile;
+}
+
+/**
+ * \fn void fieldTileFree(fieldTile *tile);
+ * \brief Libère une tuile
+ * 
+ * \param tile Pointeur vers la tuile
+ * \return Rien
+ */
+void fieldTileFree(fieldTile *tile)
+{
+	if (tile != NULL)
+	{
+		free(tile->iterations);
+		free(tile->modulus);
+		free(tile->smooth);
+		free(tile->root);
+		free(tile);
+	}
+}
+
+/**
+ * \fn static void fieldEscape(fieldTile *tile, int i, int iteration, complex z, int iterMax);
+ * \brief Range les valeurs d'un point d'une fractale à divergence
+ * 
+ * Le lissage retire à \e iteration la part de la dernière itération
+ * dépassée par le module de z : n + 1 - log2(ln |z|).
+ * 
+ * \param tile Tuile recevant les valeurs
+ * \param i Indice du point dans la tuile
+ * \param iteration Nombre d'itérations
+ * \param z Dernier terme de la suite
+ * \param iterMax Nombre d'itérations maximum
+ * \return Rien
+ */
+static void fieldEscape(fieldTile *tile, int i, int iteration, complex z, int iterMax)
+{
+	double modulus = complexAbs(z);
+	
+	tile->iterations[i] = iteration;
+	tile->modulus[i] = modulus;
+	tile->smooth[i] = iteration < iterMax ? iteration + 1 - log2(log(modulus)) : iterMax;
+	tile->root[i] = -1;
+}
+
+/**
+ * \fn static void fieldNewton(fieldTile *tile, int i, int iteration, complex z, complex *roots, int power, int iterMax);
+ * \brief Range les valeurs d'un point de la fractale de Newton
+ * 
+ * La convergence est quadratique : la distance à la racine est à peu près
+ * élevée au carré à chaque itération. Le lissage retire à \e iteration la
+ * part de la dernière itération passée sous FRACTAL_NEWTON_PRECISION.
+ * 
+ * \param tile Tuile recevant les valeurs
+ * \param i Indice du point dans la tuile
+ * \param iteration Nombre d'itérations
+ * \param z Dernier terme de la suite
+ * \param roots Racines du polynome
+ * \param power Degré du polynome
+ * \param iterMax Nombre d'itérations maximum
+ * \return Rien
+ */
+static void fieldNewton(fieldTile *tile, int i, int iteration, complex z, complex *roots, int power, int iterMax)
+{
+	int root = newtonFindRoot(roots, z, power);
+	double distance;
+	
+	tile->iterations[i] = iteration;
+	tile->modulus[i] = complexAbs(z);
+	tile->root[i] = root;
+	tile->smooth[i] = iterMax;
+	
+	if (root >= 0)
+	{
+		distance = complexAbs(complexDif(z, roots[root]));
+		tile->smooth[i] = distance > 0 ?
+			iteration - log2(log(distance) / log(FRACTAL_NEWTON_PRECISION)) : iteration;
+	}
+}
+
+/**
+ * \fn void fieldComputeTile(fractalSettings fSet, fieldTile *tile, int x, int y);
+ * \brief Calcule les valeurs brutes d'un rectangle de pixels de la fractale désignée par fSet.fractalId
+ * 
+ * Les points sont ceux de l'image entière, itérés par les mêmes fonctions
+ * que complexFractals.c : une tuile donne les mêmes valeurs que l'image.
+ * 
+ * \param fSet Paramètres de l'image entière
+ * \param tile Tuile recevant les valeurs (sa taille donne celle du rectangle)
+ * \param x Colonne du coin haut gauche du rectangle
+ * \param y Ligne du coin haut gauche du rectangle
+ * \return Rien
+ */
+void fieldComputeTile(fractalSettings fSet, fieldTile *tile, int x, int y)
+{
+	int power = fSet.fractalId == COMPLEX_NEWTON ? fSet.newtonPower : 1;
+	complex z, point, roots[power];
+	int i, j, index, iteration;
+	
+	if (fSet.fractalId == COMPLEX_NEWTON)
+		newtonComputeRoots(roots, power);
+	
+	for (j = 0; j < tile->height; j++)
+	{
+		for (i = 0; i < tile->width; i++)
+		{
+			point = computeComplexPixel(fSet, x + i, y + j);
+			index = j * tile->width + i;
+			
+			switch (fSet.fractalId)
+			{
+				case COMPLEX_MANDELBROT:
+					iteration = mandelbrotPoint(point, fSet.iterMax, &z);
+					fieldEscape(tile, index, iteration, z, fSet.iterMax);
+					break;
+				
+				case COMPLEX_BURNING_SHIP:
+					iteration = burningShipPoint(point, fSet.iterMax, &z);
+					fieldEscape(tile, index, iteration, z, fSet.iterMax);
+					break;
+				
+				case COMPLEX_JULIA:
+					iteration = juliaPoint(point, fSet.cstJulia, fSet.iterMax, &z);
+					fieldEscape(tile, index, iteration, z, fSet.iterMax);
+					break;
+				
+				case COMPLEX_NEWTON:
+					iteration = newtonPoint(point, roots, power, fSet.iterMax, &z);
+					fieldNewton(tile, index, iteration, z, roots, power, fSet.iterMax);
+					break;
+			}
+		}
+	}
+}
+
+/**
+ * \fn static bool fieldWriteAt(int fd, const void *data, size_t size, uint64_t offset);
+ * \brief Écrit un bloc à une position du fichier, sans déplacer sa position courante
+ * 
+ * \param fd Fichier de destination
+ * \param data Octets à écrire
+ * \param size Nombre d'octets
+ * \param offset Position dans le fichier
+ * \return Vrai si tout est écrit
+ */
+static bool fieldWriteAt(int fd, const void *data, size_t size, uint64_t offset)
+{
+	const unsigned char *bytes = (const unsigned char*) data;
+	ssize_t written;
+	
+	while (size > 0)
+	{
+		written = pwrite(fd, bytes, size, offset);
+		if (written <= 0)
+			return false;
+		
+		bytes += written;
+		size -= written;
+		offset += written;
+	}
+	
+	return true;
+}
+
+/**
+ * \fn static bool fieldStoreTile(fieldWriter *w, const fieldTile *tile, int x, int y);
+ * \brief Écrit chaque ligne de chaque plan d'une tuile à sa place dans le fichier
+ * 
+ * \param w Pointeur vers l'écriture en cours
+ * \param tile Tuile calculée
+ * \param x Colonne du coin haut gauche de la tuile
+ * \param y Ligne du coin haut gauche de la tuile
+ * \return Vrai si la tuile est écrite
+ */
+static bool fieldStoreTile(fieldWriter *w, const fieldTile *tile, int x, int y)
+{
+	const void *planes[FIELD_PLANES];
+	size_t rowBytes = (size_t) tile->width * 4;
+	uint64_t offset;
+	int plane, j;
+	
+	planes[FIELD_ITERATIONS] = tile->iterations;
+	planes[FIELD_MODULUS] = tile->modulus;
+	planes[FIELD_SMOOTH] = tile->smooth;
+	planes[FIELD_ROOT] = tile->root;
+	
+	for (plane = 0; plane < FIELD_PLANES; plane++)
+		for (j = 0; j < tile->height; j++)
+		{
+			offset = w->header.offset[plane] + ((uint64_t) (y + j) * w->fSet.screenWidth + x) * 4;
+			if (!fieldWriteAt(w->fd, (const unsigned char*) planes[plane] + j * rowBytes, rowBytes, offset))
+				return false;
+		}
+	
+	return true;
+}
+
+/**
+ * \fn static void* fieldWorker(void *arg);
+ * \brief Calcule et écrit des tuiles jusqu'à la dernière
+ * 
+ * \param arg Pointeur vers l'écriture en cours (fieldWriter)
+ * \return NULL
+ */
+static void* fieldWorker(void *arg)
+{
+	fieldWriter *w = (fieldWriter*) arg;
+	fieldTile *tile = fieldTileCreate(w->tileSize, w->tileSize);
+	int index, x, y;
+	bool stored;
+	
+	/* Sans mémoire, l'écriture échoue : les autres threads s'arrêtent aussi */
+	if (tile == NULL)
+	{
+		pthread_mutex_lock(&w->lock);
+		w->error = true;
+		pthread_mutex_unlock(&w->lock);
+		return NULL;
+	}
+	
+	for (;;)
+	{
+		pthread_mutex_lock(&w->lock);
+		index = w->error ? w->tiles : w->next++;
+		pthread_mutex_unlock(&w->lock);
+		
+		if (index >= w->tiles)
+			break;
+		
+		/* Les tuiles du bord droit et du bas sont plus petites */
+		x = index % w->tilesX * w->tileSize;
+		y = index / w->tilesX * w->tileSize;
+		tile->width = w->fSet.screenWidth - x < w->tileSize ? w->fSet.screenWidth - x : w->tileSize;
+		tile->height = w->fSet.screenHeight - y < w->tileSize ? w->fSet.screenHeight - y : w->tileSize;
+		
+		fieldComputeTile(w->fSet, tile, x, y);
+		stored = fieldStoreTile(w, tile, x, y);
+		
+		if (!stored)
+		{
+			pthread_mutex_lock(&w->lock);
+			w->error = true;
+			pthread_mutex_unlock(&w->lock);
+		}
+	}
+	
+	fieldTileFree(tile);
+	
+	return NULL;
+}
+
+/**
+ * \fn bool fieldWrite(const char *path, fractalSettings fSet, int tileSize, int threads);
+ * \brief Calcule le champ d'une fractale et l'écrit dans un fichier, tuile par tuile
+ * 
+ * Le fichier est d'abord créé à sa taille finale, puis chaque thread
+ * écrit ses tuiles à leur place. L'en-tête est écrit deux fois : au début,
+ * puis avec complete à 1 une fois toutes les tuiles écrites.
+ * 
+ * \param path Fichier écrit
+ * \param fSet Paramètres de la fractale
+ * \param tileSize Côté des tuiles en pixels
+ * \param threads Nombre de threads, thread appelant compris, 0 pour un par coeur
+ * \return Vrai si le fichier est entièrement écrit
+ */
+bool fieldWrite(const char *path, fractalSettings fSet, int tileSize, int threads)
+{
+	pthread_t workers[COMPUTE_THREADS_MAX];
+	fieldWriter w;
+	int started, i;
+	bool success;
+	
+	if (threads <= 0)
+		threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (threads < 1)
+		threads = 1;
+	if (threads > COMPUTE_THREADS_MAX)
+		threads = COMPUTE_THREADS_MAX;
+	
+	memset(&w, 0, sizeof(fieldWriter));
+	w.header = fieldHeaderCreate(fSet);
+	w.fSet = fSet;
+	w.tileSize = tileSize;
+	w.tilesX = (fSet.screenWidth + tileSize - 1) / tileSize;
+	w.tiles = w.tilesX * ((fSet.screenHeight + tileSize - 1) / tileSize);
+	
+	w.fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (w.fd < 0)
+		return false;
+	
+	/* Fichier creux à sa taille finale : les tuiles non écrites valent 0 */
+	if (ftruncate(w.fd, w.header.fileSize) != 0
+		|| !fieldWriteAt(w.fd, &w.header, sizeof(fieldHeader), 0))
+	{
+		close(w.fd);
+		return false;
+	}
+	
+	pthread_mutex_init(&w.lock, NULL);
+	
+	for (started = 0; started < threads - 1; started++)
+		if (pthread_create(&workers[started], NULL, fieldWorker, &w) != 0)
+			break;
+	
+	fieldWorker(&w);
+	
+	for (i = 0; i < started; i++)
+		pthread_join(workers[i], NULL);
+	
+	pthread_mutex_destroy(&w.lock);
+	
+	w.header.complete = 1;
+	success = !w.error && fieldWriteAt(w.fd, &w.header, sizeof(fieldHeader), 0);
+	
+	if (close(w.fd) != 0)
+		success = false;
+	
+	return success;
+}
+
+/**
+ * \fn fieldFile* fieldOpen(const char *path);
+ * \brief Projette un champ en mémoire et vérifie son en-tête
+ * 
+ * Les plans sont lus directement dans la projection, par exemple
+ * field->smooth[y * field->header->width + x].
+ * 
+ * \param path Fichier du champ
+ * \return Le champ, à fermer par fieldClose(), NULL si le fichier n'est pas un champ complet (message sur stderr)
+ */
+fieldFile* fieldOpen(const char *path)
+{
+	fieldFile *field = NULL;
+	const fieldHeader *header;
+	struct stat info;
+	void *data;
+	int fd;
+	
+	fd = open(path, O_RDONLY);
+	if (fd < 0 || fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(fieldHeader))
+	{
+		fprintf(stderr, "%s : impossible de lire le champ\n", path);
+		if (fd >= 0)
+			close(fd);
+		return NULL;
+	}
+	
+	data = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	
+	if (data == MAP_FAILED)
+	{
+		fprintf(stderr, "%s : impossible de projeter le champ en mémoire\n", path);
+		return NULL;
+	}
+	
+	header = (const fieldHeader*) data;
+	
+	if (memcmp(header->magic, FIELD_MAGIC, sizeof(FIELD_MAGIC)) != 0 || header->version != FIELD_VERSION
+		|| header->byteOrder != FIELD_BYTE_ORDER || header->headerSize != sizeof(fieldHeader)
+		|| header->planes != FIELD_PLANES || header->fileSize != (uint64_t) info.st_size
+		|| header->offset[FIELD_PLANES - 1] + (uint64_t) header->width * header->height * 4 > header->fileSize)
+		fprintf(stderr, "%s : ce n'est pas un champ d'itérations (version %d, ordre des octets de la machine)\n",
+			path, FIELD_VERSION);
+	else if (!header->complete)
+		fprintf(stderr, "%s : champ incomplet, son écriture a été interrompue\n", path);
+	else
+		field = (fieldFile*) malloc(sizeof(fieldFile));
+	
+	if (field == NULL)
+	{
+		munmap(data, info.st_size);
+		return NULL;
+	}
+	
+	field->header = header;
+	field->iterations = (const uint32_t*) ((const char*) data + header->offset[FIELD_ITERATIONS]);
+	field->modulus = (const float*) ((const char*) data + header->offset[FIELD_MODULUS]);
+	field->smooth = (const float*) ((const char*) data + header->offset[FIELD_SMOOTH]);
+	field->root = (const int32_t*) ((const char*) data + header->offset[FIELD_ROOT]);
+	field->size = info.st_size;
+	
+	return field;
+}
+
+/**
+ * \fn fractalSettings fieldSettings(const fieldFile *field);
+ * \brief Paramètres de la fractale d'un champ, pour la recalculer ou la colorer
+ * 
+ * \param field Champ ouvert
+ * \return Les paramètres de la fractale
+ */
+fractalSettings fieldSettings(const fieldFile *field)
+{
+	fractalSettings fSet;
+	
+	memset(&fSet, 0, sizeof(fractalSettings));
+	fSet.realMin = field->header->realMin;
+	fSet.realMax = field->header->realMax;
+	fSet.imagMin = field->header->imagMin;
+	fSet.imagMax = field->header->imagMax;
+	fSet.screenWidth = field->header->width;
+	fSet.screenHeight = field->header->height;
+	fSet.iterMax = field->header->iterMax;
+	fSet.fractalId = field->header->fractalId;
+	fSet.cstJulia = complexSet(field->header->juliaReal, field->header->juliaImag);
+	fSet.newtonPower = field->header->newtonPower;
+	
+	return fSet;
+}
+
+/**
+ * \fn void fieldClose(fieldFile *field);
+ * \brief Libère la projection d'un champ
+ * 
+ * \param field Champ ouvert
+ * \return Rien
+ */
+void fieldClose(fieldFile *field)
+{
+	if (field != NULL)
+	{
+		munmap((void*) field->header, field->size);
+		free(field);
+	}
+}
@@ -0,0 +1,185 @@
+/**
+ * \file iterationField.h
+ * \brief Fichier d'entête, valeurs brutes des fractales complexes dans un fichier projetable en mémoire
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Un champ d'itérations garde, pour chaque pixel, ce que la palette
+ * résume en un indice de couleur : le nombre d'itérations, le module
+ * final de z, le nombre d'itérations lissé et la racine atteinte
+ * (fractale de Newton).
+ * 
+ * Le fichier commence par un fieldHeader (repère, itérations, paramètres
+ * de la fractale), suivi d'un plan par valeur (FIELD_PLANES plans).
+ * Chaque plan est un tableau de width * height valeurs de 4 octets, ligne
+ * par ligne (la ligne 0 est imagMin), qui commence à un multiple de
+ * FIELD_ALIGN. Tout est dans l'ordre des octets de la machine, vérifié
+ * par byteOrder : après mmap(), header->offset[plane] donne directement
+ * le tableau, sans rien décoder (voir fieldOpen()).
+ * 
+ * L'écriture se fait par tuiles carrées, calculées en parallèle et
+ * écrites à leur place dans le fichier : le champ entier n'est jamais en
+ * mémoire.
+ * 
+ */
+
+#ifndef H_ITERATION_FIELD
+#define H_ITERATION_FIELD
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include "complexFractals.h"
+
+/* Macros */
+
+/**
+ * \def FIELD_MAGIC
+ * \brief Signature au début du fichier (8 octets, zéro final compris)
+ */
+#define FIELD_MAGIC "LiFEfld"
+
+/**
+ * \def FIELD_VERSION
+ * \brief Version du format, à changer si fieldHeader change
+ */
+#define FIELD_VERSION 1
+
+/**
+ * \def FIELD_BYTE_ORDER
+ * \brief Valeur de byteOrder, lue autrement si l'ordre des octets diffère
+ */
+#define FIELD_BYTE_ORDER 0x01020304
+
+/**
+ * \def FIELD_ALIGN
+ * \brief Alignement du début de chaque plan, en octets (une page)
+ */
+#define FIELD_ALIGN 4096
+
+/**
+ * \def FIELD_ITERATIONS
+ * \brief Plan du nombre d'itérations (uint32_t, iterMax si la suite ne diverge pas)
+ */
+#define FIELD_ITERATIONS 0
+
+/**
+ * \def FIELD_MODULUS
+ * \brief Plan du module de z après la dernière itération (float)
+ */
+#define FIELD_MODULUS 1
+
+/**
+ * \def FIELD_SMOOTH
+ * \brief Plan du nombre d'itérations lissé (float, iterMax sans divergence ni racine)
+ */
+#define FIELD_SMOOTH 2
+
+/**
+ * \def FIELD_ROOT
+ * \brief Plan de la racine atteinte (int32_t, -1 si aucune ou hors fractale de Newton)
+ */
+#define FIELD_ROOT 3
+
+/**
+ * \def FIELD_PLANES
+ * \brief Nombre de plans du fichier
+ */
+#define FIELD_PLANES 4
+
+/* Structures */
+
+/**
+ * \struct fieldHeader
+ * \brief En-tête du fichier, tel qu'il est sur le disque
+ * 
+ * Tous les champs sont alignés sur leur taille : la structure n'a pas de
+ * trou et se lit directement depuis le fichier projeté.
+ * 
+*/
+typedef struct
+{
+	char		magic[8];		/*!< FIELD_MAGIC */
+	uint32_t	version;		/*!< FIELD_VERSION */
+	uint32_t	byteOrder;		/*!< FIELD_BYTE_ORDER */
+	uint32_t	headerSize;		/*!< sizeof(fieldHeader) */
+	uint32_t	complete;		/*!< 1 quand toutes les tuiles sont écrites */
+	uint32_t	width;			/*!< Largeur du champ en pixels */
+	uint32_t	height;			/*!< Hauteur du champ en pixels */
+	int32_t		fractalId;		/*!< Identifiant de la fractale (COMPLEX_...) */
+	int32_t		iterMax;		/*!< Nombre d'itérations maximum */
+	int32_t		newtonPower;		/*!< Degré du polynome (fractale de Newton) */
+	uint32_t	planes;			/*!< FIELD_PLANES */
+	double		realMin;		/*!< Partie réelle de la colonne 0 */
+	double		realMax;		/*!< Partie réelle après la dernière colonne */
+	double		imagMin;		/*!< Partie imaginaire de la ligne 0 */
+	double		imagMax;		/*!< Partie imaginaire après la dernière ligne */
+	double		juliaReal;		/*!< Partie réelle de la constante (fractale de Julia) */
+	double		juliaImag;		/*!< Partie imaginaire de la constante (fractale de Julia) */
+	uint64_t	offset[FIELD_PLANES];	/*!< Début de chaque plan dans le fichier */
+	uint64_t	fileSize;		/*!< Taille du fichier */
+} fieldHeader;
+
+/**
+ * \struct fieldTile
+ * \brief Valeurs brutes d'un rectangle de pixels, un tableau par plan
+ * 
+*/
+typedef struct
+{
+	int		width;		/*!< Largeur de la tuile en pixels */
+	int		height;		/*!< Hauteur de la tuile en pixels */
+	uint32_t	*iterations;	/*!< Plan FIELD_ITERATIONS */
+	float		*modulus;	/*!< Plan FIELD_MODULUS */
+	float		*smooth;	/*!< Plan FIELD_SMOOTH */
+	int32_t		*root;		/*!< Plan FIELD_ROOT */
+} fieldTile;
+
+/**
+ * \struct fieldWriter
+ * \brief Écriture en cours d'un champ, partagée entre les threads
+ * 
+*/
+typedef struct
+{
+	int		fd;		/*!< Fichier de destination */
+	fieldHeader	header;		/*!< En-tête écrit au début du fichier */
+	fractalSettings	fSet;		/*!< Paramètres du champ entier */
+	int		tileSize;	/*!< Côté des tuiles en pixels */
+	int		tilesX;		/*!< Nombre de tuiles par ligne */
+	int		tiles;		/*!< Nombre de tuiles */
+	int		next;		/*!< Prochaine tuile à calculer */
+	bool		error;		/*!< Vrai si une écriture a échoué */
+	pthread_mutex_t	lock;		/*!< Protège next et error */
+} fieldWriter;
+
+/**
+ * \struct fieldFile
+ * \brief Champ ouvert en lecture, projeté en mémoire
+ * 
+*/
+typedef struct
+{
+	const fieldHeader	*header;	/*!< En-tête, au début de la projection */
+	const uint32_t		*iterations;	/*!< Plan FIELD_ITERATIONS */
+	const float		*modulus;	/*!< Plan FIELD_MODULUS */
+	const float		*smooth;	/*!< Plan FIELD_SMOOTH */
+	const int32_t		*root;		/*!< Plan FIELD_ROOT */
+	size_t			size;		/*!< Taille de la projection */
+} fieldFile;
+
+/* Prototypes */
+
+fieldHeader fieldHeaderCreate(fractalSettings fSet);
+fieldTile* fieldTileCreate(int width, int height);
+void fieldTileFree(fieldTile *tile);
+void fieldComputeTile(fractalSettings fSet, fieldTile *tile, int x, int y);
+bool fieldWrite(const char *path, fractalSettings fSet, int tileSize, int threads);
+fieldFile* fieldOpen(const char *path);
+fractalSettings fieldSettings(const fieldFile *field);
+void fieldClose(fieldFile *field);
+
+#endif /* H_ITERATION_FIELD */
@@ -0,0 +1,413 @@
+/**
+ * \file life.c
+ * \brief Fichier source, interface de la bibliothèque de calcul liblife
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les threads attendent des bandes de LIFE_BAND_ROWS lignes. Le thread
+ * appelant en calcule aussi et appelle la fonction d'annulation entre
+ * deux bandes : elle n'est jamais appelée depuis un autre thread.
+ * 
+ * En couleurs, chaque thread calcule les indices de sa bande dans sa
+ * propre mémoire, de la taille d'une bande, puis les convertit : aucune
+ * mémoire de la taille de l'image n'est allouée.
+ * 
+ */
+
+#include "life.h"
+
+/**
+ * \fn static bool lifeBand(lifeRenderer *r, int firstRow, int lastRow, unsigned short **scratch, size_t *scratchSize);
+ * \brief Calcule une bande de lignes du calcul en cours, sans le verrou
+ * 
+ * \param r Pointeur vers le moteur de calcul
+ * \param firstRow Première ligne de la bande
+ * \param lastRow Ligne suivant la dernière ligne de la bande
+ * \param scratch Indices d'une bande propres au thread, agrandis au besoin
+ * \param scratchSize Nombre d'indices de scratch, mis à jour
+ * \return Faux si la mémoire de la bande manque
+ */
+static bool lifeBand(lifeRenderer *r, int firstRow, int lastRow, unsigned short **scratch, size_t *scratchSize)
+{
+	colorRGB black = {0, 0, 0}, color;
+	size_t size = (size_t) LIFE_BAND_ROWS * r->view.screenWidth;
+	unsigned short *index;
+	unsigned char *pixel;
+	int x, y;
+	
+	if (r->rgb == NULL)
+	{
+		computeComplexRows(r->view, &r->target, firstRow, lastRow);
+		return true;
+	}
+	
+	if (*scratchSize < size)
+	{
+		free(*scratch);
+		*scratch = (unsigned short*) malloc(size * sizeof(unsigned short));
+		*scratchSize = *scratch != NULL ? size : 0;
+		
+		if (*scratch == NULL)
+			return false;
+	}
+	
+	computeComplexBand(r->view, *scratch, r->view.screenWidth, firstRow, lastRow);
+	
+	for (y = firstRow; y < lastRow; y++)
+	{
+		index = *scratch + (size_t) (y - firstRow) * r->view.screenWidth;
+		pixel = r->rgb + (size_t) y * r->rgbStride;
+		
+		for (x = 0; x < r->view.screenWidth; x++)
+		{
+			color = index[x] < r->pal->size ? r->pal->colors[index[x]] : black;
+			*pixel++ = color.red;
+			*pixel++ = color.green;
+			*pixel++ = color.blue;
+		}
+	}
+	
+	return true;
+}
+
+/**
+ * \fn static bool lifeTakeBand(lifeRenderer *r, int *firstRow, int *lastRow);
+ * \brief Prend la prochaine bande du calcul en cours, appelée avec le verrou
+ * 
+ * \param r Pointeur vers le moteur de calcul
+ * \param firstRow Reçoit la première ligne de la bande
+ * \param lastRow Reçoit la ligne suivant la dernière ligne de la bande
+ * \return Faux s'il n'y a plus de bande à calculer
+ */
+static bool lifeTakeBand(lifeRenderer *r, int *firstRow, int *lastRow)
+{
+	if (!r->active || r->cancelled || r->failed || r->nextRow >= r->view.screenHeight)
+		return false;
+	
+	*firstRow = r->nextRow;
+	*lastRow = r->nextRow + LIFE_BAND_ROWS < r->view.screenHeight ? r->nextRow + LIFE_BAND_ROWS : r->view.screenHeight;
+	r->nextRow = *lastRow;
+	r->busy++;
+	
+	return true;
+}
+
+/**
+ * \fn static void lifeBandDone(lifeRenderer *r, int firstRow, int lastRow, bool done);
+ * \brief Compte une bande calculée, appelée avec le verrou
+ * 
+ * \param r Pointeur vers le moteur de calcul
+ * \param firstRow Première ligne de la bande
+ * \param lastRow Ligne suivant la dernière ligne de la bande
+ * \param done Faux si la bande n'a pas pu être calculée, faute de mémoire
+ * \return Rien
+ */
+static void lifeBandDone(lifeRenderer *r, int firstRow, int lastRow, bool done)
+{
+	if (done)
+		r->rowsDone += lastRow - firstRow;
+	else
+		r->failed = true;
+	
+	r->busy--;
+	
+	if (r->busy == 0)
+		pthread_cond_signal(&r->idle);
+}
+
+/**
+ * \fn static void* lifeWorker(void *arg);
+ * \brief Calcule les bandes des calculs successifs jusqu'à l'arrêt du moteur
+ * 
+ * \param arg Pointeur vers le moteur de calcul
+ * \return NULL
+ */
+static void* lifeWorker(void *arg)
+{
+	lifeRenderer *r = (lifeRenderer*) arg;
+	unsigned short *scratch = NULL;
+	size_t scratchSize = 0;
+	int firstRow, lastRow;
+	bool done;
+	
+	pthread_mutex_lock(&r->lock);
+	
+	while (!r->quit)
+	{
+		if (!lifeTakeBand(r, &firstRow, &lastRow))
+		{
+			pthread_cond_wait(&r->work, &r->lock);
+			continue;
+		}
+		
+		pthread_mutex_unlock(&r->lock);
+		done = lifeBand(r, firstRow, lastRow, &scratch, &scratchSize);
+		pthread_mutex_lock(&r->lock);
+		
+		lifeBandDone(r, firstRow, lastRow, done);
+	}
+	
+	pthread_mutex_unlock(&r->lock);
+	free(scratch);
+	return NULL;
+}
+
+/**
+ * \fn static void lifeStart(lifeRenderer *r, int threads);
+ * \brief Démarre les threads du moteur
+ * 
+ * \param r Pointeur vers le moteur de calcul
+ * \param threads Nombre de threads, thread appelant compris, 0 pour un par coeur
+ * \return Rien
+ */
+static void lifeStart(lifeRenderer *r, int threads)
+{
+	int i;
+	
+	if (threads <= 0)
+		threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (threads < 1)
+		threads = 1;
+	if (threads > COMPUTE_THREADS_MAX)
+		threads = COMPUTE_THREADS_MAX;
+	
+	r->quit = false;
+	r->threadCount = 1;
+	
+	/* Les threads créés sont rangés à la suite, ceux qui échouent ne comptent pas */
+	for (i = 0; i < threads - 1; i++)
+		if (pthread_create(&r->threads[r->threadCount - 1], NULL, lifeWorker, r) == 0)
+			r->threadCount++;
+}
+
+/**
+ * \fn static void lifeStop(lifeRenderer *r);
+ * \brief Arrête les threads du moteur, entre deux calculs
+ * 
+ * \param r Pointeur vers le moteur de calcul
+ * \return Rien
+ */
+static void lifeStop(lifeRenderer *r)
+{
+	int i;
+	
+	pthread_mutex_lock(&r->lock);
+	r->quit = true;
+	pthread_cond_broadcast(&r->work);
+	pthread_mutex_unlock(&r->lock);
+	
+	for (i = 0; i < r->threadCount - 1; i++)
+		pthread_join(r->threads[i], NULL);
+	
+	r->threadCount = 1;
+}
+
+/**
+ * \fn lifeRenderer* lifeRendererCreate(int threads);
+ * \brief Crée un moteur de calcul et ses threads
+ * 
+ * \param threads Nombre de threads, thread appelant compris, 0 pour un par coeur
+ * \return Le moteur, à libérer par lifeRendererFree(), NULL si la mémoire manque
+ */
+lifeRenderer* lifeRendererCreate(int threads)
+{
+	lifeRenderer *r = (lifeRenderer*) calloc(1, sizeof(lifeRenderer));
+	
+	if (r == NULL)
+		return NULL;
+	
+	pthread_mutex_init(&r->lock, NULL);
+	pthread_cond_init(&r->work, NULL);
+	pthread_cond_init(&r->idle, NULL);
+	
+	lifeStart(r, threads);
+	
+	return r;
+}
+
+/**
+ * \fn void lifeRendererSetThreads(lifeRenderer *renderer, int threads);
+ * \brief Change le nombre de threads du moteur, entre deux calculs
+ * 
+ * \param renderer Pointeur vers le moteur de calcul
+ * \param threads Nombre de threads, thread appelant compris, 0 pour un par coeur
+ * \return Rien
+ */
+void lifeRendererSetThreads(lifeRenderer *renderer, int threads)
+{
+	lifeStop(renderer);
+	lifeStart(renderer, threads);
+}
+
+/**
+ * \fn void lifeRendererFree(lifeRenderer *renderer);
+ * \brief Arrête les threads du moteur et le libère
+ * 
+ * \param renderer Pointeur vers le moteur de calcul
+ * \return Rien
+ */
+void lifeRendererFree(lifeRenderer *renderer)
+{
+	if (renderer == NULL)
+		return;
+	
+	lifeStop(renderer);
+	
+	pthread_cond_destroy(&renderer->idle);
+	pthread_cond_destroy(&renderer->work);
+	pthread_mutex_destroy(&renderer->lock);
+	
+	if (renderer->pal != NULL)
+		paletteFree(renderer->pal);
+	free(renderer->scratch);
+	free(renderer);
+}
+
+/**
+ * \fn static bool lifeValid(fractalSettings view);
+ * \brief Vérifie les paramètres d'un calcul
+ * 
+ * \param view Paramètres de la fractale
+ * \return Vrai si la fractale peut être calculée
+ */
+static bool lifeValid(fractalSettings view)
+{
+	return view.fractalId >= COMPLEX_MANDELBROT && view.fractalId <= COMPLEX_NEWTON
+		&& view.screenWidth > 0 && view.screenHeight > 0 && view.iterMax > 0
+		&& (view.fractalId != COMPLEX_NEWTON || view.newtonPower >= 2)
+		&& paletteSize(view) <= 65536;
+}
+
+/**
+ * \fn static int lifeRun(lifeRenderer *r, lifeCancel cancel, void *data);
+ * \brief Lance le calcul préparé dans le moteur et y participe jusqu'à la fin
+ * 
+ * \param r Pointeur vers le moteur de calcul
+ * \param cancel Fonction d'annulation, NULL si le calcul ne peut pas être interrompu
+ * \param data Pointeur passé à la fonction d'annulation
+ * \return LIFE_OK, LIFE_CANCELLED si le calcul est interrompu ou LIFE_NOMEM si la mémoire manque
+ */
+static int lifeRun(lifeRenderer *r, lifeCancel cancel, void *data)
+{
+	int firstRow, lastRow, rowsDone, status;
+	bool cancelled, done;
+	
+	pthread_mutex_lock(&r->lock);
+	
+	r->nextRow = 0;
+	r->rowsDone = 0;
+	r->cancelled = false;
+	r->failed = false;
+	r->active = true;
+	pthread_cond_broadcast(&r->work);
+	
+	while (lifeTakeBand(r, &firstRow, &lastRow))
+	{
+		pthread_mutex_unlock(&r->lock);
+		done = lifeBand(r, firstRow, lastRow, &r->scratch, &r->scratchSize);
+		pthread_mutex_lock(&r->lock);
+		
+		lifeBandDone(r, firstRow, lastRow, done);
+		
+		if (cancel != NULL)
+		{
+			rowsDone = r->rowsDone;
+			pthread_mutex_unlock(&r->lock);
+			cancelled = cancel(data, rowsDone, r->view.screenHeight);
+			pthread_mutex_lock(&r->lock);
+			
+			if (cancelled)
+				r->cancelled = true;
+		}
+	}
+	
+	/* Les bandes déjà prises par les autres threads */
+	while (r->busy > 0)
+		pthread_cond_wait(&r->idle, &r->lock);
+	
+	r->active = false;
+	status = r->failed ? LIFE_NOMEM : r->cancelled ? LIFE_CANCELLED : LIFE_OK;
+	
+	pthread_mutex_unlock(&r->lock);
+	
+	return status;
+}
+
+/**
+ * \fn int lifeRenderIndices(lifeRenderer *renderer, fractalSettings view, unsigned short *indices, int stride, lifeCancel cancel, void *data);
+ * \brief Calcule les indices de couleur d'une fractale dans la mémoire de l'appelant
+ * 
+ * La ligne 0 est imagMin. Les indices sont ceux d'un iterationBuffer,
+ * à colorer avec paletteCreate().
+ * 
+ * \param renderer Pointeur vers le moteur de calcul
+ * \param view Paramètres de la fractale
+ * \param indices Mémoire de l'appelant, stride * view.screenHeight indices
+ * \param stride Nombre d'indices entre deux lignes (view.screenWidth au moins)
+ * \param cancel Fonction d'annulation, NULL si le calcul ne peut pas être interrompu
+ * \param data Pointeur passé à la fonction d'annulation
+ * \return LIFE_OK, LIFE_CANCELLED ou LIFE_INVALID
+ */
+int lifeRenderIndices(lifeRenderer *renderer, fractalSettings view, unsigned short *indices, int stride,
+	lifeCancel cancel, void *data)
+{
+	if (!lifeValid(view) || indices == NULL || stride < view.screenWidth)
+		return LIFE_INVALID;
+	
+	renderer->view = view;
+	renderer->target.width = stride;
+	renderer->target.height = view.screenHeight;
+	renderer->target.data = indices;
+	renderer->rgb = NULL;
+	
+	return lifeRun(renderer, cancel, data);
+}
+
+/**
+ * \fn int lifeRenderRGB(lifeRenderer *renderer, fractalSettings view, unsigned char *rgb, int stride, lifeCancel cancel, void *data);
+ * \brief Calcule une fractale en couleurs (RGB, 3 octets par pixel) dans la mémoire de l'appelant
+ * 
+ * La palette est gardée d'un calcul à l'autre tant que la fractale, le
+ * nombre d'itérations et le degré ne changent pas.
+ * 
+ * \param renderer Pointeur vers le moteur de calcul
+ * \param view Paramètres de la fractale
+ * \param rgb Mémoire de l'appelant, stride * view.screenHeight octets
+ * \param stride Nombre d'octets entre deux lignes (3 * view.screenWidth au moins)
+ * \param cancel Fonction d'annulation, NULL si le calcul ne peut pas être interrompu
+ * \param data Pointeur passé à la fonction d'annulation
+ * \return LIFE_OK, LIFE_CANCELLED, LIFE_INVALID ou LIFE_NOMEM
+ */
+int lifeRenderRGB(lifeRenderer *renderer, fractalSettings view, unsigned char *rgb, int stride,
+	lifeCancel cancel, void *data)
+{
+	if (!lifeValid(view) || rgb == NULL || stride / 3 < view.screenWidth)
+		return LIFE_INVALID;
+	
+	/* La palette est comparée aux paramètres avec lesquels elle a été créée */
+	if (renderer->pal == NULL || renderer->palKey.fractalId != view.fractalId
+		|| renderer->palKey.iterMax != view.iterMax
+		|| (view.fractalId == COMPLEX_NEWTON && renderer->palKey.newtonPower != view.newtonPower))
+	{
+		if (renderer->pal != NULL)
+			paletteFree(renderer->pal);
+		renderer->pal = paletteCreate(view);
+		renderer->palKey = view;
+		
+		if (renderer->pal == NULL)
+			return LIFE_NOMEM;
+	}
+	
+	/* Les indices passent par la mémoire d'une bande de chaque thread */
+	renderer->view = view;
+	renderer->target.width = view.screenWidth;
+	renderer->target.height = view.screenHeight;
+	renderer->target.data = NULL;
+	renderer->rgb = rgb;
+	renderer->rgbStride = stride;
+	
+	return lifeRun(renderer, cancel, data);
+}
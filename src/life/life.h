@@ -0,0 +1,125 @@
+/**
+ * \file life.h
+ * \brief Fichier d'entête, interface de la bibliothèque de calcul liblife
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * liblife contient le calcul des fractales complexes (complexFractals.h),
+ * leurs couleurs (palette.h), la gestion du repère (viewport.h) et
+ * l'export de leurs valeurs brutes (iterationField.h), sans SDL ni
+ * OpenGL. Le programme LiFE n'en est qu'un utilisateur.
+ * 
+ * Un lifeRenderer garde ses threads d'un calcul à l'autre et calcule
+ * directement dans la mémoire de l'appelant, sans copie :
+ * 
+ * \code
+ * lifeRenderer *renderer = lifeRendererCreate(0);
+ * fractalSettings view;
+ * unsigned char *rgb = malloc(640 * 480 * 3);
+ * 
+ * memset(&view, 0, sizeof(view));
+ * viewportInit(&view, COMPLEX_MANDELBROT, 640, 480);
+ * lifeRenderRGB(renderer, view, rgb, 640 * 3, NULL, NULL);
+ * 
+ * lifeRendererFree(renderer);
+ * \endcode
+ * 
+ */
+
+#ifndef H_LIFE
+#define H_LIFE
+
+#include <pthread.h>
+
+#include "complexFractals.h"
+#include "iterationField.h"
+#include "palette.h"
+#include "viewport.h"
+
+/* Macros */
+
+/**
+ * \def LIFE_OK
+ * \brief Calcul terminé
+ */
+#define LIFE_OK 0
+
+/**
+ * \def LIFE_CANCELLED
+ * \brief Calcul interrompu par la fonction d'annulation, l'image est incomplète
+ */
+#define LIFE_CANCELLED 1
+
+/**
+ * \def LIFE_INVALID
+ * \brief Paramètres invalides, rien n'est calculé
+ */
+#define LIFE_INVALID (-1)
+
+/**
+ * \def LIFE_NOMEM
+ * \brief Mémoire insuffisante, l'image est incomplète
+ */
+#define LIFE_NOMEM (-2)
+
+/**
+ * \def LIFE_BAND_ROWS
+ * \brief Nombre de lignes d'une bande, l'unité de travail des threads
+ */
+#define LIFE_BAND_ROWS 8
+
+/* Typedef */
+
+/**
+ * \brief Fonction d'annulation, appelée par le thread appelant entre deux bandes
+ * 
+ * Reçoit le pointeur donné au calcul, le nombre de lignes calculées et le
+ * nombre total de lignes. Renvoie vrai pour interrompre le calcul.
+ */
+typedef bool (*lifeCancel)(void *data, int rowsDone, int rows);
+
+/* Structures */
+
+/**
+ * \struct lifeRenderer
+ * \brief Threads de calcul gardés d'un calcul à l'autre, et calcul en cours
+ * 
+*/
+typedef struct
+{
+	pthread_t	threads[COMPUTE_THREADS_MAX];	/*!< Threads, sans compter le thread appelant */
+	int		threadCount;			/*!< Nombre de threads, thread appelant compris */
+	pthread_mutex_t	lock;				/*!< Protège le calcul en cours */
+	pthread_cond_t	work;				/*!< Signalé quand il y a des bandes à calculer */
+	pthread_cond_t	idle;				/*!< Signalé quand plus aucun thread ne calcule */
+	bool		quit;				/*!< Vrai pour arrêter les threads */
+	bool		active;				/*!< Vrai pendant un calcul */
+	bool		cancelled;			/*!< Vrai si le calcul en cours est interrompu */
+	bool		failed;				/*!< Vrai si un thread a manqué de mémoire */
+	fractalSettings	view;				/*!< Paramètres du calcul en cours */
+	iterationBuffer	target;				/*!< Indices calculés (mémoire de l'appelant) */
+	unsigned char	*rgb;				/*!< Couleurs calculées, NULL pour des indices seuls */
+	int		rgbStride;			/*!< Octets entre deux lignes de rgb */
+	int		nextRow;			/*!< Première ligne de la prochaine bande */
+	int		rowsDone;			/*!< Lignes calculées */
+	int		busy;				/*!< Threads en train de calculer une bande */
+	palette		*pal;				/*!< Palette du dernier calcul en couleurs */
+	fractalSettings	palKey;				/*!< Paramètres avec lesquels pal a été créée */
+	unsigned short	*scratch;			/*!< Indices d'une bande du thread appelant (calcul en couleurs) */
+	size_t		scratchSize;			/*!< Nombre d'indices de scratch */
+} lifeRenderer;
+
+/* Prototypes */
+
+lifeRenderer* lifeRendererCreate(int threads);
+void lifeRendererSetThreads(lifeRenderer *renderer, int threads);
+void lifeRendererFree(lifeRenderer *renderer);
+int lifeRenderIndices(lifeRenderer *renderer, fractalSettings view, unsigned short *indices, int stride,
+	lifeCancel cancel, void *data);
+int lifeRenderRGB(lifeRenderer *renderer, fractalSettings view, unsigned char *rgb, int stride,
+	lifeCancel cancel, void *data);
+
+#endif /* H_LIFE */
@@ -59,58 +59,44 @@ void newtonComputeRoots(complex *roots, int power)
 }
 
 /**
- * \fn void newtonDrawRoots(complex *roots, complex z, int power, int x, int y, int iteration, int maxIterations);
- * \brief Dessine et colorie les racines du polynome.
+ * \fn int newtonFindRoot(complex *roots, complex z, int power);
+ * \brief Cherche la racine du polynome vers laquelle la suite a convergé.
  * 
  * \param *roots Tableau stockant les racines du polynome
  * \param z Suite complexe
  * \param power Degré du polynome
- * \param x Position horizontale du pixel
- * \param y Position verticale du pixel
- * \param iterations Nombre d'itérations qui à été utilisé pour calculer la suite
- * \return Rien
+ * \return L'indice de la racine, -1 si la suite n'a convergé vers aucune racine
  */
-void newtonDrawRoots(	complex *roots,
-			complex z,
-			int power,
-			int x,
-			int y,
-			int iteration,
-			int maxIterations)
+int newtonFindRoot(complex *roots, complex z, int power)
 {
 	int i;
-	double angle;
-	colorRGB cRGB;
-	colorHSL cHSL;
-	
-	
-	
-	double deltaIter = (double)(iteration)/(maxIterations);
-	deltaIter = 1 - deltaIter;
-	
-	/* La luminosité est en fonction du nombre d'itérations */
-	cHSL.saturation = 1.0;    /* entre 0 et 1*/
-	cHSL.lightness = 0.5  * deltaIter ;    /* entre 0 et 0.5 et 1*/
-	
 	
 	/* On teste chaque racine, pour retrouver pour laquelle z converge vers */
 	for (i = 0; i < power; i++)
 	{
-		/* Des qu'on trouve la racine où z converge vers */
 		if(complexAbs(complexDif(z,roots[i])) < FRACTAL_NEWTON_PRECISION)
-		{
-			/* L'angle est la position de la racine sur le cercle colorimétrique */
-			angle = (double)i/power;
-			/* Ainsi cela nous donne la valeur de la teinte */
-			cHSL.hue = angle;
-			/* On converti vers le RVB pour OpenGL */
-			cRGB = HSLtoRGB(cHSL);
-			/* On charge la couleur */
-			glColor3ub( cRGB.red , cRGB.green, cRGB.blue);
-			/* On dessine le point */
-			glVertex2f(x,y);
-		}
-		
+			return i;
 	}
 	
+	return -1;
+}
+
+/**
+ * \fn int newtonPaletteIndex(int root, int iteration, int maxIteration);
+ * \brief Calcule l'indice de palette d'un point de la fractale de Newton
+ * 
+ * Chaque racine dispose de (maxIteration + 1) couleurs, l'indice 0 étant
+ * réservé aux points qui ne convergent pas (\e NEWTON_NO_ROOT).
+ * 
+ * \param root Indice de la racine, -1 si aucune
+ * \param iteration Nombre d'itérations qui à été utilisé pour calculer la suite
+ * \param maxIteration Nombre d'itérations maximum
+ * \return L'indice de la couleur dans la palette
+ */
+int newtonPaletteIndex(int root, int iteration, int maxIteration)
+{
+	if (root < 0)
+		return NEWTON_NO_ROOT;
+	
+	return 1 + root * (maxIteration + 1) + iteration;
 }
@@ -14,7 +14,9 @@
 #ifndef H_NEWTON
 #define H_NEWTON 
 
-#include "engine.h"
+#include <stdbool.h>
+
+#include "complex.h"
 
 /* Macros */
 
@@ -27,12 +29,23 @@
  */
 #define FRACTAL_NEWTON_PRECISION 1E-4
 
+/**
+ * \def NEWTON_NO_ROOT
+ * \brief Indice de palette des points qui ne convergent vers aucune racine
+ */
+#define NEWTON_NO_ROOT 0
+
+/**
+ * \def DEFAULT_NEWTON_POWER
+ * \brief Puissance par défaut de la fractale de Newton
+ */
+#define DEFAULT_NEWTON_POWER 3
 
 
 /* Prototypes */
 bool newtonCheckRoots(complex *roots, complex z, int power);
 void newtonComputeRoots(complex *roots, int power);
-void newtonDrawRoots(complex *roots, complex z, int power,
-			int x, int y, int iteration, int maxIteration);
+int newtonFindRoot(complex *roots, complex z, int power);
+int newtonPaletteIndex(int root, int iteration, int maxIteration);
 
 #endif /* H_NEWTON */
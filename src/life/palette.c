@@ -0,0 +1,228 @@
+/**
+ * \file palette.c
+ * \brief Fichier source, palettes de couleurs des fractales complexes
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les fractales complexes sont calculées sous forme d'indices de couleur
+ * (voir \e iterationBuffer). La palette associe une couleur RVB à chacun
+ * de ces indices, ce qui permet de recolorier sans refaire le calcul.
+ * 
+ */
+
+#include "palette.h"
+
+/**
+ * \fn int paletteSize(fractalSettings fSet);
+ * \brief Calcule le nombre de couleurs nécessaires à une fractale
+ * 
+ * \param fSet Paramètres de la fractale
+ * \return Le nombre d'indices possibles dans le tampon d'itérations
+ */
+int paletteSize(fractalSettings fSet)
+{
+	/* Newton : une couleur par racine et par itération, plus le noir */
+	if (fSet.fractalId == COMPLEX_NEWTON)
+		return 1 + fSet.newtonPower * (fSet.iterMax + 1);
+	
+	/* Sinon une couleur par nombre d'itérations (0 à iterMax) */
+	return fSet.iterMax + 1;
+}
+
+/**
+ * \fn palette* paletteCreate(fractalSettings fSet);
+ * \brief Construit la palette de couleurs d'une fractale complexe
+ * 
+ * \param fSet Paramètres de la fractale (identifiant, itérations, puissance)
+ * \return Un pointeur vers la palette allouée, NULL si la mémoire manque
+ */
+palette* paletteCreate(fractalSettings fSet)
+{
+	palette *pal = NULL;
+	int i, root, iteration;
+	colorRGB black = {0, 0, 0};
+	
+	/* On alloue la structure et la table des couleurs */
+	pal = (palette*) malloc(sizeof(palette));
+	
+	if (pal != NULL)
+	{
+		pal->size = paletteSize(fSet);
+		pal->colors = (colorRGB*) malloc(pal->size * sizeof(colorRGB));
+	}
+	
+	if (pal == NULL || pal->colors == NULL)
+	{
+		free(pal);
+		return NULL;
+	}
+	
+	/* On remplit la table selon le type de fractale */
+	switch(fSet.fractalId)
+	{
+		case COMPLEX_MANDELBROT:
+			for (i = 0; i < pal->size; i++)
+				pal->colors[i] = mandelbrotColor(i, fSet.iterMax);
+			break;
+		
+		case COMPLEX_BURNING_SHIP:
+			for (i = 0; i < pal->size; i++)
+				pal->colors[i] = burningShipColor(i, fSet.iterMax);
+			break;
+		
+		case COMPLEX_JULIA:
+			for (i = 0; i < pal->size; i++)
+				pal->colors[i] = juliaColor(i, fSet.iterMax);
+			break;
+		
+		case COMPLEX_NEWTON:
+			pal->colors[NEWTON_NO_ROOT] = black;
+			for (root = 0; root < fSet.newtonPower; root++)
+				for (iteration = 0; iteration <= fSet.iterMax; iteration++)
+					pal->colors[newtonPaletteIndex(root, iteration, fSet.iterMax)] =
+						newtonColor(root, fSet.newtonPower, iteration, fSet.iterMax);
+			break;
+		
+		default:
+			for (i = 0; i < pal->size; i++)
+				pal->colors[i] = black;
+			break;
+	}
+	
+	return pal;
+}
+
+/**
+ * \fn void paletteFree(palette *pal);
+ * \brief Libère une palette.
+ * 
+ * \param pal Pointeur vers la palette
+ * \return Rien
+ */
+void paletteFree(palette *pal)
+{
+	if (pal != NULL)
+	{
+		free(pal->colors);
+		free(pal);
+	}
+}
+
+/**
+ * \fn colorRGB mandelbrotColor(int iteration, int iterMax);
+ * \brief Couleur d'un point de la fractale de Mandelbrot
+ * 
+ * \param iteration Nombre d'itérations avant divergence
+ * \param iterMax Nombre d'itérations maximum
+ * \return La couleur du point
+ */
+colorRGB mandelbrotColor(int iteration, int iterMax)
+{
+	colorHSL colorA;
+	colorRGB black = {0, 0, 0};
+	double iterNormalized;
+	
+	/* La suite converge, alors c'est le centre en noir de la fractale */
+	if (iteration >= iterMax)
+		return black;
+	
+	/* Nombre d'itérations compris entre 0 et 1 */
+	iterNormalized = (double)(iteration)/(iterMax);
+	
+	/* On fait varier la teinte et la luminosité, plutôt que le rouge,vert,bleu */
+	colorA.saturation = 1.0;
+	colorA.lightness = 0.5 * iterNormalized;
+	
+	/* 0.882352941 : 225° teinte bleu roi
+	 * 0.745098039 : 190° teinte turquoise
+	 */
+	iterNormalized = (iterNormalized)*(0.745098039 - 0.882352941) + 0.745098039;
+	colorA.hue = 0.882352941 * iterNormalized;
+	
+	return HSLtoRGB(colorA);
+}
+
+/**
+ * \fn colorRGB burningShipColor(int iteration, int iterMax);
+ * \brief Couleur d'un point de la fractale Burning Ship
+ * 
+ * \param iteration Nombre d'itérations avant divergence
+ * \param iterMax Nombre d'itérations maximum
+ * \return La couleur du point
+ */
+colorRGB burningShipColor(int iteration, int iterMax)
+{
+	colorHSL colorA;
+	colorRGB black = {0, 0, 0};
+	double iterNormalized;
+	
+	if (iteration >= iterMax)
+		return black;
+	
+	iterNormalized = (double)(iteration)/(iterMax);
+	
+	colorA.saturation = 1.0;
+	colorA.lightness = 0.5 * iterNormalized;
+	colorA.hue = 0.125 * iterNormalized;	/* 0.125 est la teinte jaune (45°) */
+	
+	return HSLtoRGB(colorA);
+}
+
+/**
+ * \fn colorRGB juliaColor(int iteration, int iterMax);
+ * \brief Couleur d'un point de la fractale de Julia
+ * 
+ * \param iteration Nombre d'itérations avant divergence
+ * \param iterMax Nombre d'itérations maximum
+ * \return La couleur du point
+ */
+colorRGB juliaColor(int iteration, int iterMax)
+{
+	colorHSL colorA;
+	colorRGB black = {0, 0, 0};
+	double iterNormalized;
+	
+	if (iteration >= iterMax)
+		return black;
+	
+	iterNormalized = (double)(iteration)/(iterMax);
+	
+	colorA.saturation = 1.0;
+	colorA.lightness = 0.5 * iterNormalized;
+	
+	/* 0.470588235 : 120° teinte verte
+	 * 0.352941176 : 90° teinte vert - jaune
+	 */
+	iterNormalized = (iterNormalized)*(0.470588235 - 0.352941176) + 0.470588235;
+	colorA.hue = 0.352941176 * iterNormalized;
+	
+	return HSLtoRGB(colorA);
+}
+
+/**
+ * \fn colorRGB newtonColor(int root, int power, int iteration, int iterMax);
+ * \brief Couleur d'un point de la fractale de Newton
+ * 
+ * \param root Indice de la racine vers laquelle la suite converge
+ * \param power Degré du polynome
+ * \param iteration Nombre d'itérations avant convergence
+ * \param iterMax Nombre d'itérations maximum
+ * \return La couleur du point
+ */
+colorRGB newtonColor(int root, int power, int iteration, int iterMax)
+{
+	colorHSL cHSL;
+	double deltaIter = 1 - (double)(iteration)/(iterMax);
+	
+	/* La luminosité est en fonction du nombre d'itérations */
+	cHSL.saturation = 1.0;
+	cHSL.lightness = 0.5 * deltaIter;
+	
+	/* L'angle de la racine sur le cercle colorimétrique donne la teinte */
+	cHSL.hue = (double)root/power;
+	
+	return HSLtoRGB(cHSL);
+}
@@ -0,0 +1,49 @@
+/**
+ * \file palette.h
+ * \brief Fichier d'entête, palettes de couleurs des fractales complexes
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les fractales complexes sont calculées sous forme d'indices de couleur
+ * (voir \e iterationBuffer). La palette associe une couleur RVB à chacun
+ * de ces indices, ce qui permet de recolorier sans refaire le calcul.
+ * 
+ */
+
+#ifndef H_PALETTE
+#define H_PALETTE
+
+#include "colors.h"
+#include "complexFractals.h"
+
+/* Structures */
+
+/**
+ * \struct palette
+ * \brief Stocke la table des couleurs d'une fractale complexe
+ * 
+ * La case \e i du tableau est la couleur des pixels dont l'indice vaut \e i
+ * dans le tampon d'itérations.
+ * 
+*/
+typedef struct
+{
+	int		size;		/*!< Nombre de couleurs de la palette */
+	colorRGB	*colors;	/*!< Tableau des couleurs */
+} palette;
+
+/* Prototypes */
+
+palette* paletteCreate(fractalSettings fSet);
+void paletteFree(palette *pal);
+int paletteSize(fractalSettings fSet);
+
+colorRGB mandelbrotColor(int iteration, int iterMax);
+colorRGB burningShipColor(int iteration, int iterMax);
+colorRGB juliaColor(int iteration, int iterMax);
+colorRGB newtonColor(int root, int power, int iteration, int iterMax);
+
+#endif /* H_PALETTE */
@@ -0,0 +1,202 @@
+/**
+ * \file viewport.c
+ * \brief Fichier source, repère complexe d'une vue : repère initial, zoom, correspondance pixel-point
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ */
+
+#include "viewport.h"
+
+/**
+ * \fn void viewportInit(fractalSettings *view, int fractalId, int width, int height);
+ * \brief Repère d'une fractale au lancement, à la proportion de l'écran
+ * 
+ * \param view Pointeur sur la structure recevant les paramètres du repère complexe
+ * \param fractalId Identifiant de la fractale
+ * \param width Largeur de l'écran en pixels
+ * \param height Hauteur de l'écran en pixels
+ * \return Rien
+ */
+void viewportInit(fractalSettings *view, int fractalId, int width, int height)
+{
+	view->screenWidth = width;
+	view->screenHeight = height;
+	view->fractalId = fractalId;
+	
+	/* Selon la fractale à dessiner on fixe le repère */
+	switch(fractalId)
+	{
+		
+		case COMPLEX_MANDELBROT:
+			
+			view->realMin = -2.0;
+			view->realMax = 1.0;
+			view->imagMin = -1.1;
+			
+			view->iterMax = 50;
+		
+		break;
+		
+		case COMPLEX_JULIA:
+			
+			view->realMin = -2.0;
+			view->realMax = 2.0;
+			view->imagMin = -1.35;
+			
+			view->iterMax = 50;
+		
+		break;
+		
+		case COMPLEX_BURNING_SHIP:
+			
+			view->realMin = -2.0;
+			view->realMax = 1.2;
+			view->imagMin = -1.6;
+			
+			view->iterMax = 40;
+		
+		break;
+		
+		case COMPLEX_NEWTON:
+			
+			view->realMin = -2.0;
+			view->realMax = 2.0;
+			view->imagMin = -1.5;
+			
+			view->iterMax = 25;
+		
+		break;
+		
+		
+	}
+	
+	/* On calcule dynamiquement la hauteur du repère en fonction de la résolution de l'écran */
+	/* Cela évite de déformer l'image */
+	view->imagMax = view->imagMin + ((view->realMax-view->realMin)*(view->screenHeight)/(view->screenWidth));
+	
+}
+
+/**
+ * \fn void setNewScale(fractalSettings* zoom, int x, int y, double sizeZoom);
+ * \brief Met à jour le repère complexe en fonction des valeurs du zoom
+ * 
+ * Le coin du cadre tombe sur un pixel entier de l'ancienne vue et sa
+ * taille est alignée par alignZoomSize() : les pixels de la nouvelle vue
+ * coïncident alors, un sur 2^k, avec ceux de l'ancienne.
+ * 
+ * \param zoom Pointeur vers les valeurs du repère à modifier
+ * \param x Centre horizontal du repère
+ * \param y Centre vertical du repère
+ * \param size Facteur de zoom [0 à 1]
+ * \return Rien
+ */
+void setNewScale(fractalSettings *zoom, int x, int y, double sizeZoom)
+{
+	/* Récupération de la résolution de la fenêtre */
+	double scrW = zoom->screenWidth;
+	double scrH = zoom->screenHeight;
+	
+	/* Récupération des anciennes valeurs du repère */
+	double lastRealMin = zoom->realMin;
+	double lastRealMax = zoom->realMax;
+	double lastImagMin = zoom->imagMin;
+	double lastImagMax = zoom->imagMax;
+	
+	/* Calcul de la dimension de la boite de zoom en pixel */
+	double size = alignZoomSize(sizeZoom);
+	double offsetHeight = scrH / 2.0 * size; 
+	double offsetWidth = scrW / 2.0 * size; 
+	
+	/* Coin haut gauche de la boite, sur un pixel entier */
+	double left, top;
+	
+	/* On inverse l'axe des ordonnées OpenGL */
+	y = scrH - y;
+	
+	left = floor(x - offsetWidth + 0.5);
+	top = floor(y - offsetHeight + 0.5);
+	
+	/* On met à jour les nouvelle limites du repère */
+	zoom->realMin = (left / scrW) * (lastRealMax - lastRealMin) + lastRealMin;
+	zoom->realMax = zoom->realMin + size * (lastRealMax - lastRealMin);
+	zoom->imagMin = (top / scrH) * (lastImagMax - lastImagMin) + lastImagMin;
+	zoom->imagMax = zoom->imagMin + size * (lastImagMax - lastImagMin);
+}
+
+/**
+ * \fn double alignZoomSize(double sizeZoom);
+ * \brief Aligne la taille du cadre de zoom sur la puissance de deux la plus proche
+ * 
+ * La taille n'est alignée qu'à moins de ZOOM_ALIGN_TOLERANCE d'une
+ * puissance de deux (1, 1/2, 1/4 ... 1/2^ZOOM_ALIGN_MAX).
+ * 
+ * \param sizeZoom Facteur de zoom [0 à 1]
+ * \return Le facteur de zoom aligné, ou inchangé
+ */
+double alignZoomSize(double sizeZoom)
+{
+	double aligned = 1.0, best = sizeZoom, distance = ZOOM_ALIGN_TOLERANCE;
+	int power;
+	
+	for (power = 0; power <= ZOOM_ALIGN_MAX; power++, aligned /= 2.0)
+	{
+		if (fabs(sizeZoom - aligned) <= distance)
+		{
+			best = aligned;
+			distance = fabs(sizeZoom - aligned);
+		}
+	}
+	
+	return best;
+}
+
+
+/**
+ * \fn void zoomAround(fractalSettings *zoom, int x, int y, double factor);
+ * \brief Zoome autour d'un point de l'écran, qui reste fixe
+ * 
+ * \param zoom Pointeur vers les valeurs du repère à modifier
+ * \param x Abscisse du point fixe
+ * \param y Ordonnée du point fixe (repère OpenGL)
+ * \param factor Taille de la nouvelle vue par rapport à l'ancienne
+ * \return Rien
+ */
+void zoomAround(fractalSettings *zoom, int x, int y, double factor)
+{
+	/* Position relative du point (la ligne 0 est en haut, soit imagMin) */
+	double u = (double) x / zoom->screenWidth;
+	double v = (double)(zoom->screenHeight - y) / zoom->screenHeight;
+	
+	/* Nouvelles dimensions du repère */
+	double width = factor * (zoom->realMax - zoom->realMin);
+	double height = factor * (zoom->imagMax - zoom->imagMin);
+	
+	/* Point du plan complexe sous le curseur */
+	double real = zoom->realMin + u * (zoom->realMax - zoom->realMin);
+	double imag = zoom->imagMin + v * (zoom->imagMax - zoom->imagMin);
+	
+	zoom->realMin = real - u * width;
+	zoom->realMax = zoom->realMin + width;
+	zoom->imagMin = imag - v * height;
+	zoom->imagMax = zoom->imagMin + height;
+}
+
+/**
+ * \fn complex pixelToComplex(fractalSettings *zoom, int x, int y);
+ * \brief Point du plan complexe sous un pixel de l'écran
+ * 
+ * \param zoom Pointeur vers les valeurs du repère
+ * \param x Abscisse du pixel
+ * \param y Ordonnée du pixel (repère OpenGL)
+ * \return Le point du plan complexe
+ */
+complex pixelToComplex(fractalSettings *zoom, int x, int y)
+{
+	/* Même correspondance que le calcul des fractales (ligne 0 en haut, soit imagMin) */
+	return complexSet(((double) x / zoom->screenWidth) * (zoom->realMax - zoom->realMin) + zoom->realMin,
+			((double)(zoom->screenHeight - y) / zoom->screenHeight) * (zoom->imagMax - zoom->imagMin) + zoom->imagMin);
+}
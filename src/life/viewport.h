@@ -0,0 +1,42 @@
+/**
+ * \file viewport.h
+ * \brief Fichier d'entête, repère complexe d'une vue : repère initial, zoom, correspondance pixel-point
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Les ordonnées en pixels sont celles d'OpenGL (0 en bas de l'écran),
+ * alors que la ligne 0 d'un tampon d'itérations est en haut (imagMin).
+ * 
+ */
+
+#ifndef H_VIEWPORT
+#define H_VIEWPORT
+
+#include "complexFractals.h"
+
+/* Macros */
+
+/**
+ * \def ZOOM_ALIGN_MAX
+ * \brief Plus petit cadre de zoom aligné : 1 / 2^ZOOM_ALIGN_MAX de l'écran
+ */
+#define ZOOM_ALIGN_MAX 6
+
+/**
+ * \def ZOOM_ALIGN_TOLERANCE
+ * \brief Écart au plus près d'une puissance de deux pour lequel le cadre de zoom s'y aligne
+ */
+#define ZOOM_ALIGN_TOLERANCE 0.03
+
+/* Prototypes */
+
+void viewportInit(fractalSettings *view, int fractalId, int width, int height);
+void setNewScale(fractalSettings *zoom, int x, int y, double sizeZoom);
+double alignZoomSize(double sizeZoom);
+void zoomAround(fractalSettings *zoom, int x, int y, double factor);
+complex pixelToComplex(fractalSettings *zoom, int x, int y);
+
+#endif /* H_VIEWPORT */
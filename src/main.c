@@ -12,24 +12,66 @@
  */
 
 #include "engine.h"
+#include "diskCache.h"
+#include "headless.h"
+#include "tileServer.h"
+#include "cluster.h"
+#include "batch.h"
 
 /**
- * \fn int main(void);
+ * \fn int main(int argc, char *argv[]);
  * \brief Entrée du programme
  * 
+ * \param argc Nombre d'arguments
+ * \param argv Arguments : "--software" pour dessiner sans OpenGL,
+ * "--render" pour écrire une image sans fenêtre (voir headlessRender()),
+ * "--serve" pour servir des tuiles en HTTP (voir tileServerMain()),
+ * "--worker" pour calculer les tuiles d'un coordinateur (voir cluster.h),
+ * "--batch" pour calculer les images d'un manifeste (voir batch.h)
  * \return EXIT_SUCCESS soit 0.
  */
-int main(void)
+int main(int argc, char *argv[])
 {
+	int i;
+	bool software = false;
+	
+	/* Lecture des options de la ligne de commande */
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--software") == 0)
+			software = true;
+		
+		/* Sans fenêtre : ni SDL ni OpenGL */
+		if (strcmp(argv[i], "--render") == 0)
+			return headlessRender(argc, argv);
+		
+		if (strcmp(argv[i], "--serve") == 0)
+			return tileServerMain(argc, argv);
+		
+		if (strcmp(argv[i], "--worker") == 0)
+			return clusterWorkerMain(argc, argv);
+		
+		if (strcmp(argv[i], "--batch") == 0)
+			return batchMain(argc, argv);
+	}
 
+	/* Paquet de ressources pré-décodées, facultatif :
+	 * sans lui, les images et la police sont lues une à une */
+	assetsOpen(ASSETS_FILE);
+	
 	/* Création de la fenêtre */
-	createWindow(1280, 720, "LiFE v1.2");
+	createWindow(1280, 720, "LiFE v1.2", software);
+	
+	/* Cache disque des fractales déjà calculées (voir LIFE_CACHE_DIR) */
+	diskCacheOpen(NULL);
 	
 	/* Entrée dans la boucle pseudo-infinie */
 	startLoop();
+	diskCacheClose();
 	
 	/* Destruction de la fenêtre */
 	destroyWindow();
+	assetsClose();
 
 	/* On sort du programme */
 	return EXIT_SUCCESS;
@@ -70,6 +112,14 @@ int main(void)
  * -# Placez-vous dans le dossier racine du projet.
  * -# Compilez à l'aide de la commande 'make'
  * -# Exécuter le programme avec la commande: ./LiFE
+ * -# Sur une machine sans GPU : ./LiFE --software (dessin sans OpenGL)
+ * -# Sans écran : ./LiFE --render --fractal julia --output julia.png
+ *    (voir headlessRender())
+ * -# Serveur de tuiles local : ./LiFE --serve --port 8080
+ *    (voir tileServerMain())
+ * -# Calcul réparti : ./LiFE --render ... --listen unix:/tmp/life.sock
+ *    puis ./LiFE --worker unix:/tmp/life.sock sur chaque machine (voir cluster.h)
+ * -# Liste d'images : ./LiFE --batch images.txt (voir batch.h)
  * 
  * \section libs Bibliothèques
  * 
@@ -23,7 +23,6 @@ void mainLoop(engineSettings* engine)
 {
 	
 	SDL_Event event;
-	GLuint listVertex = 0;
 	fractalSettings zoom;
 	
 	/* Variables d'état du programme */
@@ -33,6 +32,36 @@ void mainLoop(engineSettings* engine)
 	bool modeDrawFractal = false;
 	bool modeComplexFractal = false;
 	bool modeRecursiveFractal = false;
+	bool modePaletteShader = false;
+	bool modeGLSLCompute = false;
+	
+	/* Redessin à la demande : vrai quand l'image affichée n'est plus à jour */
+	bool needRedraw = true;
+	bool eventPending = false;
+	int mouseX, mouseY;
+	
+	/* Déplacement de la vue (glisser à la souris, flèches), en pixels */
+	int panX = 0, panY = 0;
+	bool dragging = false;
+	bool dragMoved = false;
+	int dragX = 0, dragY = 0;
+	
+	/* Constante de Julia déplacée à la souris (glisser du bouton du milieu) */
+	bool draggingConstant = false;
+	int constantX = 0, constantY = 0;
+	
+	/* Rectangle où s'affiche l'image pendant le zoom continu */
+	float rectX, rectY, rectW, rectH;
+	bool rowsChanged;
+	
+	/* Interaction en cours : l'image peut être calculée à résolution réduite */
+	bool interactive = false;
+	int scale;
+	
+	/* Vue calculée au processeur, gardée dans le cache disque quand
+	 * l'utilisateur s'arrête dessus (pas les images d'une interaction) */
+	bool diskCachePending = false;
+	Uint32 computeStart;
 	
 	/* Variables utilisés pour les fractales */
 	int fractalId;
@@ -41,16 +70,44 @@ void mainLoop(engineSettings* engine)
 	int juliaCstId = 0;
 	
 	/* Constante C pour fractale de julia */
-	complex cstJulia[4];
+	complex cstJulia[JULIA_CONSTANTS + 1];
 	cstJulia[0] = complexSet(0.3, 0.6);
 	cstJulia[1] = complexSet(-0.75, 0.0);
 	cstJulia[2] = complexSet(0.0, 1.0);
 	cstJulia[3] = complexSet(-1.3, 0.0);
 	
+	/* Constante choisie au clic du milieu sur la fractale de Mandelbrot */
+	cstJulia[JULIA_CUSTOM] = cstJulia[0];
+	
 	/* Variables utilisés pour la gestion du zoom */
 	bool showZoomBox = false;
 	double sizeZoomBox = ZOOM_DEFAULT;
-	zoomStack* pZoomStack = NULL;
+	fractalSettings previewView;
+	zoomStack zoomHistory;
+	zoomStackClear(&zoomHistory);
+	
+	/* Fractales déjà calculées, pour dézoomer sans recalculer */
+	renderCache *cache = renderCacheCreate(RENDER_CACHE_BUDGET);
+	
+	/* Vues probables suivantes, calculées en arrière-plan pendant l'attente */
+	fractalSettings views[PREFETCH_MAX];
+	prefetchInit(cache);
+	
+	/* Résultat du calcul des fractales complexes et sa palette */
+	iterationBuffer *iterations = iterationBufferCreate(engine->screen.width, engine->screen.height);
+	panField *field = panFieldCreate(engine->screen.width, engine->screen.height, PAN_GUARD);
+	smoothZoom *smooth = smoothZoomCreate(engine->screen.width, engine->screen.height);
+	dynamicResolution *resolution = dynamicResolutionCreate(engine->screen.width, engine->screen.height);
+	zoomPreview *preview = zoomPreviewCreate(engine->screen.width, engine->screen.height);
+	zoomPreview *juliaPreview = zoomPreviewCreate(engine->screen.width, engine->screen.height);
+	palette *colors = NULL;
+	
+	if (iterations == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation du tampon d'itérations (%dx%d)\n",
+			engine->screen.width, engine->screen.height);
+		exit(EXIT_FAILURE);
+	}
 	
 	/* Chargement des images pour les menus */
 	/* On stocke les pointeurs des images dans une structure */
@@ -64,15 +121,39 @@ void mainLoop(engineSettings* engine)
 	while (engine->running)
 	{
 		
-		/* On efface la fenêtre */
-		glClear( GL_COLOR_BUFFER_BIT );	
-		
-		/* On limite l'affichage à un certain nombre d'images par secondes */
-		limitFrameRate(MAX_FRAMERATE);
+		/* Rien n'a changé : on attend le prochain événement
+		 * sans consommer de temps processeur */
+		if (!needRedraw)
+		{
+			/* Les coeurs libres calculent pendant ce temps les vues
+			 * que l'utilisateur demandera probablement ensuite */
+			if (modeDrawFractal && modeComplexFractal && isFractalDraw)
+				prefetchStart(views, nextViews(views, zoom, engine, cstJulia, juliaCstId,
+						showZoomBox ? sizeZoomBox : 0));
+			else
+				prefetchCancel();
+			
+			/* Vue posée : elle rejoint le cache disque */
+			if (diskCachePending && modeDrawFractal && modeComplexFractal && isFractalDraw
+				&& engine->renderScale == 1 && !smoothZoomBusy(smooth))
+				diskCacheStore(zoom, iterations);
+			diskCachePending = false;
+			
+			eventPending = SDL_WaitEvent(&event);
+		}
 		
 		/* ### Gestion évenements */
-		while(SDL_PollEvent(&event))
+		while(eventPending || SDL_PollEvent(&event))
 		{
+			eventPending = false;
+			
+			/* Tout événement demande une nouvelle image, sauf le
+			 * déplacement de la souris quand le cadre de zoom est caché
+			 * (et que la fractale de Julia sous le curseur n'est pas affichée) */
+			if (event.type != SDL_MOUSEMOTION || showZoomBox || dragging || draggingConstant
+				|| (modeDrawFractal && modeComplexFractal && fractalId == COMPLEX_MANDELBROT))
+				needRedraw = true;
+			
 			switch(event.type)
 			{
 				/* Pour sortir de la boucle et quitter */
@@ -91,6 +172,31 @@ void mainLoop(engineSettings* engine)
 					/* Pour afficher les infos: ips, résolution ... */
 					case SDLK_i:
 						showInfos = 1 - showInfos;
+						
+						/* Le compteur d'images est mis à jour régulièrement */
+						engineOverlayTimer(showInfos);
+						break;
+					
+					/* Affichage des fractales complexes par texture 16 bits et palette GLSL */
+					case SDLK_p:
+						if (engineSoftwareMode())
+							break;
+						if (!modePaletteShader && !paletteShaderInit())
+							break;
+						
+						modePaletteShader = 1 - modePaletteShader;
+						isFractalDraw = false;
+						break;
+					
+					/* Calcul des fractales complexes par le GPU (fragment shader) */
+					case SDLK_g:
+						if (engineSoftwareMode())
+							break;
+						if (!modeGLSLCompute && !glslComputeInit())
+							break;
+						
+						modeGLSLCompute = 1 - modeGLSLCompute;
+						isFractalDraw = false;
 						break;
 					
 					/* Menu principal */	
@@ -102,13 +208,12 @@ void mainLoop(engineSettings* engine)
 							modeRecursiveFractal = false;
 							showZoomBox = false;
 							showHelp = false;
-							zoomStackClear(&pZoomStack);
+							zoomStackClear(&zoomHistory);
 							initZoom(&zoom, engine, fractalId);
 							recursiveIterationCounter = DEFAULT_RECURSIVE_ITERATION;
 							newtonPower = DEFAULT_NEWTON_POWER;
 							isFractalDraw = false;
-							if (listVertex != 0)
-								glDeleteLists(listVertex, 1);
+							fractalLayerFree();
 							
 							/* Et on demande l'affichage du menu */	
 							modeDrawFractal = false;
@@ -141,7 +246,7 @@ void mainLoop(engineSettings* engine)
 							isFractalDraw = false;
 							initZoom(&zoom, engine, fractalId);
 							/* On vide la pile de zoom enregistrés */
-							zoomStackClear(&pZoomStack);
+							zoomStackClear(&zoomHistory);
 						}
 						if (modeDrawFractal && modeRecursiveFractal)
 						{
@@ -159,7 +264,7 @@ void mainLoop(engineSettings* engine)
 							fractalId = COMPLEX_JULIA;
 							isFractalDraw = false;
 							initZoom(&zoom, engine, fractalId);
-							zoomStackClear(&pZoomStack);
+							zoomStackClear(&zoomHistory);
 						}
 						if (modeDrawFractal && modeRecursiveFractal)
 						{
@@ -178,7 +283,7 @@ void mainLoop(engineSettings* engine)
 							isFractalDraw = false;
 							newtonPower = DEFAULT_NEWTON_POWER;
 							initZoom(&zoom, engine, fractalId);
-							zoomStackClear(&pZoomStack);
+							zoomStackClear(&zoomHistory);
 						}
 						if (modeDrawFractal && modeRecursiveFractal)
 						{
@@ -196,7 +301,7 @@ void mainLoop(engineSettings* engine)
 							fractalId = COMPLEX_BURNING_SHIP;
 							isFractalDraw = false;
 							initZoom(&zoom, engine, fractalId);
-							zoomStackClear(&pZoomStack);
+							zoomStackClear(&zoomHistory);
 						}
 						break;
 					
@@ -220,7 +325,16 @@ void mainLoop(engineSettings* engine)
 					/* Touche + du pavé numérique et flèche du haut */
 					case SDLK_KP_PLUS:
 					case SDLK_UP:
-						if (modeDrawFractal)
+						/* Les flèches déplacent la vue des fractales complexes */
+						if (modeDrawFractal && modeComplexFractal)
+						{
+							if (event.key.keysym.sym == SDLK_UP)
+							{
+								panY -= PAN_STEP;
+								isFractalDraw = false;
+							}
+						}
+						else if (modeDrawFractal)
 						{
 							/* Vérifie qu'on dépasse pas le seuil max d'itération */
 							/* Pour les fractales de Sierpinski */
@@ -242,7 +356,15 @@ void mainLoop(engineSettings* engine)
 					/* Touche - du pavé numérique et flèche du bas */	
 					case SDLK_KP_MINUS:
 					case SDLK_DOWN:
-						if (modeDrawFractal)
+						if (modeDrawFractal && modeComplexFractal)
+						{
+							if (event.key.keysym.sym == SDLK_DOWN)
+							{
+								panY += PAN_STEP;
+								isFractalDraw = false;
+							}
+						}
+						else if (modeDrawFractal)
 						{
 							/* Vérifie que le seuil max d'itération est positif */
 							/* Pour les fractales de Sierpinski */
@@ -254,6 +376,22 @@ void mainLoop(engineSettings* engine)
 						}
 						break;
 					
+					case SDLK_LEFT:
+						if (modeDrawFractal && modeComplexFractal)
+						{
+							panX -= PAN_STEP;
+							isFractalDraw = false;
+						}
+						break;
+					
+					case SDLK_RIGHT:
+						if (modeDrawFractal && modeComplexFractal)
+						{
+							panX += PAN_STEP;
+							isFractalDraw = false;
+						}
+						break;
+					
 					/* Touches pour la fractale de Newton
 					 * On modifie la puissance et on demande le redessin
 					 */
@@ -296,6 +434,53 @@ void mainLoop(engineSettings* engine)
 				}
 				break;
 				
+				case SDL_MOUSEMOTION:
+					
+					/* On déplace la vue avec la souris, au delà de quelques
+					 * pixels (sinon c'est un simple clic) */
+					if (dragging && (dragMoved || abs(event.motion.x - dragX) + abs(event.motion.y - dragY) > 3))
+					{
+						panX -= event.motion.x - dragX;
+						panY -= event.motion.y - dragY;
+						dragX = event.motion.x;
+						dragY = event.motion.y;
+						dragMoved = true;
+						isFractalDraw = false;
+					}
+					
+					/* La constante suit la souris, à l'échelle de la vue */
+					if (draggingConstant)
+					{
+						cstJulia[JULIA_CUSTOM].real += (event.motion.x - constantX)
+							* (zoom.realMax - zoom.realMin) / engine->screen.width;
+						cstJulia[JULIA_CUSTOM].imag += (event.motion.y - constantY)
+							* (zoom.imagMax - zoom.imagMin) / engine->screen.height;
+						constantX = event.motion.x;
+						constantY = event.motion.y;
+						isFractalDraw = false;
+					}
+					break;
+				
+				case SDL_MOUSEBUTTONUP:
+					
+					if (event.button.button == 1 && dragging)
+					{
+						/* Activation du mode zoom au clique */
+						if (!dragMoved)
+							showZoomBox = true;
+						dragging = false;
+					}
+					
+					/* Fin du glisser de la constante : on recalcule aussitôt
+					 * à la résolution de l'écran */
+					if (event.button.button == 2 && draggingConstant)
+					{
+						draggingConstant = false;
+						if (resolution->refine)
+							isFractalDraw = false;
+					}
+					break;
+				
 				case SDL_MOUSEBUTTONDOWN:
 					
 					/* Si on est en mode affichage du menu principal */
@@ -337,7 +522,7 @@ void mainLoop(engineSettings* engine)
 						if (event.button.button == 1 && showZoomBox)
 						{
 							/* On empile les anciennes valeurs de zoom */
-							zoomStackPush(&pZoomStack, 	zoom.realMin,
+							zoomStackPush(&zoomHistory,	zoom.realMin,
 											zoom.realMax,
 											zoom.imagMin,
 											zoom.imagMax);
@@ -349,18 +534,52 @@ void mainLoop(engineSettings* engine)
 									
 							/* On demande le redessin de la fractale */
 							isFractalDraw = false;
+							interactive = true;
 							
 							/* On active/désactive le mode zoom */
 							showZoomBox = 1 - showZoomBox;
 						}
 						else if (event.button.button == 1 && !showZoomBox)
-							showZoomBox = 1 - showZoomBox; /* Activation du mode zoom au clique */
+						{
+							/* Un clic active le mode zoom (au relâchement),
+							 * glisser déplace la vue */
+							dragging = true;
+							dragMoved = false;
+							dragX = event.button.x;
+							dragY = event.button.y;
+						}
+						
+						/* Clic du milieu sur la fractale de Mandelbrot : on ouvre
+						 * la fractale de Julia de la constante sous le curseur */
+						if (event.button.button == 2 && fractalId == COMPLEX_MANDELBROT)
+						{
+							cstJulia[JULIA_CUSTOM] = pixelToComplex(&zoom, event.button.x,
+									engine->screen.height - event.button.y);
+							juliaCstId = JULIA_CUSTOM;
+							
+							fractalId = COMPLEX_JULIA;
+							isFractalDraw = false;
+							initZoom(&zoom, engine, fractalId);
+							zoomStackClear(&zoomHistory);
+							break;
+						}
+						
+						/* Glisser du bouton du milieu sur la fractale de Julia :
+						 * on déplace la constante, en partant de celle affichée */
+						if (event.button.button == 2 && fractalId == COMPLEX_JULIA)
+						{
+							cstJulia[JULIA_CUSTOM] = cstJulia[juliaCstId];
+							juliaCstId = JULIA_CUSTOM;
+							draggingConstant = true;
+							constantX = event.button.x;
+							constantY = event.button.y;
+						}
 						
 						/* Si on dézoom clique droit et que la pile de zoom n'est pas vide */
-						if (event.button.button == 3 && pZoomStack != NULL)
+						if (event.button.button == 3 && !zoomStackEmpty(&zoomHistory))
 						{
 							/* On empile les anciennes valeurs de zoom */
-							zoomStackPop(&pZoomStack, 	&zoom.realMin,
+							zoomStackPop(&zoomHistory,	&zoom.realMin,
 											&zoom.realMax,
 											&zoom.imagMin,
 											&zoom.imagMax);
@@ -386,16 +605,42 @@ void mainLoop(engineSettings* engine)
 								sizeZoomBox = ZOOM_PITCH;
 						}
 						
+						/* Sinon la molette zoome en continu autour du curseur */
+						if ((event.button.button == 4 || event.button.button == 5) && !showZoomBox)
+						{
+							/* Un geste de molette ne compte qu'une fois dans l'historique */
+							if (!smoothZoomBusy(smooth))
+								zoomStackPush(&zoomHistory,	zoom.realMin,
+												zoom.realMax,
+												zoom.imagMin,
+												zoom.imagMax);
+							
+							zoomAround(&zoom, event.button.x,
+									engine->screen.height - event.button.y,
+									event.button.button == 4 ? WHEEL_ZOOM : 1.0 / WHEEL_ZOOM);
+							
+							/* L'image affichée suit la nouvelle vue */
+							if (isFractalDraw)
+								smoothZoomTo(smooth, zoom);
+						}
+						
 					}
 					
 				break;
 			}
 		} /* ### Fin gestion évenements */
 		
+		if (!needRedraw || !engine->running)
+			continue;
 		
+		needRedraw = false;
 		
+		/* On limite l'affichage à un certain nombre d'images par secondes */
+		limitFrameRate(MAX_FRAMERATE);
+		
+		/* On efface la fenêtre */
+		clearWindow();
 		
-			
 		/* Debut affichage --- */
 		
 		
@@ -408,58 +653,115 @@ void mainLoop(engineSettings* engine)
 		}
 		else /* On dessine les fractales */
 		{
+			/* Image réduite et utilisateur immobile : on recalcule
+			 * à la résolution de l'écran */
+			if (modeComplexFractal && isFractalDraw && !smoothZoomBusy(smooth)
+				&& dynamicResolutionSettled(resolution))
+				isFractalDraw = false;
+			
 			/* On dessine la fractale */
 			if (isFractalDraw == false)
 			{
 				
-				/* Si la liste de vertex existe déjà on la supprime */
-				if (listVertex != 0)
-					glDeleteLists(listVertex, 1);
-				
-				/* On alloue une liste de vertex */
-				listVertex = glGenLists(1);
-				
 				/* Si on est en mode fractale complexes */
 				if (modeComplexFractal)
 				{
-					/* Commence la liste, en spécifiant quelle sera compilée,
-					 * et non directement affiché à l'écran */
-					glNewList(listVertex, GL_COMPILE);
+					/* Changer la constante de Julia ou la puissance de Newton
+					 * est aussi une interaction */
+					if (zoom.newtonPower != newtonPower
+						|| zoom.cstJulia.real != cstJulia[juliaCstId].real
+						|| zoom.cstJulia.imag != cstJulia[juliaCstId].imag)
+						interactive = true;
 					
-					/* On commence avec les vertex points */
-					glBegin(GL_POINTS);
+					/* On complète les paramètres de la fractale à calculer */
+					zoom.cstJulia = cstJulia[juliaCstId];
+					zoom.newtonPower = newtonPower;
 					
-					/* On affiche le point selon le type de fractale complexe */
-					switch(fractalId)
+					/* Le calcul au premier plan passe avant l'arrière-plan */
+					prefetchCancel();
+					diskCachePending = false;
+					scale = 1;
+					
+					/* On calcule les indices de couleur, par le GPU si demandé
+					 * (le processeur prend le relais pour Newton et les zooms
+					 * profonds), puis la palette associée. Une fractale déjà
+					 * affichée (dézoom, retour à une fractale) est dans le cache. */
+					if (panX != 0 || panY != 0)
 					{
-						case COMPLEX_MANDELBROT:
-							computeMandelbrot(zoom);
-							break;
+						/* Déplacement : les indices sont décalés, seules les
+						 * bandes découvertes au delà de la marge sont calculées */
+						panFieldMove(field, &zoom, panX, panY, iterations);
+						panX = 0;
+						panY = 0;
+					}
+					else if (renderCacheFetch(cache, zoom, iterations))
+						panFieldSet(field, zoom, iterations);
+					else
+					{
+						/* Puis dans le cache disque, d'un lancement à l'autre
+						 * (seuls les calculs exacts du processeur y sont gardés,
+						 * et seulement pour les vues posées : pas pendant une
+						 * interaction). Le processeur calcule aussi la marge de
+						 * déplacement. */
+						if ((!interactive && diskCacheFetch(zoom, iterations))
+							|| (modeGLSLCompute && glslComputeFractal(zoom, iterations)))
+							panFieldSet(field, zoom, iterations);
+						else
+						{
+							/* Pendant une interaction, la résolution est réduite
+							 * pour tenir dans le temps d'une image */
+							if (interactive)
+								scale = dynamicResolutionChoose(resolution, engine->screen.width,
+										engine->screen.height, DYNRES_BUDGET);
 							
-						case COMPLEX_BURNING_SHIP:
-							computeBurningShip(zoom);
-							break;
+							if (scale > 1)
+								dynamicResolutionRender(resolution, zoom, iterations, scale);
+							else
+							{
+								/* Un zoom aligné reprend les pixels déjà connus */
+								computeStart = SDL_GetTicks();
+								if (!panFieldZoom(field, zoom, iterations))
+								{
+									panFieldRender(field, zoom, iterations);
+									dynamicResolutionMeasure(resolution,
+										(long) field->buffer->width * field->buffer->height,
+										SDL_GetTicks() - computeStart);
+								}
+								diskCachePending = !interactive;
+							}
+						}
 						
-						case COMPLEX_JULIA:
-							computeJulia(zoom, cstJulia[juliaCstId]);
-							break;
-							
-						case COMPLEX_NEWTON:
-							computeNewton(zoom, newtonPower);
-							break;
+						/* Les images réduites ne sont pas gardées */
+						if (scale == 1)
+							renderCacheStore(cache, zoom, iterations);
+					}
+					
+					if (scale == 1)
+						dynamicResolutionNative(resolution);
+					engine->renderScale = resolution->scale;
+					interactive = false;
+					
+					paletteFree(colors);
+					colors = paletteCreate(zoom);
+					
+					if (colors == NULL)
+					{
+						fprintf(stderr, "Erreur lors de l'allocation de la palette\n");
+						exit(EXIT_FAILURE);
 					}
 					
-					/* On termine les vertex points */
-					glEnd();
+					uploadIterations(iterations, colors, modePaletteShader);
+					if (modePaletteShader)
+						paletteShaderSetPalette(colors);
 					
-					/* On termine la liste des vertex */
-					glEndList();
+					/* L'image affichée est exactement la vue */
+					smoothZoomReset(smooth, zoom);
 				}
 				/* Sinon si on est en mode récursif */
 				else if (modeRecursiveFractal)
 				{
-					/* On commence la liste des vertex */
-					glNewList(listVertex, GL_COMPILE);
+					/* On commence l'enregistrement du calque */
+					fractalLayerBegin();
 					
 					/* On calcule la fractale récursive */
 					switch(fractalId)
@@ -477,22 +779,90 @@ void mainLoop(engineSettings* engine)
 							break;
 					}
 					
-					/* On termine la liste des vertex */
-					glEndList();
+					/* On termine le calque */
+					fractalLayerEnd();
 				}
 				
-				/* On dit que la fractale est compilé, donc on pourra l'afficher
-				 * au prochain tour de boucle */
+				/* On dit que la fractale est compilé, les images suivantes
+				 * ne font que réafficher le calque */
 				isFractalDraw = true;
+				
+				/* La fenêtre a pu servir au calcul (calque, GPU) */
+				clearWindow();
+			}
 			
+			/* Zoom continu : l'image suit la vue, puis est remplacée bande par bande */
+			if (modeComplexFractal && smoothZoomBusy(smooth))
+			{
+				rowsChanged = false;
+				
+				if (smoothZoomAnimate(smooth))
+				{
+					prefetchCancel();
+					diskCachePending = false;
+					
+					/* Vue atteinte : une vue connue s'affiche tout de suite,
+					 * sinon l'image étirée sert en attendant le calcul */
+					if (renderCacheFetch(cache, zoom, iterations))
+					{
+						smoothZoomReset(smooth, zoom);
+						panFieldSet(field, zoom, iterations);
+					}
+					else if (diskCacheFetch(zoom, iterations)
+						|| (modeGLSLCompute && glslComputeFractal(zoom, iterations)))
+					{
+						smoothZoomReset(smooth, zoom);
+						panFieldSet(field, zoom, iterations);
+						renderCacheStore(cache, zoom, iterations);
+					}
+					else
+						smoothZoomStart(smooth, iterations);
+					
+					rowsChanged = true;
+				}
+				
+				/* Quelques bandes par image, pour rester fluide */
+				if (smooth->nextRow >= 0)
+				{
+					if (smoothZoomStep(smooth, iterations, WHEEL_BUDGET))
+					{
+						dynamicResolutionNative(resolution);
+						engine->renderScale = 1;
+						panFieldSet(field, zoom, iterations);
+						diskCachePending = true;
+						renderCacheStore(cache, zoom, iterations);
+					}
+					
+					rowsChanged = true;
+				}
+				
+				if (rowsChanged)
+				{
+					uploadIterations(iterations, colors, modePaletteShader);
+					clearWindow();
+				}
+				
+				/* On continue d'afficher des images jusqu'à la fin */
+				needRedraw = true;
 			}
-			else
+			
+			/* Image réduite : on revient vérifier si l'utilisateur s'est arrêté */
+			if (modeComplexFractal && resolution->refine)
+				needRedraw = true;
+			
+			/* On affiche le calque enregistré en mémoire, sous les informations */
+			/* Ce qui affiche la fractale, étirée pendant le zoom continu */
+			if (modeComplexFractal)
 			{
-				/* On appelle la liste enregistrée en mémoire */
-				/* Ce qui affiche la fractale */
-				glCallList(listVertex);
+				smoothZoomRect(smooth, &rectX, &rectY, &rectW, &rectH);
 				
+				if (modePaletteShader)
+					paletteShaderDrawRect(rectX, rectY, rectW, rectH);
+				else
+					fractalLayerDrawRect(rectX, rectY, rectW, rectH);
 			}
+			else
+				fractalLayerDraw();
 			
 			/* On affiche le nombre d'itération des fractales récursives */
 			if (modeDrawFractal && modeRecursiveFractal)
@@ -515,7 +885,54 @@ void mainLoop(engineSettings* engine)
 			
 			/* Dessine le cadre de zoom */
 			if (showZoomBox)
-				drawZoomBox(engine, event.motion.x,engine->screen.height - event.motion.y,sizeZoomBox);
+			{
+				SDL_GetMouseState(&mouseX, &mouseY);
+				drawZoomBox(engine, mouseX, engine->screen.height - mouseY, alignZoomSize(sizeZoomBox));
+				
+				/* Aperçu de la zone sous le cadre, en haut à droite */
+				if (modeComplexFractal)
+				{
+					previewView = zoom;
+					setNewScale(&previewView, mouseX, engine->screen.height - mouseY, sizeZoomBox);
+					zoomPreviewRequest(preview, previewView);
+					
+					/* Calcul limité par image, la suite à la prochaine */
+					if (zoomPreviewStep(preview, PREVIEW_BUDGET))
+						needRedraw = true;
+					
+					zoomPreviewDraw(preview,
+						engine->screen.width - engine->screen.width / 4 - 10,
+						engine->screen.height - engine->screen.height / 4 - 10,
+						engine->screen.width / 4, engine->screen.height / 4);
+				}
+			}
+			/* Sur la fractale de Mandelbrot, fractale de Julia de la
+			 * constante sous le curseur, en haut à droite */
+			else if (modeComplexFractal && fractalId == COMPLEX_MANDELBROT
+				&& !dragging && !smoothZoomBusy(smooth))
+			{
+				char str4[60];
+				char str5[80];
+				
+				SDL_GetMouseState(&mouseX, &mouseY);
+				initZoom(&previewView, engine, COMPLEX_JULIA);
+				previewView.cstJulia = pixelToComplex(&zoom, mouseX, engine->screen.height - mouseY);
+				zoomPreviewRequest(juliaPreview, previewView);
+				
+				/* Calcul limité par image, la suite à la prochaine */
+				if (zoomPreviewStep(juliaPreview, PREVIEW_BUDGET))
+					needRedraw = true;
+				
+				zoomPreviewDraw(juliaPreview,
+					engine->screen.width - engine->screen.width / 4 - 10,
+					engine->screen.height - engine->screen.height / 4 - 10,
+					engine->screen.width / 4, engine->screen.height / 4);
+				
+				complexSprintf(str4, previewView.cstJulia);
+				sprintf(str5, "c = %s (clic du milieu)", str4);
+				fontPrint(engine->font1, str5, engine->screen.width - engine->screen.width / 4 - 10,
+						engine->screen.height - engine->screen.height / 4 - 28, blanc);
+			}
 			
 			
 		}
@@ -532,16 +949,32 @@ void mainLoop(engineSettings* engine)
 			showEngineInfos(engine);
 		
 		/* Fin affichage ---
-		 * On envoie tout au GPU */
-		glFlush();
-		SDL_GL_SwapBuffers();
+		 * On envoie tout à l'écran */
+		refreshWindow();
+		
+		/* Temps de démarrage : jusqu'à la première image à l'écran */
+		if (engine->startupTime == 0)
+			engine->startupTime = SDL_GetTicks();
 			
 		
 	} /* Fin while(running) */
 	
-	if (listVertex != 0)
-		glDeleteLists(listVertex, 1);
-		
+	engineOverlayTimer(false);
+	fractalLayerFree();
+	
+	/* Libération du tampon d'itérations et de l'affichage par palette */
+	iterationBufferFree(iterations);
+	panFieldFree(field);
+	smoothZoomFree(smooth);
+	dynamicResolutionFree(resolution);
+	zoomPreviewFree(preview);
+	zoomPreviewFree(juliaPreview);
+	insetFree();
+	prefetchStop();
+	renderCacheFree(cache);
+	paletteFree(colors);
+	paletteShaderFree();
+	glslComputeFree();
 	
 	/* Déchargement des images utilisés */
 	imageFree(images.menuComplex);
@@ -555,11 +988,38 @@ void mainLoop(engineSettings* engine)
 	imageFree(images.docLevy);
 	imageFree(images.docSierpinskiTriangle);
 	imageFree(images.docSierpinskiCarre);
-
+	
 	
 }
 
 
+/**
+ * \fn void uploadIterations(iterationBuffer *buffer, palette *colors, bool paletteShader);
+ * \brief Prépare l'affichage d'un tampon d'itérations
+ * 
+ * \param buffer Tampon d'itérations
+ * \param colors Palette de couleurs
+ * \param paletteShader Vrai pour la coloration par le shader
+ * \return Rien
+ */
+void uploadIterations(iterationBuffer *buffer, palette *colors, bool paletteShader)
+{
+	if (paletteShader)
+	{
+		/* On envoie le tampon 16 bits au GPU, la coloration est
+		 * faite par le shader */
+		paletteShaderUpload(buffer);
+	}
+	else
+	{
+		/* On enregistre le calque de la fractale, chaque point
+		 * avec la couleur de la palette */
+		fractalLayerBegin();
+		drawIterationBuffer(buffer, colors);
+		fractalLayerEnd();
+	}
+}
+
 /**
  * \fn void loadingImages(dataImages *images, engineSettings *engine);
  * \brief Permet de gérer le chargement des images du programme
@@ -645,6 +1105,79 @@ bool checkImageClick(image *img, int mouseX, int mouseY)
 }
 
 
+/**
+ * \fn int nextViews(fractalSettings *views, fractalSettings zoom, engineSettings *engine, complex *cstJulia, int juliaCstId, double sizeZoomBox);
+ * \brief Liste les vues que l'utilisateur demandera probablement ensuite
+ * 
+ * Par ordre de priorité : la zone sous le cadre de zoom, la constante de
+ * Julia suivante (espace), les puissances voisines de Newton, puis les
+ * vues par défaut des autres fractales (F5 à F8).
+ * 
+ * \param views Tableau recevant les vues (au moins PREFETCH_MAX cases)
+ * \param zoom Paramètres de la fractale affichée
+ * \param engine Pointeur vers le moteur
+ * \param cstJulia Constantes de la fractale de Julia
+ * \param juliaCstId Indice de la constante en cours
+ * \param sizeZoomBox Taille du cadre de zoom, 0 s'il est caché
+ * \return Le nombre de vues
+ */
+int nextViews(	fractalSettings *views,
+		fractalSettings zoom,
+		engineSettings *engine,
+		complex *cstJulia,
+		int juliaCstId,
+		double sizeZoomBox)
+{
+	fractalSettings view;
+	int count = 0, id, power, mouseX, mouseY;
+	
+	/* Un clic zoomera sur la zone sous le cadre */
+	if (sizeZoomBox > 0)
+	{
+		SDL_GetMouseState(&mouseX, &mouseY);
+		view = zoom;
+		setNewScale(&view, mouseX, engine->screen.height - mouseY, sizeZoomBox);
+		views[count++] = view;
+	}
+	
+	/* Constante suivante de Julia */
+	if (zoom.fractalId == COMPLEX_JULIA)
+	{
+		view = zoom;
+		view.cstJulia = cstJulia[juliaCstId + 1 < JULIA_CONSTANTS ? juliaCstId + 1 : 0];
+		views[count++] = view;
+	}
+	
+	/* Puissances voisines de Newton (pavé numérique 2 à 9) */
+	if (zoom.fractalId == COMPLEX_NEWTON)
+	{
+		for (power = zoom.newtonPower - 1; power <= zoom.newtonPower + 1; power += 2)
+		{
+			if (power < 2 || power > 9)
+				continue;
+			
+			view = zoom;
+			view.newtonPower = power;
+			views[count++] = view;
+		}
+	}
+	
+	/* Les autres fractales, telles que les touches F5 à F8 les affichent */
+	for (id = COMPLEX_MANDELBROT; id <= COMPLEX_NEWTON; id++)
+	{
+		if (id == zoom.fractalId)
+			continue;
+		
+		view = zoom;
+		initZoom(&view, engine, id);
+		view.cstJulia = cstJulia[juliaCstId];
+		view.newtonPower = DEFAULT_NEWTON_POWER;
+		views[count++] = view;
+	}
+	
+	return count;
+}
+
 /**
  * \fn void initZoom(fractalSettings *zoom, engineSettings *engine, int fractalId);
  * \brief Permet de déterminer si l'utilisateur clique sur une image
@@ -656,60 +1189,7 @@ bool checkImageClick(image *img, int mouseX, int mouseY)
  */
 void initZoom(fractalSettings *zoom, engineSettings *engine, int fractalId)
 {
-	zoom->screenWidth = engine->screen.width;
-	zoom->screenHeight = engine->screen.height;
-	
-	/* Selon la fractale à dessiner on fixe le repère */
-	switch(fractalId)
-	{
-		
-		case COMPLEX_MANDELBROT:
-			
-			zoom->realMin = -2.0;
-			zoom->realMax = 1.0;
-			zoom->imagMin = -1.1;
-			
-			zoom->iterMax = 50;
-		
-		break;
-		
-		case COMPLEX_JULIA:
-			
-			zoom->realMin = -2.0;
-			zoom->realMax = 2.0;
-			zoom->imagMin = -1.35;
-			
-			zoom->iterMax = 50;
-		
-		break;
-		
-		case COMPLEX_BURNING_SHIP:
-			
-			zoom->realMin = -2.0;
-			zoom->realMax = 1.2;
-			zoom->imagMin = -1.6;
-			
-			zoom->iterMax = 40;
-		
-		break;
-		
-		case COMPLEX_NEWTON:
-			
-			zoom->realMin = -2.0;
-			zoom->realMax = 2.0;
-			zoom->imagMin = -1.5;
-			
-			zoom->iterMax = 25;
-		
-		break;
-		
-		
-	}
-	
-	/* On calcule dynamiquement la hauteur du repère en fonction de la résolution de l'écran */
-	/* Cela évite de déformer l'image */
-	zoom->imagMax = zoom->imagMin + ((zoom->realMax-zoom->realMin)*(zoom->screenHeight)/(zoom->screenWidth));
-	
+	viewportInit(zoom, fractalId, engine->screen.width, engine->screen.height);
 }
 
 /**
@@ -17,6 +17,14 @@
 #include "engine.h"
 #include "complexFractals.h"
 #include "recursiveFractals.h"
+#include "render.h"
+#include "renderCache.h"
+#include "diskCache.h"
+#include "prefetch.h"
+#include "pan.h"
+#include "smoothZoom.h"
+#include "dynamicResolution.h"
+#include "zoomPreview.h"
 
 /**
  * \def ZOOM_PITCH
@@ -56,10 +64,16 @@
 #define DEFAULT_RECURSIVE_ITERATION 1
 
 /**
- * \def DEFAULT_NEWTON_POWER
- * \brief Puissance par défaut de la fractale de Newton
+ * \def JULIA_CONSTANTS
+ * \brief Nombre de constantes prédéfinies de la fractale de Julia (touche espace)
  */
-#define DEFAULT_NEWTON_POWER 3
+#define JULIA_CONSTANTS 4
+
+/**
+ * \def JULIA_CUSTOM
+ * \brief Indice de la constante de Julia choisie sur la fractale de Mandelbrot
+ */
+#define JULIA_CUSTOM JULIA_CONSTANTS
 
 /* Structures */
 
@@ -92,6 +106,8 @@ typedef struct
 void loadingImages(dataImages *images, engineSettings *engine);
 bool checkImageClick(image *img, int mouseX, int mouseY);
 void initZoom(fractalSettings *zoom, engineSettings *engine, int fractalId);
+int nextViews(fractalSettings *views, fractalSettings zoom, engineSettings *engine, complex *cstJulia, int juliaCstId, double sizeZoomBox);
 void drawHelp(dataImages *images, int fractalId);
+void uploadIterations(iterationBuffer *buffer, palette *colors, bool paletteShader);
 
 #endif /* H_MAINLOOP */
@@ -0,0 +1,379 @@
+/**
+ * \file pan.c
+ * \brief Fichier source, déplacement de la vue des fractales complexes
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * La fractale est calculée avec une marge de PAN_GUARD pixels autour de
+ * l'écran. Déplacer la vue décale les indices déjà calculés : seules les
+ * bandes découvertes au delà de la marge sont à calculer.
+ * 
+ * De même, un zoom d'un facteur puissance de deux aligné sur les pixels
+ * reprend les indices de la vue précédente qui tombent sur la nouvelle.
+ * 
+ */
+
+#include "pan.h"
+
+/**
+ * \fn panField* panFieldCreate(int width, int height, int guard);
+ * \brief Alloue les indices d'une vue et de sa marge
+ * 
+ * \param width Largeur de la vue en pixels
+ * \param height Hauteur de la vue en pixels
+ * \param guard Largeur de la marge en pixels
+ * \return Un pointeur vers le champ alloué (rien n'est encore calculé)
+ */
+panField* panFieldCreate(int width, int height, int guard)
+{
+	panField *field = (panField*) malloc(sizeof(panField));
+	
+	if (field != NULL)
+		field->buffer = iterationBufferCreate(width + 2 * guard, height + 2 * guard);
+	
+	if (field == NULL || field->buffer == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation de la marge de déplacement\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	field->guard = guard;
+	memset(&field->view, 0, sizeof(fractalSettings));
+	field->knownX0 = field->knownX1 = 0;
+	field->knownY0 = field->knownY1 = 0;
+	
+	return field;
+}
+
+/**
+ * \fn void panFieldFree(panField *field);
+ * \brief Libère les indices d'une vue et de sa marge
+ * 
+ * \param field Pointeur vers le champ
+ * \return Rien
+ */
+void panFieldFree(panField *field)
+{
+	if (field != NULL)
+	{
+		iterationBufferFree(field->buffer);
+		free(field);
+	}
+}
+
+/**
+ * \fn fractalSettings panFieldSettings(panField *field, fractalSettings view);
+ * \brief Paramètres de la fractale étendue à la marge
+ * 
+ * \param field Pointeur vers le champ
+ * \param view Paramètres de la vue à l'écran
+ * \return Les paramètres couvrant la vue et sa marge
+ */
+fractalSettings panFieldSettings(panField *field, fractalSettings view)
+{
+	fractalSettings extended = view;
+	double pixelWidth = (view.realMax - view.realMin) / view.screenWidth;
+	double pixelHeight = (view.imagMax - view.imagMin) / view.screenHeight;
+	
+	extended.screenWidth = field->buffer->width;
+	extended.screenHeight = field->buffer->height;
+	extended.realMin = view.realMin - field->guard * pixelWidth;
+	extended.realMax = view.realMax + field->guard * pixelWidth;
+	extended.imagMin = view.imagMin - field->guard * pixelHeight;
+	extended.imagMax = view.imagMax + field->guard * pixelHeight;
+	
+	return extended;
+}
+
+/**
+ * \fn static void panFieldVisible(panField *field, iterationBuffer *visible);
+ * \brief Copie la partie à l'écran du champ dans le tampon de la vue
+ * 
+ * \param field Pointeur vers le champ
+ * \param visible Tampon de la vue
+ * \return Rien
+ */
+static void panFieldVisible(panField *field, iterationBuffer *visible)
+{
+	int row;
+	
+	for (row = 0; row < visible->height; row++)
+		memcpy(visible->data + row * visible->width,
+			field->buffer->data + (row + field->guard) * field->buffer->width + field->guard,
+			visible->width * sizeof(unsigned short));
+}
+
+/**
+ * \fn void panFieldRender(panField *field, fractalSettings view, iterationBuffer *visible);
+ * \brief Calcule la vue et sa marge
+ * 
+ * \param field Pointeur vers le champ
+ * \param view Paramètres de la vue à l'écran
+ * \param visible Tampon recevant les indices de la vue
+ * \return Rien
+ */
+void panFieldRender(panField *field, fractalSettings view, iterationBuffer *visible)
+{
+	computeComplexParallel(panFieldSettings(field, view), field->buffer);
+	
+	field->view = view;
+	field->knownX0 = 0;
+	field->knownY0 = 0;
+	field->knownX1 = field->buffer->width;
+	field->knownY1 = field->buffer->height;
+	
+	panFieldVisible(field, visible);
+}
+
+/**
+ * \fn void panFieldSet(panField *field, fractalSettings view, iterationBuffer *visible);
+ * \brief Reprend une vue calculée ailleurs (cache, GPU), sans sa marge
+ * 
+ * \param field Pointeur vers le champ
+ * \param view Paramètres de la vue
+ * \param visible Tampon contenant les indices de la vue
+ * \return Rien
+ */
+void panFieldSet(panField *field, fractalSettings view, iterationBuffer *visible)
+{
+	int row;
+	
+	for (row = 0; row < visible->height; row++)
+		memcpy(field->buffer->data + (row + field->guard) * field->buffer->width + field->guard,
+			visible->data + row * visible->width,
+			visible->width * sizeof(unsigned short));
+	
+	/* La marge sera calculée au premier déplacement */
+	field->view = view;
+	field->knownX0 = field->guard;
+	field->knownY0 = field->guard;
+	field->knownX1 = field->guard + visible->width;
+	field->knownY1 = field->guard + visible->height;
+}
+
+/**
+ * \fn void panFieldMove(panField *field, fractalSettings *view, int dx, int dy, iterationBuffer *visible);
+ * \brief Déplace la vue, en ne calculant que les bandes découvertes
+ * 
+ * Tant que la vue reste dans la partie déjà calculée, rien n'est calculé.
+ * Sinon seuls les côtés que la vue dépasse sont complétés, marge de ce
+ * côté comprise, sur tous les coeurs. Si le champ ne correspond pas à la
+ * vue de départ, la nouvelle vue est calculée entière.
+ * 
+ * \param field Pointeur vers le champ
+ * \param view Paramètres de la vue, mis à jour
+ * \param dx Déplacement horizontal de la vue en pixels (positif vers la droite)
+ * \param dy Déplacement vertical de la vue en pixels (positif vers le bas)
+ * \param visible Tampon recevant les indices de la nouvelle vue
+ * \return Rien
+ */
+void panFieldMove(panField *field, fractalSettings *view, int dx, int dy, iterationBuffer *visible)
+{
+	iterationBuffer *buffer = field->buffer;
+	fractalSettings extended;
+	double pixelWidth = (view->realMax - view->realMin) / view->screenWidth;
+	double pixelHeight = (view->imagMax - view->imagMin) / view->screenHeight;
+	int width = buffer->width, height = buffer->height;
+	int row, source, first, last, step, x0, x1;
+	bool known = renderCacheSameSettings(field->view, *view);
+	
+	/* Nouveau repère de la vue (ligne 0 en haut, soit imagMin) */
+	view->realMin += dx * pixelWidth;
+	view->realMax += dx * pixelWidth;
+	view->imagMin += dy * pixelHeight;
+	view->imagMax += dy * pixelHeight;
+	
+	if (!known)
+	{
+		panFieldRender(field, *view, visible);
+		return;
+	}
+	
+	field->view = *view;
+	
+	/* On décale les indices : le pixel (x, y) devient (x - dx, y - dy) */
+	x0 = dx > 0 ? 0 : -dx;
+	x1 = dx > 0 ? width - dx : width;
+	
+	first = dy > 0 ? 0 : height - 1;
+	last = dy > 0 ? height : -1;
+	step = dy > 0 ? 1 : -1;
+	
+	if (x1 > x0)
+	{
+		for (row = first; row != last; row += step)
+		{
+			source = row + dy;
+			if (source < 0 || source >= height)
+				continue;
+			
+			memmove(buffer->data + row * width + x0,
+				buffer->data + source * width + x0 + dx,
+				(x1 - x0) * sizeof(unsigned short));
+		}
+	}
+	
+	/* Le rectangle calculé suit le décalage */
+	field->knownX0 = field->knownX0 - dx > 0 ? field->knownX0 - dx : 0;
+	field->knownY0 = field->knownY0 - dy > 0 ? field->knownY0 - dy : 0;
+	field->knownX1 = field->knownX1 - dx < width ? field->knownX1 - dx : width;
+	field->knownY1 = field->knownY1 - dy < height ? field->knownY1 - dy : height;
+	
+	extended = panFieldSettings(field, *view);
+	
+	/* Plus rien de connu : tout le champ est à calculer */
+	if (field->knownX1 <= field->knownX0 || field->knownY1 <= field->knownY0)
+	{
+		computeComplexParallel(extended, buffer);
+		
+		field->knownX0 = 0;
+		field->knownY0 = 0;
+		field->knownX1 = width;
+		field->knownY1 = height;
+	}
+	
+	/* La vue dépasse la partie calculée d'un côté : on calcule la bande
+	 * découverte et la marge de ce côté seulement, les colonnes d'abord */
+	if (field->knownX0 > field->guard)
+	{
+		computeComplexRegionParallel(extended, buffer, 0, field->knownY0,
+				field->knownX0, field->knownY1 - field->knownY0);
+		field->knownX0 = 0;
+	}
+	
+	if (field->knownX1 < field->guard + visible->width)
+	{
+		computeComplexRegionParallel(extended, buffer, field->knownX1, field->knownY0,
+				width - field->knownX1, field->knownY1 - field->knownY0);
+		field->knownX1 = width;
+	}
+	
+	if (field->knownY0 > field->guard)
+	{
+		computeComplexRegionParallel(extended, buffer, field->knownX0, 0,
+				field->knownX1 - field->knownX0, field->knownY0);
+		field->knownY0 = 0;
+	}
+	
+	if (field->knownY1 < field->guard + visible->height)
+	{
+		computeComplexRegionParallel(extended, buffer, field->knownX0, field->knownY1,
+				field->knownX1 - field->knownX0, height - field->knownY1);
+		field->knownY1 = height;
+	}
+	
+	panFieldVisible(field, visible);
+}
+
+/**
+ * \fn bool panFieldZoom(panField *field, fractalSettings view, iterationBuffer *visible);
+ * \brief Calcule une vue zoomée en reprenant les indices déjà connus du champ
+ * 
+ * Si la taille des pixels de la nouvelle vue est celle de l'ancienne
+ * multipliée par une puissance de deux, et que son coin tombe sur un pixel
+ * entier, les pixels de la nouvelle vue tombant sur des pixels déjà
+ * calculés sont recopiés : un sur 2^k dans chaque direction pour un zoom
+ * avant, tous ceux de l'ancienne vue pour un zoom arrière. Seuls les
+ * autres sont calculés, sur tous les coeurs, par quelques grilles de
+ * pixels espacés.
+ * 
+ * \param field Pointeur vers le champ
+ * \param view Paramètres de la nouvelle vue
+ * \param visible Tampon recevant les indices de la nouvelle vue
+ * \return true si la vue a été calculée, false si elle n'est pas alignée ou symétrique
+ */
+bool panFieldZoom(panField *field, fractalSettings view, iterationBuffer *visible)
+{
+	fractalSettings last = field->view, same = view;
+	iterationBuffer *buffer = field->buffer;
+	double lastWidth = (last.realMax - last.realMin) / last.screenWidth;
+	double lastHeight = (last.imagMax - last.imagMin) / last.screenHeight;
+	double scale, scaleY, originX, originY;
+	int width = visible->width, height = visible->height;
+	int power, step, x, y, x0, x1, y0, y1, rows, offset;
+	
+	/* Même fractale, seul le repère change */
+	same.realMin = last.realMin;
+	same.realMax = last.realMax;
+	same.imagMin = last.imagMin;
+	same.imagMax = last.imagMax;
+	
+	/* Une vue symétrique calculée entière ne coûte que sa moitié, plus
+	 * que ce que les pixels repris font gagner */
+	if (field->knownX1 <= field->knownX0 || field->knownY1 <= field->knownY0
+		|| !renderCacheSameSettings(last, same) || computeComplexSymmetric(view))
+		return false;
+	
+	/* Les pixels sont 2^power fois plus grands que les anciens */
+	scale = (view.realMax - view.realMin) / view.screenWidth / lastWidth;
+	scaleY = (view.imagMax - view.imagMin) / view.screenHeight / lastHeight;
+	power = (int) floor(log2(scale) + 0.5);
+	
+	if (abs(power) > ZOOM_ALIGN_MAX
+		|| fabs(scale / ldexp(1.0, power) - 1.0) * width > PAN_ALIGN_EPSILON
+		|| fabs(scaleY / ldexp(1.0, power) - 1.0) * height > PAN_ALIGN_EPSILON)
+		return false;
+	
+	scale = ldexp(1.0, power);
+	
+	/* Coin de la nouvelle vue dans le champ, sur un pixel entier */
+	originX = (view.realMin - last.realMin) / lastWidth;
+	originY = (view.imagMin - last.imagMin) / lastHeight;
+	
+	if (fabs(originX - floor(originX + 0.5)) > PAN_ALIGN_EPSILON
+		|| fabs(originY - floor(originY + 0.5)) > PAN_ALIGN_EPSILON)
+		return false;
+	
+	originX = floor(originX + 0.5) + field->guard;
+	originY = floor(originY + 0.5) + field->guard;
+	
+	/* En zoom avant, seul un pixel sur step tombe sur un ancien pixel */
+	step = power < 0 ? 1 << -power : 1;
+	
+	/* Pixels de la nouvelle vue tombant dans la partie calculée du champ */
+	x0 = (int) ceil((field->knownX0 - originX) / scale);
+	y0 = (int) ceil((field->knownY0 - originY) / scale);
+	x1 = (int) ceil((field->knownX1 - originX) / scale);
+	y1 = (int) ceil((field->knownY1 - originY) / scale);
+	
+	x0 = x0 > 0 ? (x0 + step - 1) / step * step : 0;
+	y0 = y0 > 0 ? (y0 + step - 1) / step * step : 0;
+	x1 = x1 < width ? x1 : width;
+	y1 = y1 < height ? y1 : height;
+	
+	if (x1 <= x0 || y1 <= y0)
+		return false;
+	
+	/* On reprend les pixels connus */
+	for (y = y0; y < y1; y += step)
+		for (x = x0; x < x1; x += step)
+			visible->data[y * width + x] = buffer->data[(int) (originY + y * scale) * buffer->width
+							+ (int) (originX + x * scale)];
+	
+	/* Lignes au dessus et en dessous de la partie connue */
+	computeComplexRegionParallel(view, visible, 0, 0, width, y0);
+	computeComplexRegionParallel(view, visible, 0, y1, width, height - y1);
+	
+	/* Lignes entre deux lignes connues, une grille par écart à la ligne connue */
+	rows = (y1 - y0 + step - 1) / step;
+	
+	for (offset = 1; offset < step; offset++)
+		computeComplexGridParallel(view, visible, 0, y0 + offset, width,
+				(y1 - y0 - offset + step - 1) / step, 1, step);
+	
+	/* Sur les lignes connues : à gauche, à droite et entre deux pixels connus */
+	computeComplexGridParallel(view, visible, 0, y0, x0, rows, 1, step);
+	computeComplexGridParallel(view, visible, x1, y0, width - x1, rows, 1, step);
+	
+	for (offset = 1; offset < step; offset++)
+		computeComplexGridParallel(view, visible, x0 + offset, y0,
+				(x1 - x0 - offset + step - 1) / step, rows, step, step);
+	
+	/* Le champ correspond désormais à la nouvelle vue, sans sa marge */
+	panFieldSet(field, view, visible);
+	
+	return true;
+}
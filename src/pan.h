@@ -0,0 +1,78 @@
+/**
+ * \file pan.h
+ * \brief Fichier d'entête, déplacement de la vue des fractales complexes
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * La fractale est calculée avec une marge de PAN_GUARD pixels autour de
+ * l'écran. Déplacer la vue décale les indices déjà calculés : seules les
+ * bandes découvertes au delà de la marge sont à calculer.
+ * 
+ * De même, un zoom d'un facteur puissance de deux aligné sur les pixels
+ * reprend les indices de la vue précédente qui tombent sur la nouvelle.
+ * 
+ */
+
+#ifndef H_PAN
+#define H_PAN
+
+#include "viewport.h"
+#include "renderCache.h"
+
+/* Macros */
+
+/**
+ * \def PAN_GUARD
+ * \brief Marge calculée autour de l'écran, en pixels (0 pour aucune)
+ * 
+ * Un déplacement plus petit que la marge ne demande aucun calcul.
+ */
+#define PAN_GUARD 64
+
+/**
+ * \def PAN_STEP
+ * \brief Déplacement de la vue par les flèches du clavier, en pixels
+ */
+#define PAN_STEP 50
+
+/**
+ * \def PAN_ALIGN_EPSILON
+ * \brief Écart toléré, en pixels, pour considérer deux vues alignées
+ */
+#define PAN_ALIGN_EPSILON 1e-3
+
+/* Structures */
+
+/**
+ * \struct panField
+ * \brief Indices de la vue et de sa marge
+ * 
+ * Seul le rectangle [knownX0, knownX1[ x [knownY0, knownY1[ du tampon
+ * contient des indices à jour, le reste est à calculer.
+ * 
+*/
+typedef struct
+{
+	fractalSettings	view;		/*!< Vue à l'écran correspondant aux indices */
+	iterationBuffer	*buffer;	/*!< Indices de l'écran et de la marge */
+	int		guard;		/*!< Largeur de la marge en pixels */
+	int		knownX0;	/*!< Première colonne calculée */
+	int		knownY0;	/*!< Première ligne calculée */
+	int		knownX1;	/*!< Colonne suivant la dernière colonne calculée */
+	int		knownY1;	/*!< Ligne suivant la dernière ligne calculée */
+} panField;
+
+/* Prototypes */
+
+panField* panFieldCreate(int width, int height, int guard);
+void panFieldFree(panField *field);
+fractalSettings panFieldSettings(panField *field, fractalSettings view);
+void panFieldRender(panField *field, fractalSettings view, iterationBuffer *visible);
+void panFieldSet(panField *field, fractalSettings view, iterationBuffer *visible);
+void panFieldMove(panField *field, fractalSettings *view, int dx, int dy, iterationBuffer *visible);
+bool panFieldZoom(panField *field, fractalSettings view, iterationBuffer *visible);
+
+#endif /* H_PAN */
@@ -0,0 +1,382 @@
+/**
+ * \file poster.c
+ * \brief Fichier source, calcul par tuiles des très grandes images (LiFE --render --poster)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * L'image est calculée tuile par tuile et chaque tuile est écrite à sa
+ * place dans un fichier BigTIFF tuilé, non compressé : la mémoire utilisée
+ * ne dépend que de la taille des tuiles, pas de celle de l'image.
+ * 
+ * Un journal (le fichier de sortie suivi de ".journal") liste les tuiles
+ * écrites. Un calcul interrompu, relancé avec les mêmes options, reprend
+ * aux tuiles manquantes. Le journal est supprimé une fois l'image finie.
+ * 
+ */
+
+#include "poster.h"
+#include "cluster.h"
+
+/**
+ * \fn static void putLittle(unsigned char *dest, uint64_t value, int bytes);
+ * \brief Écrit un entier, octet de poids faible en premier (TIFF "II")
+ * 
+ * \param dest Destination
+ * \param value Valeur à écrire
+ * \param bytes Nombre d'octets
+ * \return Rien
+ */
+static void putLittle(unsigned char *dest, uint64_t value, int bytes)
+{
+	int i;
+	
+	for (i = 0; i < bytes; i++)
+		dest[i] = (value >> (8 * i)) & 0xFF;
+}
+
+/**
+ * \fn static unsigned char* tiffEntry(unsigned char *dest, int tag, int type, uint64_t count, uint64_t value);
+ * \brief Écrit une entrée du répertoire BigTIFF
+ * 
+ * \param dest Destination (20 octets)
+ * \param tag Étiquette TIFF
+ * \param type Type des valeurs (3 : 16 bits, 4 : 32 bits, 16 : 64 bits)
+ * \param count Nombre de valeurs
+ * \param value Valeur, ou position des valeurs si elles dépassent 8 octets
+ * \return La destination de l'entrée suivante
+ */
+static unsigned char* tiffEntry(unsigned char *dest, int tag, int type, uint64_t count, uint64_t value)
+{
+	putLittle(dest, tag, 2);
+	putLittle(dest + 2, type, 2);
+	putLittle(dest + 4, count, 8);
+	putLittle(dest + 12, value, 8);
+	
+	return dest + 20;
+}
+
+/**
+ * \fn static bool posterWriteHeader(poster *p);
+ * \brief Écrit l'en-tête BigTIFF, son répertoire et les tables de tuiles
+ * 
+ * Toutes les tuiles ont la même taille : la tuile \e i est à
+ * dataOffset + i * taille d'une tuile, qu'elle soit déjà calculée ou non.
+ * 
+ * \param p Pointeur vers le calcul en cours
+ * \return Vrai si l'écriture a réussi
+ */
+static bool posterWriteHeader(poster *p)
+{
+	unsigned char header[POSTER_HEADER], value[8], *entry;
+	uint64_t tiles = (uint64_t) p->tilesX * p->tilesY;
+	uint64_t tileBytes = (uint64_t) p->tileSize * p->tileSize * p->bytesPerPixel;
+	uint64_t offsets = POSTER_HEADER, counts = POSTER_HEADER + 8 * tiles, i;
+	bool rgb = p->bytesPerPixel == 3;
+	
+	memset(header, 0, POSTER_HEADER);
+	
+	/* "II", BigTIFF (43), positions sur 8 octets, répertoire à l'octet 16 */
+	header[0] = 'I';
+	header[1] = 'I';
+	putLittle(header + 2, 43, 2);
+	putLittle(header + 4, 8, 2);
+	putLittle(header + 8, 16, 8);
+	
+	/* Une seule valeur de 8 octets est rangée dans l'entrée elle-même */
+	if (tiles == 1)
+	{
+		offsets = p->dataOffset;
+		counts = tileBytes;
+	}
+	
+	putLittle(header + 16, 11, 8);
+	entry = header + 24;
+	entry = tiffEntry(entry, 256, 4, 1, p->fSet.screenWidth);
+	entry = tiffEntry(entry, 257, 4, 1, p->fSet.screenHeight);
+	entry = tiffEntry(entry, 258, 3, rgb ? 3 : 1, rgb ? 0x0000000800080008ULL : 16);
+	entry = tiffEntry(entry, 259, 3, 1, 1);
+	entry = tiffEntry(entry, 262, 3, 1, rgb ? 2 : 1);
+	entry = tiffEntry(entry, 277, 3, 1, rgb ? 3 : 1);
+	entry = tiffEntry(entry, 284, 3, 1, 1);
+	entry = tiffEntry(entry, 322, 4, 1, p->tileSize);
+	entry = tiffEntry(entry, 323, 4, 1, p->tileSize);
+	entry = tiffEntry(entry, 324, 16, tiles, offsets);
+	entry = tiffEntry(entry, 325, 16, tiles, counts);
+	
+	/* Pas de répertoire suivant */
+	putLittle(entry, 0, 8);
+	
+	if (fseeko(p->file, 0, SEEK_SET) != 0 || fwrite(header, 1, POSTER_HEADER, p->file) != POSTER_HEADER)
+		return false;
+	
+	if (tiles == 1)
+		return fflush(p->file) == 0;
+	
+	/* Positions des tuiles, puis leurs tailles */
+	for (i = 0; i < tiles; i++)
+	{
+		putLittle(value, p->dataOffset + i * tileBytes, 8);
+		if (fwrite(value, 1, 8, p->file) != 8)
+			return false;
+	}
+	
+	putLittle(value, tileBytes, 8);
+	for (i = 0; i < tiles; i++)
+		if (fwrite(value, 1, 8, p->file) != 8)
+			return false;
+	
+	return fflush(p->file) == 0;
+}
+
+/**
+ * \fn static void posterSignature(poster *p, char *signature, size_t size);
+ * \brief Décrit l'image en une ligne, en tête du journal
+ * 
+ * Un journal n'est repris que si sa première ligne est identique.
+ * 
+ * \param p Pointeur vers le calcul en cours
+ * \param signature Chaîne recevant la description
+ * \param size Taille de la chaîne
+ * \return Rien
+ */
+static void posterSignature(poster *p, char *signature, size_t size)
+{
+	fractalSettings f = p->fSet;
+	
+	snprintf(signature, size, "LiFE poster %d %dx%d %d %d %.17g %.17g %.17g %.17g %d %.17g %.17g %d\n",
+		f.fractalId, f.screenWidth, f.screenHeight, p->tileSize, p->bytesPerPixel,
+		f.realMin, f.realMax, f.imagMin, f.imagMax, f.iterMax,
+		f.cstJulia.real, f.cstJulia.imag, f.newtonPower);
+}
+
+/**
+ * \fn static int posterResume(poster *p, const char *path, const char *journalPath, const char *signature);
+ * \brief Reprend un calcul interrompu, ou en commence un nouveau
+ * 
+ * \param p Pointeur vers le calcul en cours
+ * \param path Chemin du fichier BigTIFF
+ * \param journalPath Chemin du journal
+ * \param signature Description de l'image (première ligne du journal)
+ * \return Le nombre de tuiles déjà écrites, -1 en cas d'erreur
+ */
+static int posterResume(poster *p, const char *path, const char *journalPath, const char *signature)
+{
+	char line[512];
+	FILE *journal = fopen(journalPath, "r");
+	int tile, tiles = p->tilesX * p->tilesY, count = 0;
+	
+	/* Même image : les tuiles listées sont gardées */
+	if (journal != NULL && fgets(line, sizeof(line), journal) != NULL && strcmp(line, signature) == 0
+		&& (p->file = fopen(path, "r+b")) != NULL)
+	{
+		while (fgets(line, sizeof(line), journal) != NULL)
+		{
+			/* Une ligne coupée par l'interruption est ignorée */
+			if (strchr(line, '\n') == NULL || sscanf(line, "%d", &tile) != 1 || tile < 0 || tile >= tiles)
+				continue;
+			
+			if (!(p->done[tile / 8] & (1 << (tile % 8))))
+				count++;
+			p->done[tile / 8] |= 1 << (tile % 8);
+		}
+		
+		fclose(journal);
+		p->journal = fopen(journalPath, "a");
+		
+		return p->journal != NULL ? count : -1;
+	}
+	
+	if (journal != NULL)
+		fclose(journal);
+	
+	/* Sinon on recommence l'image */
+	p->file = fopen(path, "w+b");
+	p->journal = fopen(journalPath, "w");
+	
+	if (p->file == NULL || p->journal == NULL || !posterWriteHeader(p)
+		|| fputs(signature, p->journal) < 0 || fflush(p->journal) != 0)
+		return -1;
+	
+	return 0;
+}
+
+/**
+ * \fn fractalSettings posterTileSettings(fractalSettings image, int tileSize, int index);
+ * \brief Paramètres d'une tuile d'une image découpée en tuiles
+ * 
+ * La tuile est une petite fractale de tileSize pixels de côté : celles du
+ * bord droit et du bord bas dépassent de l'image.
+ * 
+ * \param image Paramètres de l'image entière
+ * \param tileSize Côté des tuiles en pixels
+ * \param index Numéro de la tuile, ligne par ligne depuis le haut à gauche
+ * \return Les paramètres de la tuile
+ */
+fractalSettings posterTileSettings(fractalSettings image, int tileSize, int index)
+{
+	fractalSettings tile = image;
+	double pixelWidth = (image.realMax - image.realMin) / image.screenWidth;
+	double pixelHeight = (image.imagMax - image.imagMin) / image.screenHeight;
+	int tilesX = (image.screenWidth + tileSize - 1) / tileSize;
+	
+	tile.screenWidth = tileSize;
+	tile.screenHeight = tileSize;
+	tile.realMin = image.realMin + (double)(index % tilesX) * tileSize * pixelWidth;
+	tile.realMax = tile.realMin + tileSize * pixelWidth;
+	tile.imagMin = image.imagMin + (double)(index / tilesX) * tileSize * pixelHeight;
+	tile.imagMax = tile.imagMin + tileSize * pixelHeight;
+	
+	return tile;
+}
+
+/**
+ * \fn static bool posterTileStore(poster *p, int index, iterationBuffer *tile);
+ * \brief Écrit une tuile calculée à sa place et la note dans le journal
+ * 
+ * La tuile est sur le disque avant d'être notée : une tuile du journal
+ * est toujours complète.
+ * 
+ * \param p Pointeur vers le calcul en cours
+ * \param index Numéro de la tuile, ligne par ligne depuis le haut à gauche
+ * \param tile Indices de la tuile
+ * \return Vrai si l'écriture a réussi
+ */
+static bool posterTileStore(poster *p, int index, iterationBuffer *tile)
+{
+	uint64_t tileBytes = (uint64_t) p->tileSize * p->tileSize * p->bytesPerPixel;
+	unsigned char *pixel = p->pixels;
+	colorRGB black = {0, 0, 0}, color;
+	unsigned short value;
+	int i, size = p->tileSize * p->tileSize;
+	
+	for (i = 0; i < size; i++)
+	{
+		value = tile->data[i];
+		
+		if (p->bytesPerPixel == 2)
+		{
+			putLittle(pixel, value, 2);
+			pixel += 2;
+		}
+		else
+		{
+			color = value < p->pal->size ? p->pal->colors[value] : black;
+			*pixel++ = color.red;
+			*pixel++ = color.green;
+			*pixel++ = color.blue;
+		}
+	}
+	
+	if (fseeko(p->file, p->dataOffset + index * tileBytes, SEEK_SET) != 0
+		|| fwrite(p->pixels, 1, tileBytes, p->file) != tileBytes
+		|| fflush(p->file) != 0 || fdatasync(fileno(p->file)) != 0)
+		return false;
+	
+	return fprintf(p->journal, "%d\n", index) > 0 && fflush(p->journal) == 0;
+}
+
+/**
+ * \fn bool posterRender(renderJob *job, fractalSettings fSet, int format);
+ * \brief Calcule une image par tuiles dans un fichier BigTIFF
+ * 
+ * \param job Image à calculer (fichier, côté des tuiles)
+ * \param fSet Paramètres de l'image entière
+ * \param format IMAGE_FORMAT_TIFF (couleurs) ou IMAGE_FORMAT_RAW (indices sur 16 bits)
+ * \return Vrai si l'image est entièrement écrite (sinon message sur stderr)
+ */
+bool posterRender(renderJob *job, fractalSettings fSet, int format)
+{
+	poster p;
+	cluster c;
+	char signature[512];
+	char *journalPath = (char*) malloc(strlen(job->output) + 9);
+	int tiles, index, resumed;
+	bool success = true;
+	
+	memset(&p, 0, sizeof(poster));
+	p.fSet = fSet;
+	p.tileSize = job->tileSize;
+	p.tilesX = (fSet.screenWidth + p.tileSize - 1) / p.tileSize;
+	p.tilesY = (fSet.screenHeight + p.tileSize - 1) / p.tileSize;
+	p.bytesPerPixel = format == IMAGE_FORMAT_RAW ? 2 : 3;
+	tiles = p.tilesX * p.tilesY;
+	
+	/* Les tuiles suivent l'en-tête et les deux tables */
+	p.dataOffset = POSTER_HEADER + 16 * (uint64_t) tiles;
+	if (tiles == 1)
+		p.dataOffset = POSTER_HEADER;
+	
+	p.done = (unsigned char*) calloc(tiles / 8 + 1, 1);
+	p.pixels = (unsigned char*) malloc((size_t) p.tileSize * p.tileSize * p.bytesPerPixel);
+	p.tile = iterationBufferCreate(p.tileSize, p.tileSize);
+	p.pal = paletteCreate(fSet);
+	
+	if (journalPath == NULL || p.done == NULL || p.pixels == NULL || p.tile == NULL || p.pal == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation du poster (%d tuiles)\n", tiles);
+		exit(EXIT_FAILURE);
+	}
+	
+	sprintf(journalPath, "%s.journal", job->output);
+	posterSignature(&p, signature, sizeof(signature));
+	
+	resumed = posterResume(&p, job->output, journalPath, signature);
+	
+	if (resumed < 0)
+	{
+		fprintf(stderr, "Erreur lors de l'ouverture de %s ou de son journal\n", job->output);
+		success = false;
+	}
+	else if (resumed > 0)
+		printf("Reprise de %s : %d tuiles sur %d déjà calculées\n", job->output, resumed, tiles);
+	
+	/* Tuiles calculées par les travailleurs, dans l'ordre où elles reviennent */
+	if (success && job->listen != NULL)
+	{
+		success = clusterOpen(&c, job->listen, fSet, p.tileSize, p.done);
+		
+		while (success && (index = clusterNext(&c)) >= 0)
+			if (!posterTileStore(&p, index, c.result))
+			{
+				fprintf(stderr, "Erreur lors de l'écriture de la tuile %d de %s\n", index, job->output);
+				success = false;
+			}
+		
+		if (c.listener >= 0)
+			clusterClose(&c);
+	}
+	
+	for (index = 0; success && job->listen == NULL && index < tiles; index++)
+	{
+		if (p.done[index / 8] & (1 << (index % 8)))
+			continue;
+		
+		computeComplexParallel(posterTileSettings(fSet, p.tileSize, index), p.tile);
+		
+		if (!posterTileStore(&p, index, p.tile))
+		{
+			fprintf(stderr, "Erreur lors de l'écriture de la tuile %d de %s\n", index, job->output);
+			success = false;
+		}
+	}
+	
+	if (p.journal != NULL && fclose(p.journal) != 0)
+		success = false;
+	if (p.file != NULL && fclose(p.file) != 0)
+		success = false;
+	
+	/* Image finie : le journal ne sert plus */
+	if (success)
+		remove(journalPath);
+	
+	paletteFree(p.pal);
+	iterationBufferFree(p.tile);
+	free(p.pixels);
+	free(p.done);
+	free(journalPath);
+	
+	return success;
+}
@@ -0,0 +1,75 @@
+/**
+ * \file poster.h
+ * \brief Fichier d'entête, calcul par tuiles des très grandes images (LiFE --render --poster)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * L'image est calculée tuile par tuile et chaque tuile est écrite à sa
+ * place dans un fichier BigTIFF tuilé, non compressé : la mémoire utilisée
+ * ne dépend que de la taille des tuiles, pas de celle de l'image.
+ * 
+ * Un journal (le fichier de sortie suivi de ".journal") liste les tuiles
+ * écrites. Un calcul interrompu, relancé avec les mêmes options, reprend
+ * aux tuiles manquantes. Le journal est supprimé une fois l'image finie.
+ * 
+ */
+
+#ifndef H_POSTER
+#define H_POSTER
+
+#include <stdint.h>
+
+#include "headless.h"
+
+/* Macros */
+
+/**
+ * \def POSTER_TILE
+ * \brief Côté des tuiles par défaut, en pixels
+ */
+#define POSTER_TILE 512
+
+/**
+ * \def POSTER_TILE_MAX
+ * \brief Plus grand côté de tuile accepté, en pixels
+ */
+#define POSTER_TILE_MAX 4096
+
+/**
+ * \def POSTER_HEADER
+ * \brief Position des tables de tuiles dans le fichier, après l'en-tête et le répertoire TIFF
+ */
+#define POSTER_HEADER 256
+
+/* Structures */
+
+/**
+ * \struct poster
+ * \brief Calcul en cours d'une image par tuiles
+ * 
+*/
+typedef struct
+{
+	fractalSettings	fSet;		/*!< Paramètres de l'image entière */
+	int		tileSize;	/*!< Côté des tuiles en pixels (multiple de 16) */
+	int		tilesX;		/*!< Nombre de tuiles en largeur */
+	int		tilesY;		/*!< Nombre de tuiles en hauteur */
+	int		bytesPerPixel;	/*!< 3 (couleurs RGB) ou 2 (indices sur 16 bits) */
+	uint64_t	dataOffset;	/*!< Position de la première tuile dans le fichier */
+	FILE		*file;		/*!< Fichier BigTIFF */
+	FILE		*journal;	/*!< Journal des tuiles écrites */
+	unsigned char	*done;		/*!< Tuiles écrites, un bit par tuile */
+	iterationBuffer	*tile;		/*!< Indices de la tuile en cours */
+	unsigned char	*pixels;	/*!< Tuile en cours au format du fichier */
+	palette		*pal;		/*!< Palette de l'image */
+} poster;
+
+/* Prototypes */
+
+fractalSettings posterTileSettings(fractalSettings image, int tileSize, int index);
+bool posterRender(renderJob *job, fractalSettings fSet, int format);
+
+#endif /* H_POSTER */
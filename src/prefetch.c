@@ -0,0 +1,303 @@
+/**
+ * \file prefetch.c
+ * \brief Fichier source, calcul en arrière-plan des prochaines vues probables
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Pendant que l'utilisateur regarde une fractale, les coeurs inutilisés
+ * calculent les vues qu'il demandera probablement ensuite (autre fractale,
+ * constante suivante, zone sous le cadre de zoom ...), à basse priorité.
+ * Les résultats vont dans le cache des fractales (\e renderCache).
+ * 
+ * Les threads calculent ensemble une vue à la fois, par bandes de lignes.
+ * Une nouvelle demande (ou un calcul au premier plan) annule les bandes
+ * restantes : un thread n'est jamais occupé plus d'une bande pour rien.
+ * 
+ */
+
+#include "prefetch.h"
+
+#include <sched.h>
+#include <unistd.h>
+
+/* Etat partagé par les threads, protégé par lock */
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+
+static pthread_t threads[PREFETCH_THREADS_MAX];
+static int threadCount = 0;
+static bool quit = false;
+
+static renderCache *target = NULL;
+
+/* Vues demandées et vue en cours de calcul */
+static fractalSettings views[PREFETCH_MAX];
+static int viewCount = 0;
+static int viewCurrent = 0;
+static unsigned int generation = 0;
+
+static iterationBuffer *buffer = NULL;
+static bool bufferReady = false;
+static int nextRow = 0;
+static int rowsDone = 0;
+static int busy = 0;
+
+/**
+ * \fn static void lowerPriority(void);
+ * \brief Passe le thread appelant en priorité minimale
+ * 
+ * \return Rien
+ */
+static void lowerPriority(void)
+{
+#ifdef SCHED_IDLE
+	struct sched_param param;
+	
+	/* Ne s'exécute que si aucun autre thread ne veut le processeur */
+	param.sched_priority = 0;
+	pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#else
+	if (nice(19) == -1)
+		return;
+#endif
+}
+
+/**
+ * \fn static bool viewSetup(void);
+ * \brief Prépare le calcul de la prochaine vue qui n'est pas déjà dans le cache
+ * \remark lock doit être tenu, et aucun bloc ne doit être en cours (busy nul).
+ * 
+ * \return Vrai si une vue est prête à être calculée
+ */
+static bool viewSetup(void)
+{
+	fractalSettings view;
+	
+	while (viewCurrent < viewCount)
+	{
+		view = views[viewCurrent];
+		
+		if (renderCacheContains(target, view))
+		{
+			viewCurrent++;
+			continue;
+		}
+		
+		/* Le tampon est réutilisé tant que la taille ne change pas */
+		if (buffer != NULL && (buffer->width != view.screenWidth || buffer->height != view.screenHeight))
+		{
+			iterationBufferFree(buffer);
+			buffer = NULL;
+		}
+		
+		if (buffer == NULL)
+			buffer = iterationBufferCreate(view.screenWidth, view.screenHeight);
+		
+		if (buffer == NULL)
+		{
+			fprintf(stderr, "Erreur lors de l'allocation du préchargement (%dx%d)\n",
+				view.screenWidth, view.screenHeight);
+			exit(EXIT_FAILURE);
+		}
+		
+		nextRow = 0;
+		rowsDone = 0;
+		bufferReady = true;
+		
+		return true;
+	}
+	
+	return false;
+}
+
+/**
+ * \fn static void* prefetchWorker(void *param);
+ * \brief Boucle d'un thread de calcul en arrière-plan
+ * 
+ * \param param Inutilisé
+ * \return NULL
+ */
+static void* prefetchWorker(void *param)
+{
+	fractalSettings view;
+	unsigned int jobGeneration;
+	int firstRow, lastRow;
+	
+	(void) param;
+	
+	lowerPriority();
+	
+	pthread_mutex_lock(&lock);
+	
+	while (!quit)
+	{
+		/* Rien à calculer, ou un bloc annulé est encore en cours */
+		if (!bufferReady && (busy > 0 || !viewSetup()))
+		{
+			pthread_cond_wait(&wake, &lock);
+			continue;
+		}
+		
+		view = views[viewCurrent];
+		
+		/* Toutes les bandes sont distribuées, on attend la fin des autres */
+		if (nextRow >= view.screenHeight)
+		{
+			pthread_cond_wait(&wake, &lock);
+			continue;
+		}
+		
+		firstRow = nextRow;
+		lastRow = firstRow + PREFETCH_BAND < view.screenHeight ? firstRow + PREFETCH_BAND : view.screenHeight;
+		nextRow = lastRow;
+		jobGeneration = generation;
+		busy++;
+		
+		pthread_mutex_unlock(&lock);
+		computeComplexRows(view, buffer, firstRow, lastRow);
+		pthread_mutex_lock(&lock);
+		
+		/* La vue est terminée : on la range dans le cache */
+		if (jobGeneration == generation)
+		{
+			rowsDone += lastRow - firstRow;
+			
+			if (rowsDone == view.screenHeight)
+			{
+				pthread_mutex_unlock(&lock);
+				renderCacheStore(target, view, buffer);
+				pthread_mutex_lock(&lock);
+				
+				if (jobGeneration == generation)
+					viewCurrent++;
+				bufferReady = false;
+			}
+		}
+		
+		busy--;
+		pthread_cond_broadcast(&wake);
+	}
+	
+	pthread_mutex_unlock(&lock);
+	
+	return NULL;
+}
+
+/**
+ * \fn void prefetchInit(renderCache *cache);
+ * \brief Démarre les threads de calcul en arrière-plan (un par coeur, moins un)
+ * 
+ * \param cache Cache recevant les vues calculées
+ * \return Rien
+ */
+void prefetchInit(renderCache *cache)
+{
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	int i;
+	
+	target = cache;
+	quit = false;
+	
+	/* Un coeur reste au premier plan */
+	threadCount = cores > 2 ? cores - 1 : 1;
+	if (threadCount > PREFETCH_THREADS_MAX)
+		threadCount = PREFETCH_THREADS_MAX;
+	
+	for (i = 0; i < threadCount; i++)
+	{
+		if (pthread_create(&threads[i], NULL, prefetchWorker, NULL) != 0)
+		{
+			threadCount = i;
+			break;
+		}
+	}
+}
+
+/**
+ * \fn void prefetchStart(fractalSettings *list, int count);
+ * \brief Demande le calcul en arrière-plan d'une liste de vues, par ordre de priorité
+ * 
+ * Si la liste est identique à la demande en cours, le calcul continue.
+ * Sinon le calcul en cours est abandonné.
+ * 
+ * \param list Vues à calculer, la plus probable d'abord
+ * \param count Nombre de vues
+ * \return Rien
+ */
+void prefetchStart(fractalSettings *list, int count)
+{
+	bool same;
+	int i;
+	
+	if (count > PREFETCH_MAX)
+		count = PREFETCH_MAX;
+	
+	pthread_mutex_lock(&lock);
+	
+	same = count == viewCount;
+	for (i = 0; i < count && same; i++)
+		same = renderCacheSameSettings(list[i], views[i]);
+	
+	if (!same)
+	{
+		for (i = 0; i < count; i++)
+			views[i] = list[i];
+		
+		viewCount = count;
+		viewCurrent = 0;
+		bufferReady = false;
+		generation++;
+		
+		pthread_cond_broadcast(&wake);
+	}
+	
+	pthread_mutex_unlock(&lock);
+}
+
+/**
+ * \fn void prefetchCancel(void);
+ * \brief Abandonne les calculs en arrière-plan (un calcul au premier plan commence)
+ * 
+ * \return Rien
+ */
+void prefetchCancel(void)
+{
+	pthread_mutex_lock(&lock);
+	
+	viewCount = 0;
+	viewCurrent = 0;
+	bufferReady = false;
+	generation++;
+	
+	pthread_mutex_unlock(&lock);
+}
+
+/**
+ * \fn void prefetchStop(void);
+ * \brief Arrête les threads de calcul en arrière-plan
+ * 
+ * \return Rien
+ */
+void prefetchStop(void)
+{
+	int i;
+	
+	pthread_mutex_lock(&lock);
+	quit = true;
+	viewCount = 0;
+	generation++;
+	pthread_cond_broadcast(&wake);
+	pthread_mutex_unlock(&lock);
+	
+	for (i = 0; i < threadCount; i++)
+		pthread_join(threads[i], NULL);
+	
+	threadCount = 0;
+	
+	iterationBufferFree(buffer);
+	buffer = NULL;
+	bufferReady = false;
+}
@@ -0,0 +1,49 @@
+/**
+ * \file prefetch.h
+ * \brief Fichier d'entête, calcul en arrière-plan des prochaines vues probables
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Pendant que l'utilisateur regarde une fractale, les coeurs inutilisés
+ * calculent les vues qu'il demandera probablement ensuite (autre fractale,
+ * constante suivante, zone sous le cadre de zoom ...), à basse priorité.
+ * Les résultats vont dans le cache des fractales (\e renderCache).
+ * 
+ */
+
+#ifndef H_PREFETCH
+#define H_PREFETCH
+
+#include "renderCache.h"
+
+/* Macros */
+
+/**
+ * \def PREFETCH_MAX
+ * \brief Nombre maximum de vues à calculer en avance
+ */
+#define PREFETCH_MAX 16
+
+/**
+ * \def PREFETCH_THREADS_MAX
+ * \brief Nombre maximum de threads de calcul en arrière-plan
+ */
+#define PREFETCH_THREADS_MAX 16
+
+/**
+ * \def PREFETCH_BAND
+ * \brief Nombre de lignes calculées d'un bloc, entre deux vérifications d'annulation
+ */
+#define PREFETCH_BAND 8
+
+/* Prototypes */
+
+void prefetchInit(renderCache *cache);
+void prefetchStart(fractalSettings *views, int count);
+void prefetchCancel(void);
+void prefetchStop(void);
+
+#endif /* H_PREFETCH */
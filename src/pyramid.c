@@ -0,0 +1,474 @@
+/**
+ * \file pyramid.c
+ * \brief Fichier source, pyramide de tuiles pour les visionneuses web (LiFE --render --pyramid)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Le niveau z couvre la région de 2^z x 2^z tuiles PNG de PYRAMID_TILE
+ * pixels, du niveau 0 (une tuile) au niveau demandé. Les tuiles d'un
+ * niveau sont calculées en parallèle, un thread par tuile.
+ * 
+ * Mandelbrot et Julia remplis n'ont pas de trou : une tuile dont le bord
+ * est entièrement intérieur est entièrement intérieure, sans calculer le
+ * reste, et ses tuiles filles aussi, sans rien calculer.
+ * 
+ */
+
+#include "pyramid.h"
+
+#include <errno.h>
+#include <sys/stat.h>
+
+/**
+ * \fn fractalSettings pyramidRegion(fractalSettings view);
+ * \brief Carré couvert par une pyramide
+ * 
+ * C'est le carré centré sur la vue dont le côté est le plus grand côté
+ * de la vue.
+ * 
+ * \param view Paramètres de la vue à couvrir
+ * \return Les paramètres du carré
+ */
+fractalSettings pyramidRegion(fractalSettings view)
+{
+	fractalSettings region = view;
+	double width = view.realMax - view.realMin, height = view.imagMax - view.imagMin;
+	double side = width > height ? width : height;
+	
+	region.realMin = view.realMin + (width - side) / 2;
+	region.realMax = region.realMin + side;
+	region.imagMin = view.imagMin + (height - side) / 2;
+	region.imagMax = region.imagMin + side;
+	
+	return region;
+}
+
+/**
+ * \fn fractalSettings pyramidTileSettings(fractalSettings region, int level, long x, long y);
+ * \brief Paramètres de la fractale d'une tuile
+ * 
+ * \param region Carré couvert par la pyramide (voir pyramidRegion())
+ * \param level Niveau de la tuile
+ * \param x Colonne de la tuile (0 à gauche)
+ * \param y Ligne de la tuile (0 en haut, soit du côté de imagMin)
+ * \return Les paramètres de la tuile
+ */
+fractalSettings pyramidTileSettings(fractalSettings region, int level, long x, long y)
+{
+	fractalSettings tile = region;
+	double side = (region.realMax - region.realMin) / (double)(1L << level);
+	
+	tile.screenWidth = PYRAMID_TILE;
+	tile.screenHeight = PYRAMID_TILE;
+	tile.realMin = region.realMin + x * side;
+	tile.realMax = tile.realMin + side;
+	tile.imagMin = region.imagMin + y * side;
+	tile.imagMax = tile.imagMin + side;
+	
+	return tile;
+}
+
+/**
+ * \fn static bool pyramidBorderInterior(fractalSettings tile, iterationBuffer *buffer);
+ * \brief Calcule le bord d'une tuile et indique s'il est entièrement intérieur
+ * 
+ * \param tile Paramètres de la tuile
+ * \param buffer Tampon de la tuile, dont le bord est calculé
+ * \return Vrai si tous les pixels du bord atteignent iterMax
+ */
+static bool pyramidBorderInterior(fractalSettings tile, iterationBuffer *buffer)
+{
+	unsigned short *data = buffer->data;
+	int i, last = PYRAMID_TILE - 1;
+	
+	computeComplexRows(tile, buffer, 0, 1);
+	computeComplexRows(tile, buffer, last, PYRAMID_TILE);
+	computeComplexGrid(tile, buffer, 0, 1, 1, last - 1, 1, 1);
+	computeComplexGrid(tile, buffer, last, 1, 1, last - 1, 1, 1);
+	
+	for (i = 0; i < PYRAMID_TILE; i++)
+	{
+		if (data[i] != tile.iterMax || data[last * PYRAMID_TILE + i] != tile.iterMax
+			|| data[i * PYRAMID_TILE] != tile.iterMax || data[i * PYRAMID_TILE + last] != tile.iterMax)
+			return false;
+	}
+	
+	return true;
+}
+
+/**
+ * \fn bool pyramidTileCompute(fractalSettings tile, iterationBuffer *buffer);
+ * \brief Calcule une tuile, sans calculer l'intérieur d'une tuile au bord intérieur
+ * 
+ * Mandelbrot et Julia remplis n'ont pas de trou : si le bord de la tuile
+ * est intérieur, l'extérieur, d'un seul tenant jusqu'à l'infini, ne peut
+ * pas y entrer.
+ * 
+ * \param tile Paramètres de la tuile (PYRAMID_TILE pixels de côté)
+ * \param buffer Tampon recevant les indices de la tuile
+ * \return Vrai si la tuile est entièrement intérieure
+ */
+bool pyramidTileCompute(fractalSettings tile, iterationBuffer *buffer)
+{
+	int i, size = PYRAMID_TILE * PYRAMID_TILE;
+	
+	if (tile.fractalId != COMPLEX_MANDELBROT && tile.fractalId != COMPLEX_JULIA)
+	{
+		computeComplexRows(tile, buffer, 0, PYRAMID_TILE);
+		return false;
+	}
+	
+	if (!pyramidBorderInterior(tile, buffer))
+	{
+		computeComplexRows(tile, buffer, 1, PYRAMID_TILE - 1);
+		return false;
+	}
+	
+	for (i = 0; i < size; i++)
+		buffer->data[i] = tile.iterMax;
+	
+	return true;
+}
+
+/**
+ * \fn static bool pyramidArchiveWrite(pyramid *pyr, long entry, int uniform, const char *data, size_t size);
+ * \brief Ajoute le PNG d'une tuile à l'archive et le note dans la table
+ * 
+ * Un PNG uni déjà écrit pour le même indice est repris tel quel. Appelée
+ * avec le verrou de la pyramide.
+ * 
+ * \param pyr Pointeur vers la pyramide
+ * \param entry Numéro de la tuile dans la table
+ * \param uniform Indice de la tuile si elle est unie, -1 sinon
+ * \param data PNG de la tuile, NULL pour reprendre le PNG uni
+ * \param size Taille du PNG
+ * \return Vrai si l'écriture a réussi
+ */
+static bool pyramidArchiveWrite(pyramid *pyr, long entry, int uniform, const char *data, size_t size)
+{
+	unsigned char record[16];
+	uint64_t offset = pyr->end;
+	int i;
+	
+	if (uniform >= 0 && pyr->uniform[uniform] != 0)
+	{
+		offset = pyr->uniform[uniform];
+		size = pyr->uniformSize[uniform];
+	}
+	else
+	{
+		if (data == NULL || fseeko(pyr->archive, pyr->end, SEEK_SET) != 0
+			|| fwrite(data, 1, size, pyr->archive) != size)
+			return false;
+		
+		pyr->end += size;
+		
+		if (uniform >= 0)
+		{
+			pyr->uniform[uniform] = offset;
+			pyr->uniformSize[uniform] = size;
+		}
+	}
+	
+	for (i = 0; i < 8; i++)
+	{
+		record[i] = (offset >> (8 * i)) & 0xFF;
+		record[8 + i] = ((uint64_t) size >> (8 * i)) & 0xFF;
+	}
+	
+	return fseeko(pyr->archive, PYRAMID_HEADER + 16 * (uint64_t) entry, SEEK_SET) == 0
+		&& fwrite(record, 1, 16, pyr->archive) == 16;
+}
+
+/**
+ * \fn static bool pyramidWrite(pyramid *pyr, int index, int uniform, iterationBuffer *buffer);
+ * \brief Écrit une tuile du niveau en cours dans le dossier ou l'archive
+ * 
+ * \param pyr Pointeur vers la pyramide
+ * \param index Numéro de la tuile dans le niveau
+ * \param uniform Indice de la tuile si elle est unie, -1 sinon
+ * \param buffer Tampon de la tuile
+ * \return Vrai si l'écriture a réussi
+ */
+static bool pyramidWrite(pyramid *pyr, int index, int uniform, iterationBuffer *buffer)
+{
+	int n = 1 << pyr->level;
+	long entry = ((1L << (2 * pyr->level)) - 1) / 3 + index;
+	char path[4096], *data = NULL;
+	size_t size = 0;
+	bool success;
+	
+	if (pyr->archive == NULL)
+	{
+		snprintf(path, sizeof(path), "%s/%d/%d/%d.png", pyr->output, pyr->level, index % n, index / n);
+		return imageFileWrite(path, IMAGE_FORMAT_PNG, buffer, pyr->pal);
+	}
+	
+	/* Tuile unie déjà dans l'archive : pas besoin de PNG */
+	pthread_mutex_lock(&pyr->lock);
+	if (uniform >= 0 && pyr->uniform[uniform] != 0)
+	{
+		success = pyramidArchiveWrite(pyr, entry, uniform, NULL, 0);
+		pthread_mutex_unlock(&pyr->lock);
+		return success;
+	}
+	pthread_mutex_unlock(&pyr->lock);
+	
+	/* Le PNG est préparé en mémoire, hors du verrou */
+	success = imageFileEncode(IMAGE_FORMAT_PNG, buffer, pyr->pal, &data, &size);
+	
+	if (success)
+	{
+		pthread_mutex_lock(&pyr->lock);
+		success = pyramidArchiveWrite(pyr, entry, uniform, data, size);
+		pthread_mutex_unlock(&pyr->lock);
+	}
+	
+	free(data);
+	return success;
+}
+
+/**
+ * \fn static void pyramidTile(pyramid *pyr, int index, iterationBuffer *buffer);
+ * \brief Calcule et écrit une tuile du niveau en cours
+ * 
+ * \param pyr Pointeur vers la pyramide
+ * \param index Numéro de la tuile dans le niveau, ligne par ligne
+ * \param buffer Tampon de la tuile, propre au thread
+ * \return Rien
+ */
+static void pyramidTile(pyramid *pyr, int index, iterationBuffer *buffer)
+{
+	int n = 1 << pyr->level, x = index % n, y = index / n;
+	int i, size = PYRAMID_TILE * PYRAMID_TILE, uniform;
+	long parent = (long)(y / 2) * (n / 2) + x / 2;
+	fractalSettings tile = pyramidTileSettings(pyr->region, pyr->level, x, y);
+	bool interior;
+	
+	/* Fille d'une tuile intérieure : intérieure aussi, sans rien calculer */
+	if (pyr->level > 0 && (pyr->parent[parent / 8] & (1 << (parent % 8))))
+	{
+		interior = true;
+		for (i = 0; i < size; i++)
+			buffer->data[i] = tile.iterMax;
+	}
+	else
+		interior = pyramidTileCompute(tile, buffer);
+	
+	/* Une tuile unie n'est écrite qu'une fois dans l'archive */
+	uniform = buffer->data[0];
+	for (i = 1; i < size && uniform >= 0; i++)
+		if (buffer->data[i] != uniform)
+			uniform = -1;
+	
+	if (!pyramidWrite(pyr, index, uniform, buffer))
+	{
+		pthread_mutex_lock(&pyr->lock);
+		pyr->error = true;
+		pthread_mutex_unlock(&pyr->lock);
+	}
+	
+	pthread_mutex_lock(&pyr->lock);
+	if (interior)
+	{
+		pyr->interior[index / 8] |= 1 << (index % 8);
+		pyr->skipped++;
+	}
+	else
+		pyr->computed++;
+	pthread_mutex_unlock(&pyr->lock);
+}
+
+/**
+ * \fn static void* pyramidWorker(void *arg);
+ * \brief Calcule les tuiles du niveau en cours, l'une après l'autre, jusqu'à la dernière
+ * 
+ * \param arg Pointeur vers la pyramide
+ * \return NULL
+ */
+static void* pyramidWorker(void *arg)
+{
+	pyramid *pyr = (pyramid*) arg;
+	iterationBuffer *buffer = iterationBufferCreate(PYRAMID_TILE, PYRAMID_TILE);
+	int tiles = 1 << (2 * pyr->level), index;
+	
+	if (buffer == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation d'une tuile de la pyramide\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	while (true)
+	{
+		pthread_mutex_lock(&pyr->lock);
+		index = pyr->error ? tiles : pyr->next++;
+		pthread_mutex_unlock(&pyr->lock);
+		
+		if (index >= tiles)
+			break;
+		
+		pyramidTile(pyr, index, buffer);
+	}
+	
+	iterationBufferFree(buffer);
+	return NULL;
+}
+
+/**
+ * \fn static bool pyramidDirectories(pyramid *pyr, int level);
+ * \brief Crée les dossiers d'un niveau (z et z/x)
+ * 
+ * \param pyr Pointeur vers la pyramide
+ * \param level Niveau
+ * \return Vrai si les dossiers existent
+ */
+static bool pyramidDirectories(pyramid *pyr, int level)
+{
+	char path[4096];
+	int x;
+	
+	snprintf(path, sizeof(path), "%s/%d", pyr->output, level);
+	if (mkdir(path, 0777) < 0 && errno != EEXIST)
+		return false;
+	
+	for (x = 0; x < 1 << level; x++)
+	{
+		snprintf(path, sizeof(path), "%s/%d/%d", pyr->output, level, x);
+		if (mkdir(path, 0777) < 0 && errno != EEXIST)
+			return false;
+	}
+	
+	return true;
+}
+
+/**
+ * \fn static bool pyramidArchiveOpen(pyramid *pyr);
+ * \brief Crée l'archive et écrit son en-tête, la table des tuiles est remplie au fur et à mesure
+ * 
+ * \param pyr Pointeur vers la pyramide
+ * \return Vrai si l'archive est créée
+ */
+static bool pyramidArchiveOpen(pyramid *pyr)
+{
+	unsigned char header[PYRAMID_HEADER];
+	uint64_t entries = ((1ULL << (2 * (pyr->levels + 1))) - 1) / 3;
+	int i;
+	
+	pyr->archive = fopen(pyr->output, "w+b");
+	if (pyr->archive == NULL)
+		return false;
+	
+	memcpy(header, "LiFEPYR1", 8);
+	for (i = 0; i < 4; i++)
+	{
+		header[8 + i] = (pyr->levels >> (8 * i)) & 0xFF;
+		header[12 + i] = (PYRAMID_TILE >> (8 * i)) & 0xFF;
+	}
+	
+	pyr->end = PYRAMID_HEADER + 16 * entries;
+	
+	return fwrite(header, 1, PYRAMID_HEADER, pyr->archive) == PYRAMID_HEADER;
+}
+
+/**
+ * \fn bool pyramidRender(renderJob *job, fractalSettings fSet);
+ * \brief Calcule la pyramide de tuiles d'une région
+ * 
+ * La pyramide couvre le carré centré sur la vue de \e fSet dont le côté
+ * est le plus grand côté de la vue (voir pyramidRegion()).
+ * 
+ * \param job Image à calculer (sortie, niveaux, threads)
+ * \param fSet Paramètres de la vue à couvrir
+ * \return Vrai si toutes les tuiles sont écrites (sinon message sur stderr)
+ */
+bool pyramidRender(renderJob *job, fractalSettings fSet)
+{
+	pyramid pyr;
+	pthread_t threads[COMPUTE_THREADS_MAX];
+	long cores = job->threads > 0 ? job->threads : sysconf(_SC_NPROCESSORS_ONLN);
+	int threadCount = cores < 1 ? 1 : (cores > COMPUTE_THREADS_MAX ? COMPUTE_THREADS_MAX : cores);
+	int started, i, tiles;
+	size_t indices = paletteSize(fSet);
+	
+	memset(&pyr, 0, sizeof(pyramid));
+	pyr.region = pyramidRegion(fSet);
+	pyr.levels = job->pyramidLevels;
+	pyr.output = job->output;
+	pyr.pal = paletteCreate(fSet);
+	pyr.uniform = (uint64_t*) calloc(indices, sizeof(uint64_t));
+	pyr.uniformSize = (uint64_t*) calloc(indices, sizeof(uint64_t));
+	
+	if (pyr.pal == NULL || pyr.uniform == NULL || pyr.uniformSize == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation de la pyramide\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	pthread_mutex_init(&pyr.lock, NULL);
+	
+	/* Archive si la sortie finit par ".pyr", sinon dossier */
+	if (strlen(pyr.output) > 4 && strcmp(pyr.output + strlen(pyr.output) - 4, ".pyr") == 0)
+	{
+		if (!pyramidArchiveOpen(&pyr))
+			pyr.error = true;
+	}
+	else if (mkdir(pyr.output, 0777) < 0 && errno != EEXIST)
+		pyr.error = true;
+	
+	for (pyr.level = 0; pyr.level <= pyr.levels && !pyr.error; pyr.level++)
+	{
+		tiles = 1 << (2 * pyr.level);
+		
+		if (pyr.archive == NULL && !pyramidDirectories(&pyr, pyr.level))
+		{
+			pyr.error = true;
+			break;
+		}
+		
+		/* Les tuiles intérieures du niveau précédent décident de leurs filles */
+		free(pyr.parent);
+		pyr.parent = pyr.interior;
+		pyr.interior = (unsigned char*) calloc(tiles / 8 + 1, 1);
+		
+		if (pyr.interior == NULL)
+		{
+			fprintf(stderr, "Erreur lors de l'allocation du niveau %d de la pyramide\n", pyr.level);
+			exit(EXIT_FAILURE);
+		}
+		
+		pyr.next = 0;
+		pyr.computed = 0;
+		pyr.skipped = 0;
+		
+		/* Le thread appelant calcule aussi */
+		for (started = 1; started < threadCount && started < tiles; started++)
+			if (pthread_create(&threads[started], NULL, pyramidWorker, &pyr) != 0)
+				break;
+		
+		pyramidWorker(&pyr);
+		
+		for (i = 1; i < started; i++)
+			pthread_join(threads[i], NULL);
+		
+		printf("Niveau %d : %d tuiles, %d calculées, %d intérieures\n",
+			pyr.level, tiles, pyr.computed, pyr.skipped);
+	}
+	
+	if (pyr.archive != NULL && fclose(pyr.archive) != 0)
+		pyr.error = true;
+	
+	if (pyr.error)
+		fprintf(stderr, "Erreur lors de l'écriture de la pyramide %s\n", pyr.output);
+	
+	pthread_mutex_destroy(&pyr.lock);
+	paletteFree(pyr.pal);
+	free(pyr.uniform);
+	free(pyr.uniformSize);
+	free(pyr.parent);
+	free(pyr.interior);
+	
+	return !pyr.error;
+}
@@ -0,0 +1,93 @@
+/**
+ * \file pyramid.h
+ * \brief Fichier d'entête, pyramide de tuiles pour les visionneuses web (LiFE --render --pyramid)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Le niveau z couvre la région de 2^z x 2^z tuiles PNG de PYRAMID_TILE
+ * pixels, du niveau 0 (une tuile) au niveau demandé. Les tuiles d'un
+ * niveau sont calculées en parallèle, un thread par tuile.
+ * 
+ * Mandelbrot et Julia remplis n'ont pas de trou : une tuile dont le bord
+ * est entièrement intérieur est entièrement intérieure, sans calculer le
+ * reste, et ses tuiles filles aussi, sans rien calculer.
+ * 
+ * Les tuiles sont écrites dans un dossier (z/x/y.png, comme les tuiles
+ * XYZ) ou, si le fichier de sortie finit par ".pyr", dans une archive :
+ * 
+ * - "LiFEPYR1", le nombre de niveaux puis le côté des tuiles (32 bits) ;
+ * - pour chaque tuile, niveau 0 d'abord, ligne par ligne, la position et
+ *   la taille de son PNG (64 bits) ;
+ * - les PNG, une seule fois pour toutes les tuiles unies de même indice.
+ * 
+ * Les entiers sont en little-endian : l'archive peut être projetée en
+ * mémoire telle quelle.
+ * 
+ */
+
+#ifndef H_PYRAMID
+#define H_PYRAMID
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include "headless.h"
+
+/* Macros */
+
+/**
+ * \def PYRAMID_TILE
+ * \brief Côté des tuiles en pixels
+ */
+#define PYRAMID_TILE 256
+
+/**
+ * \def PYRAMID_LEVELS_MAX
+ * \brief Niveau le plus profond accepté
+ */
+#define PYRAMID_LEVELS_MAX 12
+
+/**
+ * \def PYRAMID_HEADER
+ * \brief Taille de l'en-tête de l'archive, avant la table des tuiles
+ */
+#define PYRAMID_HEADER 16
+
+/* Structures */
+
+/**
+ * \struct pyramid
+ * \brief Calcul en cours d'une pyramide de tuiles, partagé entre les threads
+ * 
+*/
+typedef struct
+{
+	fractalSettings	region;		/*!< Carré couvert par la pyramide */
+	int		levels;		/*!< Niveau le plus profond */
+	int		level;		/*!< Niveau en cours */
+	int		next;		/*!< Prochaine tuile du niveau à calculer */
+	pthread_mutex_t	lock;		/*!< Protège next, l'archive et les compteurs */
+	unsigned char	*interior;	/*!< Tuiles intérieures du niveau en cours, un bit par tuile */
+	unsigned char	*parent;	/*!< Tuiles intérieures du niveau précédent */
+	palette		*pal;		/*!< Palette des tuiles */
+	const char	*output;	/*!< Dossier ou archive de sortie */
+	FILE		*archive;	/*!< Archive, NULL pour un dossier */
+	uint64_t	end;		/*!< Fin des données de l'archive */
+	uint64_t	*uniform;	/*!< Position du PNG uni de chaque indice dans l'archive, 0 sinon */
+	uint64_t	*uniformSize;	/*!< Taille du PNG uni de chaque indice */
+	int		computed;	/*!< Tuiles calculées entièrement, pour le niveau en cours */
+	int		skipped;	/*!< Tuiles intérieures, pour le niveau en cours */
+	bool		error;		/*!< Vrai si une écriture a échoué */
+} pyramid;
+
+/* Prototypes */
+
+fractalSettings pyramidRegion(fractalSettings view);
+fractalSettings pyramidTileSettings(fractalSettings region, int level, long x, long y);
+bool pyramidTileCompute(fractalSettings tile, iterationBuffer *buffer);
+bool pyramidRender(renderJob *job, fractalSettings fSet);
+
+#endif /* H_PYRAMID */
@@ -55,19 +55,14 @@ void create_levy(int iteration, float abscisse_X, float ordonnee_X, float abscis
 {
 	/* Point intermédiaire (découpage d'un segment en deux) */
 	float abscisse_C, ordonnee_C;
+	colorRGB blanc = {255, 255, 255};
 
 
 		/* Si l'on est à la dernière itération, on trace les lignes */
 		if(iteration <= 1)
 		{
-			/* Changement de la couleur de la courbe en fonction de la position de la ligne */
-			glColor3ub(255, 255, 255);
-			
 			/* On dessine la ligne */
-			glBegin(GL_LINES);
-				glVertex2f(abscisse_X, ordonnee_X);
-				glVertex2f(abscisse_Y, ordonnee_Y);
-			glEnd();
+			drawLine(abscisse_X, ordonnee_X, abscisse_Y, ordonnee_Y, blanc);
 
 		} /* sinon on continue la division des segments à l'itération suivante */
 		else
@@ -97,6 +92,7 @@ void enleveTriangle(float x1,float y1,int iterationmax,float segment)
 
 		static int iteration=1;
 		float i,j,decalageLigne=1,x1ancien=x1,x2ancien=x1,x3ancien=x1,y1ancien=y1,y2ancien=y1,y3ancien=y1;
+		colorRGB noir = {0, 0, 0};
 
 
 		if(iteration>iterationmax)
@@ -105,9 +101,6 @@ void enleveTriangle(float x1,float y1,int iterationmax,float segment)
 			return;
 		}
 	
-		/* Noir */
-		glColor3ub(0,0,0);
-
 		/* boucle pour les colonnes */
 		for(i=pow(2,iteration)-1;i>0;i=i-2)
 		{
@@ -115,11 +108,10 @@ void enleveTriangle(float x1,float y1,int iterationmax,float segment)
 			for(j=(pow(2,iteration)-2*(decalageLigne-1))-1;j>0;j--)
 			{
 
-				glBegin(GL_TRIANGLES);
-					glVertex2f(x1ancien +  (segment / pow(2,iteration+1)),(y1ancien+  (segment * sqrt(3) / pow(2,iteration+1))));
-					glVertex2f((x2ancien+ (3*  segment / pow(2,iteration+1) )),(y2ancien+  (segment * sqrt(3) / pow(2,iteration+1) )));
-					glVertex2f(x3ancien+   (segment*2 / pow(2,iteration+1)),y3ancien);
-				glEnd();
+				drawTriangle(x1ancien +  (segment / pow(2,iteration+1)),(y1ancien+  (segment * sqrt(3) / pow(2,iteration+1))),
+					(x2ancien+ (3*  segment / pow(2,iteration+1) )),(y2ancien+  (segment * sqrt(3) / pow(2,iteration+1) )),
+					x3ancien+   (segment*2 / pow(2,iteration+1)),y3ancien,
+					noir);
 
 				/* calculs des positions en x suivantes */
 				x1ancien=  2*segment / pow(2,iteration+1) +x1ancien;
@@ -165,6 +157,7 @@ void computeTriangleSierpinski(int LargeurFenetre, int HauteurFenetre,int iterat
 {
 	float segment=500.0;
 	float xhaut,yhaut,xbasgauche,ybasgauche,xbasdroit,ybasdroit;
+	colorRGB blanc = {255, 255, 255};
 
 	xhaut=LargeurFenetre/2;
 	yhaut=HauteurFenetre/2+(segment*sqrt(3)/4);
@@ -173,15 +166,8 @@ void computeTriangleSierpinski(int LargeurFenetre, int HauteurFenetre,int iterat
 	xbasdroit=(LargeurFenetre/2)+segment/2;
 	ybasdroit=HauteurFenetre/2+(segment*sqrt(3)/4)-segment*sqrt(3)/2;
 
-	/* Blanc */
-	glColor3ub(255,255,255);
-
 	/*place le triangle de base*/
-	glBegin(GL_TRIANGLES);
-		glVertex2f(xhaut,yhaut);
-		glVertex2f(xbasgauche,ybasgauche);
-		glVertex2f(xbasdroit,ybasdroit);
-	glEnd();
+	drawTriangle(xhaut,yhaut,xbasgauche,ybasgauche,xbasdroit,ybasdroit,blanc);
 
 	enleveTriangle(xbasgauche,ybasgauche,iteration,segment);
 }
@@ -201,6 +187,7 @@ void enleveCarre(float x1,float y1,int iterationmax,float segment)
 
 		static int iteration=1;
 		float i,j,x1ancien,x2ancien,y1ancien,y2ancien;
+		colorRGB noir = {0, 0, 0};
 		
 		
 		if(iteration>iterationmax)
@@ -209,8 +196,6 @@ void enleveCarre(float x1,float y1,int iterationmax,float segment)
 			return;
 		}
 
-		glColor3ub(0, 0, 0);
-
 		/* calcul des points de bases */
 			x1ancien=x1+segment/pow(3,iteration);
 			x2ancien=x1ancien+segment/pow(3,iteration);
@@ -226,12 +211,7 @@ void enleveCarre(float x1,float y1,int iterationmax,float segment)
 			for(j=0;j<pow(3,iteration-1);j++)
 			{
 				
-				glBegin(GL_QUADS);
-					glVertex2f(x1ancien,y1ancien);
-					glVertex2f(x2ancien,y1ancien);
-					glVertex2f(x2ancien,y2ancien);
-					glVertex2f(x1ancien,y2ancien);
-				glEnd();
+				drawRect(x1ancien,y1ancien,x2ancien,y2ancien,noir);
 
 				/* calculs des positions en x suivantes */
 				x1ancien=  3*segment / pow(3,iteration) +x1ancien;
@@ -272,20 +252,14 @@ void enleveCarre(float x1,float y1,int iterationmax,float segment)
 void computeCarreSierpinski(int LargeurFenetre, int HauteurFenetre,int iteration)
 {
 	float xbasgauche,ybasgauche,xhautdroit,yhautdroit,segment=500.0;
+	colorRGB blanc = {255, 255, 255};
 
 	xbasgauche=(LargeurFenetre/2)-segment/2;
 	ybasgauche=HauteurFenetre/2-segment/2;
 	xhautdroit=(LargeurFenetre/2)+segment/2;
 	yhautdroit=HauteurFenetre/2+segment/2;
 
-	glColor3ub(255,255,255);
-
-	glBegin(GL_QUADS);
-		glVertex2f(xbasgauche,ybasgauche);
-		glVertex2f(xhautdroit,ybasgauche);
-		glVertex2f(xhautdroit,yhautdroit);
-		glVertex2f(xbasgauche,yhautdroit);
-	glEnd();
+	drawRect(xbasgauche,ybasgauche,xhautdroit,yhautdroit,blanc);
 
 	enleveCarre(xbasgauche,ybasgauche,iteration,segment);
 	
@@ -0,0 +1,780 @@
+/**
+ * \file render.c
+ * \brief Fichier source, affichage des fractales complexes
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Affiche un tampon d'itérations à l'écran, soit point par point avec
+ * OpenGL, soit sous forme de texture 16 bits colorée par un fragment shader
+ * GLSL 1.10 à partir d'une palette stockée dans une texture 1D.
+ * Les fractales de Mandelbrot, Julia et du Burning Ship peuvent aussi être
+ * calculées directement par un fragment shader.
+ * 
+ * Les fonctions OpenGL 2 sont chargées à l'exécution via
+ * SDL_GL_GetProcAddress, le contexte créé par createWindow n'offrant que
+ * les points d'entrée OpenGL 1.1 sur certaines plateformes.
+ * 
+ */
+
+#include "render.h"
+
+/* Points d'entrée OpenGL 2, chargés par shaderInit() */
+static PFNGLACTIVETEXTUREPROC		pglActiveTexture = NULL;
+static PFNGLCREATESHADERPROC		pglCreateShader = NULL;
+static PFNGLSHADERSOURCEPROC		pglShaderSource = NULL;
+static PFNGLCOMPILESHADERPROC		pglCompileShader = NULL;
+static PFNGLGETSHADERIVPROC		pglGetShaderiv = NULL;
+static PFNGLGETSHADERINFOLOGPROC	pglGetShaderInfoLog = NULL;
+static PFNGLDELETESHADERPROC		pglDeleteShader = NULL;
+static PFNGLCREATEPROGRAMPROC		pglCreateProgram = NULL;
+static PFNGLATTACHSHADERPROC		pglAttachShader = NULL;
+static PFNGLLINKPROGRAMPROC		pglLinkProgram = NULL;
+static PFNGLGETPROGRAMIVPROC		pglGetProgramiv = NULL;
+static PFNGLGETPROGRAMINFOLOGPROC	pglGetProgramInfoLog = NULL;
+static PFNGLDELETEPROGRAMPROC		pglDeleteProgram = NULL;
+static PFNGLUSEPROGRAMPROC		pglUseProgram = NULL;
+static PFNGLGETUNIFORMLOCATIONPROC	pglGetUniformLocation = NULL;
+static PFNGLUNIFORM1IPROC		pglUniform1i = NULL;
+static PFNGLUNIFORM1FPROC		pglUniform1f = NULL;
+static PFNGLUNIFORM2FPROC		pglUniform2f = NULL;
+
+/* Etat de l'affichage par palette */
+static GLuint	paletteProgram = 0;	/* Programme GLSL */
+static GLuint	iterTexture = 0;	/* Texture 16 bits des indices de couleur */
+static GLuint	colorTexture = 0;	/* Texture 1D de la palette */
+static int	iterWidth = 0;		/* Dimensions de la texture des indices */
+static int	iterHeight = 0;
+static int	colorCount = 0;		/* Nombre de couleurs de la palette */
+
+/* Etat du calcul sur GPU */
+static GLuint	computeProgram = 0;	/* Programme GLSL de calcul */
+
+/* Etat de l'affichage des petits tampons (aperçu du zoom) */
+static GLuint	insetTexture = 0;	/* Texture RVB du dernier tampon affiché */
+
+/* Vertex shader commun : on conserve la matrice fixe de gluOrtho2D */
+static const char *vertexShaderSource =
+	"#version 110\n"
+	"void main()\n"
+	"{\n"
+	"	gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+	"	gl_Position = ftransform();\n"
+	"}\n";
+
+/* Fragment shader : indice 16 bits -> couleur de la palette */
+static const char *paletteShaderSource =
+	"#version 110\n"
+	"uniform sampler2D iterations;\n"
+	"uniform sampler1D colors;\n"
+	"uniform float paletteSize;\n"
+	"void main()\n"
+	"{\n"
+	"	float index = floor(texture2D(iterations, gl_TexCoord[0].st).r * 65535.0 + 0.5);\n"
+	"	gl_FragColor = texture1D(colors, (index + 0.5) / paletteSize);\n"
+	"}\n";
+
+/* Fragment shader de calcul : le pixel (x, y) de la fenêtre reçoit l'indice
+ * de couleur du pixel (x, y) du tampon, codé sur les canaux rouge (octet de
+ * poids faible) et vert (octet de poids fort) */
+static const char *computeShaderSource =
+	"#version 110\n"
+	"uniform vec2 origin;\n"
+	"uniform vec2 pixelSize;\n"
+	"uniform vec2 juliaConstant;\n"
+	"uniform float iterMax;\n"
+	"uniform float fractal;\n"
+	"void main()\n"
+	"{\n"
+	"	vec2 p = origin + floor(gl_FragCoord.xy) * pixelSize;\n"
+	"	vec2 z = vec2(0.0, 0.0);\n"
+	"	vec2 c = p;\n"
+	"	float iteration = 0.0;\n"
+	"	if (fractal == 3.0)\n"
+	"	{\n"
+	"		z = p;\n"
+	"		c = juliaConstant;\n"
+	"	}\n"
+	"	while (iteration < iterMax && dot(z, z) < 4.0)\n"
+	"	{\n"
+	"		if (fractal == 2.0)\n"
+	"			z = abs(z);\n"
+	"		z = vec2(z.x * z.x - z.y * z.y, 2.0 * z.x * z.y) + c;\n"
+	"		iteration += 1.0;\n"
+	"	}\n"
+	"	gl_FragColor = vec4(mod(iteration, 256.0) / 255.0,\n"
+	"			floor(iteration / 256.0) / 255.0, 0.0, 1.0);\n"
+	"}\n";
+
+
+/**
+ * \fn void drawIterationBuffer(iterationBuffer *buffer, palette *pal);
+ * \brief Dessine le tampon d'itérations avec le moteur courant
+ * 
+ * \param buffer Tampon d'itérations
+ * \param pal Palette de couleurs
+ * \return Rien
+ */
+void drawIterationBuffer(iterationBuffer *buffer, palette *pal)
+{
+	if (engineSoftwareMode())
+		renderSurface(buffer, pal, engineTarget());
+	else
+	{
+		glBegin(GL_POINTS);
+		renderPoints(buffer, pal);
+		glEnd();
+	}
+}
+
+/**
+ * \fn void renderPoints(iterationBuffer *buffer, palette *pal);
+ * \brief Dessine le tampon d'itérations point par point
+ * \remark Doit être appelée entre glBegin(GL_POINTS) et glEnd()
+ * 
+ * \param buffer Tampon d'itérations
+ * \param pal Palette de couleurs
+ * \return Rien
+ */
+void renderPoints(iterationBuffer *buffer, palette *pal)
+{
+	int x, y;
+	colorRGB c;
+	
+	for (y = 0; y < buffer->height; y++)
+	{
+		for (x = 0; x < buffer->width; x++)
+		{
+			c = pal->colors[buffer->data[y * buffer->width + x]];
+			
+			/* On definit la couleur du point et on le dessine */
+			glColor3ub(c.red, c.green, c.blue);
+			glVertex2f(x, buffer->height - y);
+		}
+	}
+}
+
+/**
+ * \fn void renderSurface(iterationBuffer *buffer, palette *pal, SDL_Surface *surface);
+ * \brief Copie le tampon d'itérations coloré dans une surface SDL 32 bits
+ * 
+ * \param buffer Tampon d'itérations
+ * \param pal Palette de couleurs
+ * \param surface Surface de destination
+ * \return Rien
+ */
+void renderSurface(iterationBuffer *buffer, palette *pal, SDL_Surface *surface)
+{
+	int i, x, y, width, height;
+	Uint32 *pixels = NULL, *row;
+	unsigned short *data;
+	
+	/* On convertit la palette au format de la surface */
+	pixels = (Uint32*) malloc(pal->size * sizeof(Uint32));
+	if (pixels == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation de la palette\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	for (i = 0; i < pal->size; i++)
+		pixels[i] = SDL_MapRGB(surface->format, pal->colors[i].red,
+				pal->colors[i].green, pal->colors[i].blue);
+	
+	width = buffer->width < surface->w ? buffer->width : surface->w;
+	height = buffer->height < surface->h ? buffer->height : surface->h;
+	
+	/* La ligne 0 du tampon est en haut, comme dans la surface SDL */
+	SDL_LockSurface(surface);
+	
+	for (y = 0; y < height; y++)
+	{
+		row = (Uint32*)((Uint8*) surface->pixels + y * surface->pitch);
+		data = buffer->data + y * buffer->width;
+		
+		for (x = 0; x < width; x++)
+			row[x] = pixels[data[x]];
+	}
+	
+	SDL_UnlockSurface(surface);
+	
+	free(pixels);
+}
+
+/**
+ * \fn void insetDraw(iterationBuffer *buffer, palette *pal, float x, float y, float w, float h);
+ * \brief Dessine un petit tampon d'itérations coloré, étiré dans un rectangle
+ * 
+ * Indépendant du calque et de l'affichage par palette : sert aux aperçus
+ * dessinés par-dessus la fractale.
+ * 
+ * \param buffer Tampon d'itérations
+ * \param pal Palette de couleurs
+ * \param x Abscisse du coin bas gauche
+ * \param y Ordonnée du coin bas gauche
+ * \param w Largeur du rectangle
+ * \param h Hauteur du rectangle
+ * \return Rien
+ */
+void insetDraw(iterationBuffer *buffer, palette *pal, float x, float y, float w, float h)
+{
+	SDL_Surface *surface = NULL;
+	unsigned char *rgb = NULL;
+	Uint32 *row;
+	colorRGB c;
+	int i, j, left, top, width, height, sx, sy;
+	
+	if (engineSoftwareMode())
+	{
+		surface = engineTarget();
+		
+		/* Rectangle dans le repère SDL (origine en haut à gauche) */
+		left = (int) floor(x + 0.5);
+		top = (int) floor(surface->h - y - h + 0.5);
+		width = (int) floor(w + 0.5);
+		height = (int) floor(h + 0.5);
+		
+		SDL_LockSurface(surface);
+		
+		for (j = 0; j < height; j++)
+		{
+			if (top + j < 0 || top + j >= surface->h)
+				continue;
+			
+			row = (Uint32*)((Uint8*) surface->pixels + (top + j) * surface->pitch);
+			sy = j * buffer->height / height;
+			
+			for (i = 0; i < width; i++)
+			{
+				if (left + i < 0 || left + i >= surface->w)
+					continue;
+				
+				sx = i * buffer->width / width;
+				c = pal->colors[buffer->data[sy * buffer->width + sx]];
+				row[left + i] = SDL_MapRGB(surface->format, c.red, c.green, c.blue);
+			}
+		}
+		
+		SDL_UnlockSurface(surface);
+		return;
+	}
+	
+	/* On colore le tampon en octets RVB */
+	rgb = (unsigned char*) malloc(3 * buffer->width * buffer->height);
+	if (rgb == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation de l'aperçu\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	for (i = 0; i < buffer->width * buffer->height; i++)
+	{
+		c = pal->colors[buffer->data[i]];
+		rgb[3 * i]	= c.red;
+		rgb[3 * i + 1]	= c.green;
+		rgb[3 * i + 2]	= c.blue;
+	}
+	
+	if (insetTexture == 0)
+	{
+		glGenTextures(1, &insetTexture);
+		glBindTexture(GL_TEXTURE_2D, insetTexture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	}
+	
+	glBindTexture(GL_TEXTURE_2D, insetTexture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, buffer->width, buffer->height, 0,
+			GL_RGB, GL_UNSIGNED_BYTE, rgb);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	free(rgb);
+	
+	glColor4ub(255, 255, 255, 255);
+	glEnable(GL_TEXTURE_2D);
+	
+	/* La ligne 0 du tampon est en haut */
+	glBegin(GL_QUADS);
+		glTexCoord2d(0, 0); glVertex2f(x, y + h);
+		glTexCoord2d(0, 1); glVertex2f(x, y);
+		glTexCoord2d(1, 1); glVertex2f(x + w, y);
+		glTexCoord2d(1, 0); glVertex2f(x + w, y + h);
+	glEnd();
+	
+	glDisable(GL_TEXTURE_2D);
+}
+
+/**
+ * \fn void insetFree(void);
+ * \brief Libère la texture des petits tampons
+ * 
+ * \return Rien
+ */
+void insetFree(void)
+{
+	if (insetTexture != 0)
+		glDeleteTextures(1, &insetTexture);
+	insetTexture = 0;
+}
+
+/**
+ * \fn bool shaderInit(void);
+ * \brief Charge les fonctions OpenGL 2 nécessaires aux shaders
+ * 
+ * \return Vrai si les shaders GLSL sont utilisables, Faux sinon.
+ */
+bool shaderInit(void)
+{
+	static bool loaded = false;
+	const char *version = NULL;
+	
+	if (loaded)
+		return true;
+	
+	/* Il faut un contexte OpenGL 2.0 minimum */
+	version = (const char*) glGetString(GL_VERSION);
+	if (version == NULL || atoi(version) < 2)
+	{
+		fprintf(stderr, "Shaders GLSL indisponibles : OpenGL %s\n",
+				version != NULL ? version : "inconnu");
+		return false;
+	}
+	
+	pglActiveTexture	= (PFNGLACTIVETEXTUREPROC) SDL_GL_GetProcAddress("glActiveTexture");
+	pglCreateShader		= (PFNGLCREATESHADERPROC) SDL_GL_GetProcAddress("glCreateShader");
+	pglShaderSource		= (PFNGLSHADERSOURCEPROC) SDL_GL_GetProcAddress("glShaderSource");
+	pglCompileShader	= (PFNGLCOMPILESHADERPROC) SDL_GL_GetProcAddress("glCompileShader");
+	pglGetShaderiv		= (PFNGLGETSHADERIVPROC) SDL_GL_GetProcAddress("glGetShaderiv");
+	pglGetShaderInfoLog	= (PFNGLGETSHADERINFOLOGPROC) SDL_GL_GetProcAddress("glGetShaderInfoLog");
+	pglDeleteShader		= (PFNGLDELETESHADERPROC) SDL_GL_GetProcAddress("glDeleteShader");
+	pglCreateProgram	= (PFNGLCREATEPROGRAMPROC) SDL_GL_GetProcAddress("glCreateProgram");
+	pglAttachShader		= (PFNGLATTACHSHADERPROC) SDL_GL_GetProcAddress("glAttachShader");
+	pglLinkProgram		= (PFNGLLINKPROGRAMPROC) SDL_GL_GetProcAddress("glLinkProgram");
+	pglGetProgramiv		= (PFNGLGETPROGRAMIVPROC) SDL_GL_GetProcAddress("glGetProgramiv");
+	pglGetProgramInfoLog	= (PFNGLGETPROGRAMINFOLOGPROC) SDL_GL_GetProcAddress("glGetProgramInfoLog");
+	pglDeleteProgram	= (PFNGLDELETEPROGRAMPROC) SDL_GL_GetProcAddress("glDeleteProgram");
+	pglUseProgram		= (PFNGLUSEPROGRAMPROC) SDL_GL_GetProcAddress("glUseProgram");
+	pglGetUniformLocation	= (PFNGLGETUNIFORMLOCATIONPROC) SDL_GL_GetProcAddress("glGetUniformLocation");
+	pglUniform1i		= (PFNGLUNIFORM1IPROC) SDL_GL_GetProcAddress("glUniform1i");
+	pglUniform1f		= (PFNGLUNIFORM1FPROC) SDL_GL_GetProcAddress("glUniform1f");
+	pglUniform2f		= (PFNGLUNIFORM2FPROC) SDL_GL_GetProcAddress("glUniform2f");
+	
+	/* On vérifie que tous les points d'entrée ont été trouvés */
+	loaded = pglActiveTexture && pglCreateShader && pglShaderSource
+		&& pglCompileShader && pglGetShaderiv && pglGetShaderInfoLog
+		&& pglDeleteShader && pglCreateProgram && pglAttachShader
+		&& pglLinkProgram && pglGetProgramiv && pglGetProgramInfoLog
+		&& pglDeleteProgram && pglUseProgram && pglGetUniformLocation
+		&& pglUniform1i && pglUniform1f && pglUniform2f;
+	
+	if (!loaded)
+		fprintf(stderr, "Shaders GLSL indisponibles : fonctions OpenGL 2 introuvables\n");
+	
+	return loaded;
+}
+
+/**
+ * \fn GLuint shaderCompile(GLenum type, const char *source);
+ * \brief Compile un shader GLSL
+ * 
+ * \param type GL_VERTEX_SHADER ou GL_FRAGMENT_SHADER
+ * \param source Code source GLSL
+ * \return L'identifiant du shader, 0 en cas d'erreur
+ */
+static GLuint shaderCompile(GLenum type, const char *source)
+{
+	GLuint shader;
+	GLint status;
+	char log[1024];
+	
+	shader = pglCreateShader(type);
+	pglShaderSource(shader, 1, &source, NULL);
+	pglCompileShader(shader);
+	
+	/* On affiche le journal de compilation en cas d'erreur */
+	pglGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	if (status != GL_TRUE)
+	{
+		pglGetShaderInfoLog(shader, sizeof(log), NULL, log);
+		fprintf(stderr, "Erreur lors de la compilation du shader : %s\n", log);
+		pglDeleteShader(shader);
+		return 0;
+	}
+	
+	return shader;
+}
+
+/**
+ * \fn GLuint shaderCreateProgram(const char *vertexSource, const char *fragmentSource);
+ * \brief Compile et lie un programme GLSL
+ * 
+ * \param vertexSource Code source du vertex shader, NULL pour le shader par défaut
+ * \param fragmentSource Code source du fragment shader
+ * \return L'identifiant du programme, 0 en cas d'erreur
+ */
+GLuint shaderCreateProgram(const char *vertexSource, const char *fragmentSource)
+{
+	GLuint program, vertex, fragment;
+	GLint status;
+	char log[1024];
+	
+	if (!shaderInit())
+		return 0;
+	
+	if (vertexSource == NULL)
+		vertexSource = vertexShaderSource;
+	
+	vertex = shaderCompile(GL_VERTEX_SHADER, vertexSource);
+	fragment = shaderCompile(GL_FRAGMENT_SHADER, fragmentSource);
+	
+	if (vertex == 0 || fragment == 0)
+	{
+		if (vertex != 0)
+			pglDeleteShader(vertex);
+		if (fragment != 0)
+			pglDeleteShader(fragment);
+		return 0;
+	}
+	
+	program = pglCreateProgram();
+	pglAttachShader(program, vertex);
+	pglAttachShader(program, fragment);
+	pglLinkProgram(program);
+	
+	/* Les shaders restent attachés au programme jusqu'à sa destruction */
+	pglDeleteShader(vertex);
+	pglDeleteShader(fragment);
+	
+	pglGetProgramiv(program, GL_LINK_STATUS, &status);
+	if (status != GL_TRUE)
+	{
+		pglGetProgramInfoLog(program, sizeof(log), NULL, log);
+		fprintf(stderr, "Erreur lors de l'édition des liens du shader : %s\n", log);
+		pglDeleteProgram(program);
+		return 0;
+	}
+	
+	return program;
+}
+
+/**
+ * \fn void shaderDeleteProgram(GLuint program);
+ * \brief Détruit un programme GLSL
+ * 
+ * \param program Identifiant du programme
+ * \return Rien
+ */
+void shaderDeleteProgram(GLuint program)
+{
+	if (program != 0)
+		pglDeleteProgram(program);
+}
+
+/**
+ * \fn bool paletteShaderInit(void);
+ * \brief Prépare l'affichage des tampons d'itérations par palette
+ * 
+ * \return Vrai si l'affichage par palette est disponible, Faux sinon.
+ */
+bool paletteShaderInit(void)
+{
+	if (paletteProgram != 0)
+		return true;
+	
+	paletteProgram = shaderCreateProgram(NULL, paletteShaderSource);
+	if (paletteProgram == 0)
+		return false;
+	
+	/* Texture des indices sur l'unité 0, palette sur l'unité 1 */
+	pglUseProgram(paletteProgram);
+	pglUniform1i(pglGetUniformLocation(paletteProgram, "iterations"), 0);
+	pglUniform1i(pglGetUniformLocation(paletteProgram, "colors"), 1);
+	pglUseProgram(0);
+	
+	glGenTextures(1, &iterTexture);
+	glGenTextures(1, &colorTexture);
+	
+	/* Pas d'interpolation : on lit des indices, pas des couleurs */
+	glBindTexture(GL_TEXTURE_2D, iterTexture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	
+	glBindTexture(GL_TEXTURE_1D, colorTexture);
+	glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	
+	return true;
+}
+
+/**
+ * \fn void paletteShaderUpload(iterationBuffer *buffer);
+ * \brief Envoie le tampon d'itérations au GPU (texture 16 bits, 1 canal)
+ * 
+ * \param buffer Tampon d'itérations
+ * \return Rien
+ */
+void paletteShaderUpload(iterationBuffer *buffer)
+{
+	glBindTexture(GL_TEXTURE_2D, iterTexture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+	
+	/* On ne réalloue la texture que si la taille change */
+	if (buffer->width != iterWidth || buffer->height != iterHeight)
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE16, buffer->width,
+				buffer->height, 0, GL_LUMINANCE, GL_UNSIGNED_SHORT,
+				buffer->data);
+		iterWidth = buffer->width;
+		iterHeight = buffer->height;
+	}
+	else
+	{
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, buffer->width,
+				buffer->height, GL_LUMINANCE, GL_UNSIGNED_SHORT,
+				buffer->data);
+	}
+	
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+/**
+ * \fn void paletteShaderSetPalette(palette *pal);
+ * \brief Envoie la palette au GPU (texture 1D)
+ * \remark Changer de palette ne demande aucun recalcul de la fractale
+ * 
+ * \param pal Palette de couleurs
+ * \return Rien
+ */
+void paletteShaderSetPalette(palette *pal)
+{
+	int i;
+	unsigned char *rgb = NULL;
+	
+	/* On convertit la palette en octets RVB */
+	rgb = (unsigned char*) malloc(3 * pal->size);
+	if (rgb == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation de la palette GPU\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	for (i = 0; i < pal->size; i++)
+	{
+		rgb[3 * i]	= pal->colors[i].red;
+		rgb[3 * i + 1]	= pal->colors[i].green;
+		rgb[3 * i + 2]	= pal->colors[i].blue;
+	}
+	
+	glBindTexture(GL_TEXTURE_1D, colorTexture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB8, pal->size, 0, GL_RGB,
+			GL_UNSIGNED_BYTE, rgb);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	
+	colorCount = pal->size;
+	free(rgb);
+}
+
+/**
+ * \fn void paletteShaderDrawRect(float x, float y, float w, float h);
+ * \brief Dessine le dernier tampon d'itérations envoyé, étiré dans un rectangle
+ * 
+ * Le rectangle peut déborder de la fenêtre (zoom continu).
+ * 
+ * \param x Abscisse du coin bas gauche
+ * \param y Ordonnée du coin bas gauche
+ * \param w Largeur du rectangle
+ * \param h Hauteur du rectangle
+ * \return Rien
+ */
+void paletteShaderDrawRect(float x, float y, float w, float h)
+{
+	pglUseProgram(paletteProgram);
+	pglUniform1f(pglGetUniformLocation(paletteProgram, "paletteSize"), colorCount);
+	
+	/* Palette sur l'unité 1, indices sur l'unité 0 */
+	pglActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_1D, colorTexture);
+	pglActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, iterTexture);
+	
+	/* La ligne 0 du tampon est en haut de l'écran */
+	glBegin(GL_QUADS);
+		glTexCoord2d(0,0); glVertex2f(x, y + h);
+		glTexCoord2d(0,1); glVertex2f(x, y);
+		glTexCoord2d(1,1); glVertex2f(x + w, y);
+		glTexCoord2d(1,0); glVertex2f(x + w, y + h);
+	glEnd();
+	
+	pglUseProgram(0);
+}
+
+/**
+ * \fn void paletteShaderFree(void);
+ * \brief Libère les textures et le programme de l'affichage par palette
+ * 
+ * \return Rien
+ */
+void paletteShaderFree(void)
+{
+	if (paletteProgram == 0)
+		return;
+	
+	glDeleteTextures(1, &iterTexture);
+	glDeleteTextures(1, &colorTexture);
+	shaderDeleteProgram(paletteProgram);
+	
+	paletteProgram = 0;
+	iterWidth = iterHeight = 0;
+}
+
+/**
+ * \fn bool glslComputeInit(void);
+ * \brief Prépare le calcul des fractales complexes par le GPU
+ * 
+ * \return Vrai si le calcul sur GPU est disponible, Faux sinon.
+ */
+bool glslComputeInit(void)
+{
+	GLint redBits, greenBits;
+	
+	if (computeProgram != 0)
+		return true;
+	
+	/* Les indices sont relus depuis la fenêtre : il faut 8 bits par canal */
+	glGetIntegerv(GL_RED_BITS, &redBits);
+	glGetIntegerv(GL_GREEN_BITS, &greenBits);
+	if (redBits < 8 || greenBits < 8)
+	{
+		fprintf(stderr, "Calcul GLSL indisponible : tampon d'affichage"
+				" sur %d bits par canal\n", redBits);
+		return false;
+	}
+	
+	computeProgram = shaderCreateProgram(NULL, computeShaderSource);
+	
+	return computeProgram != 0;
+}
+
+/**
+ * \fn bool glslComputeFractal(fractalSettings fSet, iterationBuffer *buffer);
+ * \brief Calcule une fractale complexe avec un fragment shader
+ * 
+ * Même rôle que computeComplexFractal(). Le tampon est découpé en tuiles de
+ * la taille de la fenêtre, dessinées puis relues avec glReadPixels.
+ * Le contenu de la fenêtre est effacé.
+ * 
+ * \param fSet structure contenant les paramètre de la fractale
+ * \param buffer Tampon recevant les indices de couleur
+ * \return Vrai si la fractale a été calculée, Faux si elle doit l'être par le processeur
+ */
+bool glslComputeFractal(fractalSettings fSet, iterationBuffer *buffer)
+{
+	GLint viewport[4];
+	double stepX, stepY, magnitude;
+	int tileX, tileY, tileW, tileH, x, y;
+	unsigned char *pixels = NULL, *p;
+	unsigned short *row;
+	
+	/* Seules les fractales "z² + c" sont calculées par le shader */
+	if (fSet.fractalId != COMPLEX_MANDELBROT
+		&& fSet.fractalId != COMPLEX_JULIA
+		&& fSet.fractalId != COMPLEX_BURNING_SHIP)
+		return false;
+	
+	if (!glslComputeInit())
+		return false;
+	
+	/* Taille d'un pixel dans le plan complexe */
+	stepX = (fSet.realMax - fSet.realMin) / fSet.screenWidth;
+	stepY = (fSet.imagMax - fSet.imagMin) / fSet.screenHeight;
+	
+	/* Au delà d'un certain zoom, la simple précision ne suffit plus */
+	magnitude = fabs(fSet.realMin) + fabs(fSet.realMax)
+		+ fabs(fSet.imagMin) + fabs(fSet.imagMax) + 1.0;
+	if (stepX / magnitude < GLSL_PRECISION_LIMIT || stepY / magnitude < GLSL_PRECISION_LIMIT)
+		return false;
+	
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	
+	pixels = (unsigned char*) malloc(4 * viewport[2] * viewport[3]);
+	if (pixels == NULL)
+		return false;
+	
+	/* Les valeurs écrites doivent être relues telles quelles */
+	glDisable(GL_BLEND);
+	glDisable(GL_DITHER);
+	glDisable(GL_MULTISAMPLE);
+	
+	pglUseProgram(computeProgram);
+	pglUniform2f(pglGetUniformLocation(computeProgram, "pixelSize"), stepX, stepY);
+	pglUniform1f(pglGetUniformLocation(computeProgram, "iterMax"), fSet.iterMax);
+	pglUniform1f(pglGetUniformLocation(computeProgram, "fractal"), fSet.fractalId);
+	pglUniform2f(pglGetUniformLocation(computeProgram, "juliaConstant"),
+			fSet.cstJulia.real, fSet.cstJulia.imag);
+	
+	/* Pour chaque tuile de la taille de la fenêtre */
+	for (tileY = 0; tileY < buffer->height; tileY += viewport[3])
+	{
+		for (tileX = 0; tileX < buffer->width; tileX += viewport[2])
+		{
+			tileW = buffer->width - tileX < viewport[2] ? buffer->width - tileX : viewport[2];
+			tileH = buffer->height - tileY < viewport[3] ? buffer->height - tileY : viewport[3];
+			
+			/* Coin de la tuile dans le plan complexe */
+			pglUniform2f(pglGetUniformLocation(computeProgram, "origin"),
+					fSet.realMin + tileX * stepX,
+					fSet.imagMin + tileY * stepY);
+			
+			glBegin(GL_QUADS);
+				glVertex2f(0, 0);
+				glVertex2f(tileW, 0);
+				glVertex2f(tileW, tileH);
+				glVertex2f(0, tileH);
+			glEnd();
+			
+			/* La ligne 0 relue est la ligne du bas de la fenêtre,
+			 * c'est aussi la ligne 0 de la tuile */
+			glReadPixels(0, 0, tileW, tileH, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+			
+			for (y = 0; y < tileH; y++)
+			{
+				row = buffer->data + (tileY + y) * buffer->width + tileX;
+				p = pixels + 4 * y * tileW;
+				
+				for (x = 0; x < tileW; x++, p += 4)
+					row[x] = p[0] | (p[1] << 8);
+			}
+		}
+	}
+	
+	pglUseProgram(0);
+	
+	glEnable(GL_BLEND);
+	glEnable(GL_DITHER);
+	glEnable(GL_MULTISAMPLE);
+	glClear(GL_COLOR_BUFFER_BIT);
+	
+	free(pixels);
+	
+	return true;
+}
+
+/**
+ * \fn void glslComputeFree(void);
+ * \brief Libère le programme de calcul sur GPU
+ * 
+ * \return Rien
+ */
+void glslComputeFree(void)
+{
+	shaderDeleteProgram(computeProgram);
+	computeProgram = 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * \file render.h
+ * \brief Fichier d'entête, affichage des fractales complexes
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Affiche un tampon d'itérations à l'écran, soit point par point avec
+ * OpenGL, soit sous forme de texture 16 bits colorée par un fragment shader
+ * GLSL 1.10 à partir d'une palette stockée dans une texture 1D.
+ * Les fractales de Mandelbrot, Julia et du Burning Ship peuvent aussi être
+ * calculées directement par un fragment shader.
+ * 
+ */
+
+#ifndef H_RENDER
+#define H_RENDER
+
+#include "engine.h"
+#include "palette.h"
+#include <GL/glext.h>
+
+/* Macros */
+
+/**
+ * \def GLSL_PRECISION_LIMIT
+ * \brief Taille relative minimum d'un pixel pour le calcul sur GPU
+ * 
+ * Les shaders GLSL 1.10 calculent en simple précision. En deçà de cette
+ * taille de pixel (rapportée à la position dans le plan complexe), le calcul
+ * est refait par le processeur en double précision.
+ */
+#define GLSL_PRECISION_LIMIT 1E-5
+
+/* Prototypes */
+
+/* Affichage point par point (OpenGL) ou par copie dans une surface (logiciel) */
+void drawIterationBuffer(iterationBuffer *buffer, palette *pal);
+void renderPoints(iterationBuffer *buffer, palette *pal);
+void renderSurface(iterationBuffer *buffer, palette *pal, SDL_Surface *surface);
+
+/* Affichage d'un petit tampon par-dessus la fractale (aperçu) */
+void insetDraw(iterationBuffer *buffer, palette *pal, float x, float y, float w, float h);
+void insetFree(void);
+
+/* Shaders GLSL */
+bool shaderInit(void);
+GLuint shaderCreateProgram(const char *vertexSource, const char *fragmentSource);
+void shaderDeleteProgram(GLuint program);
+
+/* Affichage du tampon d'itérations par texture et palette */
+bool paletteShaderInit(void);
+void paletteShaderUpload(iterationBuffer *buffer);
+void paletteShaderSetPalette(palette *pal);
+void paletteShaderDrawRect(float x, float y, float w, float h);
+void paletteShaderFree(void);
+
+/* Calcul des fractales complexes par le GPU */
+bool glslComputeInit(void);
+bool glslComputeFractal(fractalSettings fSet, iterationBuffer *buffer);
+void glslComputeFree(void);
+
+#endif /* H_RENDER */
@@ -0,0 +1,326 @@
+/**
+ * \file renderCache.c
+ * \brief Fichier source, cache des fractales complexes déjà calculées
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Garde en mémoire les derniers tampons d'itérations calculés, indexés par
+ * les paramètres de la fractale. Revenir en arrière dans l'historique de zoom
+ * réaffiche alors la fractale sans la recalculer.
+ * 
+ */
+
+#include "renderCache.h"
+
+/**
+ * \fn renderCache* renderCacheCreate(long budget);
+ * \brief Crée un cache vide
+ * 
+ * \param budget Mémoire maximum occupée par les fractales (octets)
+ * \return Un pointeur vers le cache alloué
+ */
+renderCache* renderCacheCreate(long budget)
+{
+	renderCache *cache = (renderCache*) calloc(1, sizeof(renderCache));
+	
+	if (cache == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation du cache des fractales\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	cache->budget = budget;
+	pthread_mutex_init(&cache->lock, NULL);
+	
+	return cache;
+}
+
+/**
+ * \fn static void renderCacheEvict(renderCache *cache, renderCacheEntry *entry);
+ * \brief Oublie une fractale du cache
+ * 
+ * \param cache Pointeur vers le cache
+ * \param entry Entrée à libérer
+ * \return Rien
+ */
+static void renderCacheEvict(renderCache *cache, renderCacheEntry *entry)
+{
+	if (!entry->used)
+		return;
+	
+	cache->bytes -= entry->length * (long) sizeof(unsigned short);
+	free(entry->data);
+	entry->data = NULL;
+	entry->used = false;
+}
+
+/**
+ * \fn void renderCacheFree(renderCache *cache);
+ * \brief Libère le cache et toutes ses fractales
+ * 
+ * \param cache Pointeur vers le cache
+ * \return Rien
+ */
+void renderCacheFree(renderCache *cache)
+{
+	int i;
+	
+	if (cache == NULL)
+		return;
+	
+	for (i = 0; i < RENDER_CACHE_ENTRIES; i++)
+		renderCacheEvict(cache, &cache->entries[i]);
+	
+	pthread_mutex_destroy(&cache->lock);
+	free(cache);
+}
+
+/**
+ * \fn bool renderCacheSameSettings(fractalSettings a, fractalSettings b);
+ * \brief Compare les paramètres qui influent sur le calcul d'une fractale
+ * 
+ * \param a Premiers paramètres
+ * \param b Seconds paramètres
+ * \return Vrai si les deux calculs donnent le même tampon d'itérations
+ */
+bool renderCacheSameSettings(fractalSettings a, fractalSettings b)
+{
+	if (a.fractalId != b.fractalId || a.iterMax != b.iterMax
+		|| a.screenWidth != b.screenWidth || a.screenHeight != b.screenHeight
+		|| a.realMin != b.realMin || a.realMax != b.realMax
+		|| a.imagMin != b.imagMin || a.imagMax != b.imagMax)
+		return false;
+	
+	/* La constante et la puissance ne servent qu'à leur fractale */
+	if (a.fractalId == COMPLEX_JULIA
+		&& (a.cstJulia.real != b.cstJulia.real || a.cstJulia.imag != b.cstJulia.imag))
+		return false;
+	
+	if (a.fractalId == COMPLEX_NEWTON && a.newtonPower != b.newtonPower)
+		return false;
+	
+	return true;
+}
+
+/**
+ * \fn long rleEncode(const unsigned short *source, long count, unsigned short *dest, long capacity);
+ * \brief Compresse des indices de couleur par plages (valeur, longueur)
+ * 
+ * Les fractales ont de grandes zones d'une même couleur (intérieur de
+ * l'ensemble, premières itérations), chaque plage tient sur deux valeurs.
+ * 
+ * \param source Indices à compresser
+ * \param count Nombre d'indices
+ * \param dest Destination
+ * \param capacity Nombre de valeurs 16 bits disponibles dans \e dest
+ * \return Nombre de valeurs écrites, -1 si \e dest est trop petit
+ */
+long rleEncode(const unsigned short *source, long count, unsigned short *dest, long capacity)
+{
+	long i = 0, length = 0, run;
+	
+	while (i < count)
+	{
+		/* Longueur de la plage, limitée à 65535 */
+		run = 1;
+		while (i + run < count && run < 65535 && source[i + run] == source[i])
+			run++;
+		
+		if (length + 2 > capacity)
+			return -1;
+		
+		dest[length++] = source[i];
+		dest[length++] = (unsigned short) run;
+		i += run;
+	}
+	
+	return length;
+}
+
+/**
+ * \fn bool rleDecode(const unsigned short *source, long length, unsigned short *dest, long count);
+ * \brief Décompresse des indices compressés par rleEncode
+ * 
+ * \param source Plages (valeur, longueur)
+ * \param length Nombre de valeurs 16 bits dans \e source
+ * \param dest Destination
+ * \param count Nombre d'indices attendus
+ * \return Vrai si exactement \e count indices ont été décompressés
+ */
+bool rleDecode(const unsigned short *source, long length, unsigned short *dest, long count)
+{
+	long i, j, written = 0;
+	
+	for (i = 0; i + 1 < length; i += 2)
+	{
+		if (written + source[i + 1] > count)
+			return false;
+		
+		for (j = 0; j < source[i + 1]; j++)
+			dest[written++] = source[i];
+	}
+	
+	return written == count;
+}
+
+/**
+ * \fn void renderCacheStore(renderCache *cache, fractalSettings fSet, iterationBuffer *buffer);
+ * \brief Garde une fractale calculée dans le cache
+ * 
+ * Les fractales utilisées le moins récemment sont oubliées pour rester
+ * sous le budget mémoire.
+ * 
+ * \param cache Pointeur vers le cache
+ * \param fSet Paramètres de la fractale calculée
+ * \param buffer Tampon d'itérations calculé
+ * \return Rien
+ */
+void renderCacheStore(renderCache *cache, fractalSettings fSet, iterationBuffer *buffer)
+{
+	renderCacheEntry *entry = NULL;
+	long count = (long) buffer->width * buffer->height;
+	long length, bytes;
+	unsigned short *data = NULL;
+	bool compressed;
+	int i, oldest;
+	
+	/* On compresse, ou on garde les indices tels quels si ça ne gagne rien */
+	data = (unsigned short*) malloc(count * sizeof(unsigned short));
+	if (data == NULL)
+		return;
+	
+	length = rleEncode(buffer->data, count, data, count);
+	compressed = length >= 0;
+	
+	if (!compressed)
+	{
+		memcpy(data, buffer->data, count * sizeof(unsigned short));
+		length = count;
+	}
+	else
+	{
+		unsigned short *shrunk = (unsigned short*) realloc(data, length * sizeof(unsigned short));
+		if (shrunk != NULL)
+			data = shrunk;
+	}
+	
+	bytes = length * (long) sizeof(unsigned short);
+	if (bytes > cache->budget)
+	{
+		free(data);
+		return;
+	}
+	
+	pthread_mutex_lock(&cache->lock);
+	
+	/* Une fractale déjà présente est remplacée */
+	for (i = 0; i < RENDER_CACHE_ENTRIES; i++)
+		if (cache->entries[i].used && renderCacheSameSettings(cache->entries[i].settings, fSet))
+			renderCacheEvict(cache, &cache->entries[i]);
+	
+	/* On libère les plus anciennes jusqu'à avoir une place et la mémoire */
+	while (true)
+	{
+		entry = NULL;
+		oldest = -1;
+		
+		for (i = 0; i < RENDER_CACHE_ENTRIES; i++)
+		{
+			if (!cache->entries[i].used)
+			{
+				if (entry == NULL)
+					entry = &cache->entries[i];
+			}
+			else if (oldest < 0 || cache->entries[i].lastUse < cache->entries[oldest].lastUse)
+				oldest = i;
+		}
+		
+		if (entry != NULL && cache->bytes + bytes <= cache->budget)
+			break;
+		
+		renderCacheEvict(cache, &cache->entries[oldest]);
+	}
+	
+	entry->used = true;
+	entry->settings = fSet;
+	entry->width = buffer->width;
+	entry->height = buffer->height;
+	entry->compressed = compressed;
+	entry->length = length;
+	entry->data = data;
+	entry->lastUse = ++cache->clock;
+	
+	cache->bytes += bytes;
+	
+	pthread_mutex_unlock(&cache->lock);
+}
+
+/**
+ * \fn bool renderCacheFetch(renderCache *cache, fractalSettings fSet, iterationBuffer *buffer);
+ * \brief Cherche une fractale dans le cache et la copie dans le tampon
+ * 
+ * \param cache Pointeur vers le cache
+ * \param fSet Paramètres de la fractale voulue
+ * \param buffer Tampon d'itérations à remplir
+ * \return Vrai si la fractale était dans le cache, Faux sinon
+ */
+bool renderCacheFetch(renderCache *cache, fractalSettings fSet, iterationBuffer *buffer)
+{
+	renderCacheEntry *entry = NULL;
+	long count = (long) buffer->width * buffer->height;
+	bool found = false;
+	int i;
+	
+	pthread_mutex_lock(&cache->lock);
+	
+	for (i = 0; i < RENDER_CACHE_ENTRIES; i++)
+	{
+		entry = &cache->entries[i];
+		
+		if (!entry->used || entry->width != buffer->width || entry->height != buffer->height
+			|| !renderCacheSameSettings(entry->settings, fSet))
+			continue;
+		
+		if (!entry->compressed)
+		{
+			memcpy(buffer->data, entry->data, count * sizeof(unsigned short));
+			found = true;
+		}
+		else
+			found = rleDecode(entry->data, entry->length, buffer->data, count);
+		
+		if (found)
+			entry->lastUse = ++cache->clock;
+		break;
+	}
+	
+	pthread_mutex_unlock(&cache->lock);
+	
+	return found;
+}
+
+/**
+ * \fn bool renderCacheContains(renderCache *cache, fractalSettings fSet);
+ * \brief Indique si une fractale est dans le cache, sans la copier
+ * 
+ * \param cache Pointeur vers le cache
+ * \param fSet Paramètres de la fractale voulue
+ * \return Vrai si la fractale est dans le cache
+ */
+bool renderCacheContains(renderCache *cache, fractalSettings fSet)
+{
+	bool found = false;
+	int i;
+	
+	pthread_mutex_lock(&cache->lock);
+	
+	for (i = 0; i < RENDER_CACHE_ENTRIES && !found; i++)
+		found = cache->entries[i].used && renderCacheSameSettings(cache->entries[i].settings, fSet);
+	
+	pthread_mutex_unlock(&cache->lock);
+	
+	return found;
+}
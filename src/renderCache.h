@@ -0,0 +1,88 @@
+/**
+ * \file renderCache.h
+ * \brief Fichier d'entête, cache des fractales complexes déjà calculées
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Garde en mémoire les derniers tampons d'itérations calculés, indexés par
+ * les paramètres de la fractale. Revenir en arrière dans l'historique de zoom
+ * réaffiche alors la fractale sans la recalculer.
+ * 
+ */
+
+#ifndef H_RENDER_CACHE
+#define H_RENDER_CACHE
+
+#include <pthread.h>
+
+#include "complexFractals.h"
+
+/* Macros */
+
+/**
+ * \def RENDER_CACHE_BUDGET
+ * \brief Mémoire maximum occupée par le cache des fractales (octets)
+ * 
+ * Au delà, les fractales utilisées le moins récemment sont oubliées.
+ */
+#define RENDER_CACHE_BUDGET (64 * 1024 * 1024)
+
+/**
+ * \def RENDER_CACHE_ENTRIES
+ * \brief Nombre maximum de fractales gardées dans le cache
+ */
+#define RENDER_CACHE_ENTRIES 64
+
+/* Structures */
+
+/**
+ * \struct renderCacheEntry
+ * \brief Une fractale calculée, gardée dans le cache
+ * 
+ * Les indices sont compressés par plages (voir rleEncode) quand c'est
+ * plus petit, sinon gardés tels quels sur 16 bits.
+ * 
+*/
+typedef struct
+{
+	bool		used;		/*!< Vrai si l'entrée contient une fractale */
+	fractalSettings	settings;	/*!< Paramètres de la fractale (clé) */
+	int		width;		/*!< Largeur du tampon en pixels */
+	int		height;		/*!< Hauteur du tampon en pixels */
+	bool		compressed;	/*!< Vrai si \e data est compressé par plages */
+	long		length;		/*!< Nombre de valeurs 16 bits dans \e data */
+	unsigned short	*data;		/*!< Indices de couleur */
+	unsigned int	lastUse;	/*!< Date de la dernière utilisation */
+} renderCacheEntry;
+
+/**
+ * \struct renderCache
+ * \brief Cache des fractales complexes, politique LRU sous un budget mémoire
+ * \remark Les fonctions peuvent être appelées depuis plusieurs threads.
+ * 
+*/
+typedef struct
+{
+	renderCacheEntry	entries[RENDER_CACHE_ENTRIES];	/*!< Fractales gardées */
+	long			bytes;		/*!< Mémoire occupée par les données */
+	long			budget;		/*!< Mémoire maximum (octets) */
+	unsigned int		clock;		/*!< Horloge des utilisations */
+	pthread_mutex_t		lock;		/*!< Protège le cache (calculs en arrière-plan) */
+} renderCache;
+
+/* Prototypes */
+
+renderCache* renderCacheCreate(long budget);
+void renderCacheFree(renderCache *cache);
+void renderCacheStore(renderCache *cache, fractalSettings fSet, iterationBuffer *buffer);
+bool renderCacheFetch(renderCache *cache, fractalSettings fSet, iterationBuffer *buffer);
+bool renderCacheContains(renderCache *cache, fractalSettings fSet);
+bool renderCacheSameSettings(fractalSettings a, fractalSettings b);
+
+long rleEncode(const unsigned short *source, long count, unsigned short *dest, long capacity);
+bool rleDecode(const unsigned short *source, long length, unsigned short *dest, long count);
+
+#endif /* H_RENDER_CACHE */
@@ -0,0 +1,253 @@
+/**
+ * \file smoothZoom.c
+ * \brief Fichier source, zoom continu à la molette
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * La molette zoome autour du curseur. L'image déjà affichée est aussitôt
+ * agrandie ou réduite vers la nouvelle vue, puis, une fois la vue atteinte,
+ * remplacée bande par bande par la fractale recalculée, quelques
+ * millisecondes par image pour que l'affichage reste fluide.
+ * 
+ */
+
+#include "smoothZoom.h"
+
+/**
+ * \fn smoothZoom* smoothZoomCreate(int width, int height);
+ * \brief Alloue l'état du zoom continu
+ * 
+ * \param width Largeur de l'écran en pixels
+ * \param height Hauteur de l'écran en pixels
+ * \return Un pointeur vers l'état alloué
+ */
+smoothZoom* smoothZoomCreate(int width, int height)
+{
+	smoothZoom *zoom = (smoothZoom*) malloc(sizeof(smoothZoom));
+	
+	if (zoom != NULL)
+	{
+		memset(zoom, 0, sizeof(smoothZoom));
+		zoom->scratch = iterationBufferCreate(width, height);
+	}
+	
+	if (zoom == NULL || zoom->scratch == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation du zoom continu\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	zoom->nextRow = -1;
+	
+	return zoom;
+}
+
+/**
+ * \fn void smoothZoomFree(smoothZoom *zoom);
+ * \brief Libère l'état du zoom continu
+ * 
+ * \param zoom Pointeur vers l'état
+ * \return Rien
+ */
+void smoothZoomFree(smoothZoom *zoom)
+{
+	if (zoom != NULL)
+	{
+		iterationBufferFree(zoom->scratch);
+		free(zoom);
+	}
+}
+
+/**
+ * \fn void smoothZoomReset(smoothZoom *zoom, fractalSettings view);
+ * \brief Arrête l'animation et le remplacement : la vue est affichée telle quelle
+ * 
+ * \param zoom Pointeur vers l'état
+ * \param view Vue des indices affichés
+ * \return Rien
+ */
+void smoothZoomReset(smoothZoom *zoom, fractalSettings view)
+{
+	zoom->shown = view;
+	zoom->display = view;
+	zoom->target = view;
+	zoom->animating = false;
+	zoom->nextRow = -1;
+}
+
+/**
+ * \fn void smoothZoomTo(smoothZoom *zoom, fractalSettings target);
+ * \brief Lance l'animation depuis la vue à l'écran vers une nouvelle vue
+ * 
+ * Le remplacement en cours s'arrête : les indices déjà affichés restent
+ * ceux de \e shown, et servent d'image pendant l'animation.
+ * 
+ * \param zoom Pointeur vers l'état
+ * \param target Vue à atteindre
+ * \return Rien
+ */
+void smoothZoomTo(smoothZoom *zoom, fractalSettings target)
+{
+	zoom->from = zoom->display;
+	zoom->target = target;
+	zoom->start = SDL_GetTicks();
+	zoom->animating = true;
+	zoom->nextRow = -1;
+}
+
+/**
+ * \fn bool smoothZoomBusy(smoothZoom *zoom);
+ * \brief Indique si l'animation ou le remplacement est en cours
+ * 
+ * \param zoom Pointeur vers l'état
+ * \return Vrai s'il faut encore afficher des images
+ */
+bool smoothZoomBusy(smoothZoom *zoom)
+{
+	return zoom->animating || zoom->nextRow >= 0;
+}
+
+/**
+ * \fn bool smoothZoomAnimate(smoothZoom *zoom);
+ * \brief Avance l'animation selon le temps écoulé
+ * 
+ * Les bornes de la vue sont interpolées linéairement : le point sous le
+ * curseur reste fixe pendant toute l'animation.
+ * 
+ * \param zoom Pointeur vers l'état
+ * \return Vrai si la vue vient d'être atteinte
+ */
+bool smoothZoomAnimate(smoothZoom *zoom)
+{
+	double t;
+	
+	if (!zoom->animating)
+		return false;
+	
+	t = (double)(SDL_GetTicks() - zoom->start) / WHEEL_ANIMATION;
+	
+	if (t >= 1.0)
+	{
+		zoom->display = zoom->target;
+		zoom->animating = false;
+		return true;
+	}
+	
+	/* Départ rapide, arrivée en douceur */
+	t = 1.0 - (1.0 - t) * (1.0 - t);
+	
+	zoom->display.realMin = zoom->from.realMin + t * (zoom->target.realMin - zoom->from.realMin);
+	zoom->display.realMax = zoom->from.realMax + t * (zoom->target.realMax - zoom->from.realMax);
+	zoom->display.imagMin = zoom->from.imagMin + t * (zoom->target.imagMin - zoom->from.imagMin);
+	zoom->display.imagMax = zoom->from.imagMax + t * (zoom->target.imagMax - zoom->from.imagMax);
+	
+	return false;
+}
+
+/**
+ * \fn void smoothZoomStart(smoothZoom *zoom, iterationBuffer *buffer);
+ * \brief Reprojette les indices affichés sur la vue atteinte et commence le remplacement
+ * 
+ * Chaque pixel de la nouvelle vue reprend l'indice du pixel de l'ancienne
+ * vue le plus proche, ou 0 s'il en sort.
+ * 
+ * \param zoom Pointeur vers l'état
+ * \param buffer Tampon des indices affichés, reprojeté sur place
+ * \return Rien
+ */
+void smoothZoomStart(smoothZoom *zoom, iterationBuffer *buffer)
+{
+	fractalSettings from = zoom->shown, to = zoom->target;
+	unsigned short *dest = zoom->scratch->data;
+	int x, y, sx, sy;
+	double stepX = (to.realMax - to.realMin) / buffer->width;
+	double stepY = (to.imagMax - to.imagMin) / buffer->height;
+	double scaleX = buffer->width / (from.realMax - from.realMin);
+	double scaleY = buffer->height / (from.imagMax - from.imagMin);
+	
+	for (y = 0; y < buffer->height; y++)
+	{
+		sy = (int) floor((to.imagMin + (y + 0.5) * stepY - from.imagMin) * scaleY);
+		
+		for (x = 0; x < buffer->width; x++)
+		{
+			sx = (int) floor((to.realMin + (x + 0.5) * stepX - from.realMin) * scaleX);
+			
+			if (sx < 0 || sx >= buffer->width || sy < 0 || sy >= buffer->height)
+				dest[y * buffer->width + x] = 0;
+			else
+				dest[y * buffer->width + x] = buffer->data[sy * buffer->width + sx];
+		}
+	}
+	
+	memcpy(buffer->data, dest, buffer->width * buffer->height * sizeof(unsigned short));
+	
+	zoom->shown = to;
+	zoom->display = to;
+	zoom->nextRow = 0;
+}
+
+/**
+ * \fn bool smoothZoomStep(smoothZoom *zoom, iterationBuffer *buffer, Uint32 budget);
+ * \brief Recalcule les bandes suivantes de la vue, dans la limite du temps accordé
+ * 
+ * \param zoom Pointeur vers l'état
+ * \param buffer Tampon des indices affichés
+ * \param budget Temps de calcul accordé en millisecondes
+ * \return Vrai si la vue vient d'être entièrement recalculée
+ */
+bool smoothZoomStep(smoothZoom *zoom, iterationBuffer *buffer, Uint32 budget)
+{
+	Uint32 start = SDL_GetTicks();
+	int last;
+	
+	if (zoom->nextRow < 0)
+		return false;
+	
+	/* Au moins une bande par image, même si le temps est dépassé */
+	do
+	{
+		last = zoom->nextRow + WHEEL_BAND < buffer->height ? zoom->nextRow + WHEEL_BAND : buffer->height;
+		computeComplexRows(zoom->shown, buffer, zoom->nextRow, last);
+		zoom->nextRow = last;
+	}
+	while (zoom->nextRow < buffer->height && SDL_GetTicks() - start < budget);
+	
+	if (zoom->nextRow < buffer->height)
+		return false;
+	
+	zoom->nextRow = -1;
+	return true;
+}
+
+/**
+ * \fn void smoothZoomRect(smoothZoom *zoom, float *x, float *y, float *w, float *h);
+ * \brief Rectangle de l'écran où dessiner les indices affichés
+ * 
+ * Le rectangle est dans le repère OpenGL (origine en bas à gauche) et
+ * peut déborder de l'écran.
+ * 
+ * \param zoom Pointeur vers l'état
+ * \param x Abscisse du coin bas gauche
+ * \param y Ordonnée du coin bas gauche
+ * \param w Largeur du rectangle
+ * \param h Hauteur du rectangle
+ * \return Rien
+ */
+void smoothZoomRect(smoothZoom *zoom, float *x, float *y, float *w, float *h)
+{
+	fractalSettings shown = zoom->shown, display = zoom->display;
+	double scaleX = display.screenWidth / (display.realMax - display.realMin);
+	double scaleY = display.screenHeight / (display.imagMax - display.imagMin);
+	double top = (shown.imagMin - display.imagMin) * scaleY;
+	
+	*x = (shown.realMin - display.realMin) * scaleX;
+	*w = (shown.realMax - shown.realMin) * scaleX;
+	*h = (shown.imagMax - shown.imagMin) * scaleY;
+	
+	/* La ligne 0 (imagMin) est en haut de l'écran */
+	*y = display.screenHeight - top - *h;
+}
@@ -0,0 +1,82 @@
+/**
+ * \file smoothZoom.h
+ * \brief Fichier d'entête, zoom continu à la molette
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * La molette zoome autour du curseur. L'image déjà affichée est aussitôt
+ * agrandie ou réduite vers la nouvelle vue, puis, une fois la vue atteinte,
+ * remplacée bande par bande par la fractale recalculée, quelques
+ * millisecondes par image pour que l'affichage reste fluide.
+ * 
+ */
+
+#ifndef H_SMOOTH_ZOOM
+#define H_SMOOTH_ZOOM
+
+#include "engine.h"
+
+/* Macros */
+
+/**
+ * \def WHEEL_ZOOM
+ * \brief Taille de la nouvelle vue pour un cran de molette vers le haut (0 à 1)
+ */
+#define WHEEL_ZOOM 0.8
+
+/**
+ * \def WHEEL_ANIMATION
+ * \brief Durée de l'animation vers la nouvelle vue, en millisecondes
+ */
+#define WHEEL_ANIMATION 150
+
+/**
+ * \def WHEEL_BUDGET
+ * \brief Temps de calcul accordé par image pendant le remplacement, en millisecondes
+ */
+#define WHEEL_BUDGET 12
+
+/**
+ * \def WHEEL_BAND
+ * \brief Nombre de lignes calculées d'un coup pendant le remplacement
+ */
+#define WHEEL_BAND 4
+
+/* Structures */
+
+/**
+ * \struct smoothZoom
+ * \brief État du zoom continu
+ * 
+ * \e shown est la vue des indices affichés (tampon, texture), \e display
+ * celle de l'écran : l'image est dessinée étirée de l'une à l'autre.
+ * 
+*/
+typedef struct
+{
+	fractalSettings	shown;		/*!< Vue des indices affichés */
+	fractalSettings	display;	/*!< Vue à l'écran */
+	fractalSettings	from;		/*!< Vue à l'écran au début de l'animation */
+	fractalSettings	target;		/*!< Vue à atteindre */
+	Uint32		start;		/*!< Début de l'animation (SDL_GetTicks) */
+	bool		animating;	/*!< Vrai pendant l'animation */
+	int		nextRow;	/*!< Prochaine ligne à recalculer, -1 sinon */
+	iterationBuffer	*scratch;	/*!< Tampon de reprojection */
+} smoothZoom;
+
+/* Prototypes */
+
+smoothZoom* smoothZoomCreate(int width, int height);
+void smoothZoomFree(smoothZoom *zoom);
+void smoothZoomReset(smoothZoom *zoom, fractalSettings view);
+void smoothZoomTo(smoothZoom *zoom, fractalSettings target);
+bool smoothZoomBusy(smoothZoom *zoom);
+bool smoothZoomAnimate(smoothZoom *zoom);
+void smoothZoomStart(smoothZoom *zoom, iterationBuffer *buffer);
+bool smoothZoomStep(smoothZoom *zoom, iterationBuffer *buffer, Uint32 budget);
+void smoothZoomRect(smoothZoom *zoom, float *x, float *y, float *w, float *h);
+
+#endif /* H_SMOOTH_ZOOM */
@@ -0,0 +1,631 @@
+/**
+ * \file tileServer.c
+ * \brief Fichier source, serveur HTTP local de tuiles (LiFE --serve)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Sert sur 127.0.0.1 les tuiles /{fractale}/{z}/{x}/{y}.png de la
+ * pyramide de chaque fractale (mêmes tuiles que LiFE --render --pyramid),
+ * calculées à la demande par un groupe de threads. Chaque thread attend
+ * une connexion, y répond, puis en attend une autre.
+ * 
+ * Les PNG sont gardés dans un cache LRU sous un budget mémoire. Une tuile
+ * demandée pendant son calcul n'est pas recalculée : la requête attend le
+ * résultat. /stats donne en JSON le taux de succès du cache et la latence
+ * des requêtes.
+ * 
+ */
+
+#include "tileServer.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/**
+ * \fn static unsigned int tileHash(int fractalId, int level, long x, long y);
+ * \brief Alvéole de la table de hachage d'une tuile
+ * 
+ * \param fractalId Fractale de la tuile
+ * \param level Niveau de la tuile
+ * \param x Colonne de la tuile
+ * \param y Ligne de la tuile
+ * \return L'indice de l'alvéole
+ */
+static unsigned int tileHash(int fractalId, int level, long x, long y)
+{
+	unsigned long hash = 14695981039346656037UL;
+	
+	hash = (hash ^ fractalId) * 1099511628211UL;
+	hash = (hash ^ level) * 1099511628211UL;
+	hash = (hash ^ x) * 1099511628211UL;
+	hash = (hash ^ y) * 1099511628211UL;
+	
+	return hash % TILE_CACHE_BUCKETS;
+}
+
+/**
+ * \fn static tileEntry* tileFind(tileServer *server, int fractalId, int level, long x, long y);
+ * \brief Cherche une tuile dans le cache, appelée avec le verrou
+ * 
+ * \param server Pointeur vers le serveur
+ * \param fractalId Fractale de la tuile
+ * \param level Niveau de la tuile
+ * \param x Colonne de la tuile
+ * \param y Ligne de la tuile
+ * \return L'entrée, prête ou en cours de calcul, NULL si la tuile est absente
+ */
+static tileEntry* tileFind(tileServer *server, int fractalId, int level, long x, long y)
+{
+	tileEntry *entry = server->buckets[tileHash(fractalId, level, x, y)];
+	
+	while (entry != NULL && (entry->fractalId != fractalId || entry->level != level
+		|| entry->x != x || entry->y != y))
+		entry = entry->chain;
+	
+	return entry;
+}
+
+/**
+ * \fn static void tileUnlink(tileServer *server, tileEntry *entry);
+ * \brief Retire une tuile prête de la liste LRU, appelée avec le verrou
+ * 
+ * \param server Pointeur vers le serveur
+ * \param entry Tuile à retirer
+ * \return Rien
+ */
+static void tileUnlink(tileServer *server, tileEntry *entry)
+{
+	if (entry->newer != NULL)
+		entry->newer->older = entry->older;
+	else
+		server->newest = entry->older;
+	
+	if (entry->older != NULL)
+		entry->older->newer = entry->newer;
+	else
+		server->oldest = entry->newer;
+	
+	entry->newer = NULL;
+	entry->older = NULL;
+}
+
+/**
+ * \fn static void tilePushNewest(tileServer *server, tileEntry *entry);
+ * \brief Place une tuile prête en tête de la liste LRU, appelée avec le verrou
+ * 
+ * \param server Pointeur vers le serveur
+ * \param entry Tuile utilisée
+ * \return Rien
+ */
+static void tilePushNewest(tileServer *server, tileEntry *entry)
+{
+	entry->older = server->newest;
+	entry->newer = NULL;
+	
+	if (server->newest != NULL)
+		server->newest->newer = entry;
+	else
+		server->oldest = entry;
+	
+	server->newest = entry;
+}
+
+/**
+ * \fn static void tileRemove(tileServer *server, tileEntry *entry);
+ * \brief Retire une tuile de la table de hachage et la libère, appelée avec le verrou
+ * 
+ * \param server Pointeur vers le serveur
+ * \param entry Tuile à retirer (hors de la liste LRU)
+ * \return Rien
+ */
+static void tileRemove(tileServer *server, tileEntry *entry)
+{
+	tileEntry **link = &server->buckets[tileHash(entry->fractalId, entry->level, entry->x, entry->y)];
+	
+	while (*link != entry)
+		link = &(*link)->chain;
+	*link = entry->chain;
+	
+	free(entry->png);
+	free(entry);
+}
+
+/**
+ * \fn static void tileEvict(tileServer *server);
+ * \brief Oublie les tuiles utilisées le moins récemment jusqu'à tenir dans le budget
+ * 
+ * Les tuiles en cours de calcul ne sont pas dans la liste LRU : elles
+ * restent. Appelée avec le verrou.
+ * 
+ * \param server Pointeur vers le serveur
+ * \return Rien
+ */
+static void tileEvict(tileServer *server)
+{
+	tileEntry *entry;
+	
+	while (server->bytes > server->budget && server->oldest != NULL)
+	{
+		entry = server->oldest;
+		tileUnlink(server, entry);
+		
+		server->bytes -= entry->size;
+		server->tiles--;
+		tileRemove(server, entry);
+	}
+}
+
+/**
+ * \fn static bool tileGet(tileServer *server, int fractalId, int level, long x, long y, iterationBuffer *buffer, char **png, size_t *size);
+ * \brief Donne une copie du PNG d'une tuile, depuis le cache ou calculée
+ * 
+ * Si la tuile est en cours de calcul pour une autre requête, on attend
+ * ce calcul au lieu de la calculer une seconde fois.
+ * 
+ * \param server Pointeur vers le serveur
+ * \param fractalId Fractale de la tuile
+ * \param level Niveau de la tuile
+ * \param x Colonne de la tuile
+ * \param y Ligne de la tuile
+ * \param buffer Tampon de tuile du thread, pour le calcul
+ * \param png Reçoit la copie du PNG, à libérer par free()
+ * \param size Reçoit la taille du PNG
+ * \return Faux si le calcul ou l'encodage a échoué
+ */
+static bool tileGet(tileServer *server, int fractalId, int level, long x, long y,
+		iterationBuffer *buffer, char **png, size_t *size)
+{
+	tileEntry *entry;
+	bool waited = false, success;
+	char *data;
+	
+	pthread_mutex_lock(&server->lock);
+	
+	while ((entry = tileFind(server, fractalId, level, x, y)) != NULL && entry->png == NULL)
+	{
+		if (!waited)
+			server->shared++;
+		waited = true;
+		pthread_cond_wait(&server->done, &server->lock);
+	}
+	
+	if (entry != NULL)
+	{
+		if (!waited)
+			server->hits++;
+		
+		tileUnlink(server, entry);
+		tilePushNewest(server, entry);
+		
+		*png = (char*) malloc(entry->size);
+		*size = entry->size;
+		if (*png != NULL)
+			memcpy(*png, entry->png, entry->size);
+		
+		pthread_mutex_unlock(&server->lock);
+		return *png != NULL;
+	}
+	
+	/* Absente : on la calcule, les autres requêtes l'attendront */
+	entry = (tileEntry*) calloc(1, sizeof(tileEntry));
+	if (entry == NULL)
+	{
+		pthread_mutex_unlock(&server->lock);
+		return false;
+	}
+	
+	entry->fractalId = fractalId;
+	entry->level = level;
+	entry->x = x;
+	entry->y = y;
+	entry->chain = server->buckets[tileHash(fractalId, level, x, y)];
+	server->buckets[tileHash(fractalId, level, x, y)] = entry;
+	server->misses++;
+	
+	pthread_mutex_unlock(&server->lock);
+	
+	pyramidTileCompute(pyramidTileSettings(server->regions[fractalId], level, x, y), buffer);
+	success = imageFileEncode(IMAGE_FORMAT_PNG, buffer, server->palettes[fractalId], &data, size);
+	
+	pthread_mutex_lock(&server->lock);
+	
+	if (success)
+		*png = (char*) malloc(*size);
+	
+	if (!success || *png == NULL)
+	{
+		/* Les requêtes en attente recommencent */
+		free(data);
+		tileRemove(server, entry);
+		pthread_cond_broadcast(&server->done);
+		pthread_mutex_unlock(&server->lock);
+		return false;
+	}
+	
+	memcpy(*png, data, *size);
+	
+	entry->png = data;
+	entry->size = *size;
+	tilePushNewest(server, entry);
+	server->bytes += entry->size;
+	server->tiles++;
+	tileEvict(server);
+	
+	pthread_cond_broadcast(&server->done);
+	pthread_mutex_unlock(&server->lock);
+	
+	return true;
+}
+
+/**
+ * \fn static void sendResponse(int client, const char *status, const char *type, const char *body, size_t size);
+ * \brief Envoie une réponse HTTP complète, puis la connexion est fermée
+ * 
+ * \param client Socket du client
+ * \param status Code et message ("200 OK")
+ * \param type Type du contenu
+ * \param body Contenu
+ * \param size Taille du contenu en octets
+ * \return Rien
+ */
+static void sendResponse(int client, const char *status, const char *type, const char *body, size_t size)
+{
+	char header[512];
+	ssize_t sent;
+	int length;
+	
+	length = snprintf(header, sizeof(header),
+		"HTTP/1.1 %s\r\n"
+		"Content-Type: %s\r\n"
+		"Content-Length: %lu\r\n"
+		"Access-Control-Allow-Origin: *\r\n"
+		"Connection: close\r\n\r\n",
+		status, type, (unsigned long) size);
+	
+	if (send(client, header, length, MSG_NOSIGNAL) != length)
+		return;
+	
+	while (size > 0)
+	{
+		sent = send(client, body, size, MSG_NOSIGNAL);
+		if (sent <= 0)
+			return;
+		
+		body += sent;
+		size -= sent;
+	}
+}
+
+/**
+ * \fn static int compareFloat(const void *a, const void *b);
+ * \brief Comparaison de deux flottants pour qsort()
+ * 
+ * \param a Premier flottant
+ * \param b Second flottant
+ * \return Négatif, nul ou positif comme strcmp()
+ */
+static int compareFloat(const void *a, const void *b)
+{
+	float fa = *(const float*) a, fb = *(const float*) b;
+	
+	return (fa > fb) - (fa < fb);
+}
+
+/**
+ * \fn static void tileServerStats(tileServer *server, int client);
+ * \brief Répond à /stats : compteurs du cache et latences des tuiles
+ * 
+ * \param server Pointeur vers le serveur
+ * \param client Socket du client
+ * \return Rien
+ */
+static void tileServerStats(tileServer *server, int client)
+{
+	float samples[TILE_SERVER_SAMPLES];
+	char body[1024];
+	unsigned long lookups;
+	int count, length;
+	
+	pthread_mutex_lock(&server->lock);
+	
+	count = server->served < TILE_SERVER_SAMPLES ? server->served : TILE_SERVER_SAMPLES;
+	memcpy(samples, server->samples, count * sizeof(float));
+	lookups = server->hits + server->shared + server->misses;
+	
+	length = snprintf(body, sizeof(body),
+		"{\"requests\": %lu, \"tiles\": %lu, \"errors\": %lu,\n"
+		" \"hits\": %lu, \"shared\": %lu, \"misses\": %lu, \"hitRate\": %.4f,\n"
+		" \"cacheTiles\": %d, \"cacheBytes\": %lu, \"cacheBudget\": %lu,\n",
+		server->requests, server->served, server->errors,
+		server->hits, server->shared, server->misses,
+		lookups > 0 ? (double)(server->hits + server->shared) / lookups : 0.0,
+		server->tiles, (unsigned long) server->bytes, (unsigned long) server->budget);
+		
+	length += snprintf(body + length, sizeof(body) - length,
+		" \"latencyMeanMs\": %.3f, \"latencyMaxMs\": %.3f,",
+		server->served > 0 ? server->latencyTotal / server->served : 0.0, server->latencyMax);
+		
+	pthread_mutex_unlock(&server->lock);
+		
+	/* Centiles sur les dernières tuiles servies */
+	qsort(samples, count, sizeof(float), compareFloat);
+	snprintf(body + length, sizeof(body) - length,
+		" \"latencyP50Ms\": %.3f, \"latencyP95Ms\": %.3f}\n",
+		count > 0 ? samples[count / 2] : 0.0, count > 0 ? samples[count * 95 / 100] : 0.0);
+	
+	sendResponse(client, "200 OK", "application/json", body, strlen(body));
+}
+
+/**
+ * \fn static void tileServerHandle(tileServer *server, int client, iterationBuffer *buffer);
+ * \brief Lit une requête et y répond
+ * 
+ * \param server Pointeur vers le serveur
+ * \param client Socket du client
+ * \param buffer Tampon de tuile du thread
+ * \return Rien
+ */
+static void tileServerHandle(tileServer *server, int client, iterationBuffer *buffer)
+{
+	char request[TILE_SERVER_REQUEST + 1], method[8], path[1024], name[16], end;
+	const char *message;
+	char *png = NULL, *query;
+	size_t length = 0, size;
+	ssize_t received;
+	int fractalId, level;
+	long x, y;
+	double start, latency;
+	
+	/* En-tête complet, ou assez pour la première ligne */
+	while (length < TILE_SERVER_REQUEST)
+	{
+		received = recv(client, request + length, TILE_SERVER_REQUEST - length, 0);
+		if (received <= 0)
+			break;
+		
+		length += received;
+		request[length] = '\0';
+		if (strstr(request, "\r\n\r\n") != NULL)
+			break;
+	}
+	request[length] = '\0';
+	start = headlessNowMs();
+	
+	pthread_mutex_lock(&server->lock);
+	server->requests++;
+	pthread_mutex_unlock(&server->lock);
+	
+	if (sscanf(request, "%7s %1023s", method, path) != 2 || strcmp(method, "GET") != 0)
+		message = "405 Method Not Allowed";
+	else
+	{
+		if ((query = strchr(path, '?')) != NULL)
+			*query = '\0';
+		
+		if (strcmp(path, "/stats") == 0)
+		{
+			tileServerStats(server, client);
+			return;
+		}
+		
+		message = "404 Not Found";
+		
+		if (sscanf(path, "/%15[a-z]/%d/%ld/%ld.pn%c", name, &level, &x, &y, &end) == 5 && end == 'g'
+			&& (fractalId = headlessFractalId(name)) != 0
+			&& level >= 0 && level <= TILE_SERVER_LEVELS
+			&& x >= 0 && y >= 0 && x < (1L << level) && y < (1L << level))
+		{
+			if (tileGet(server, fractalId, level, x, y, buffer, &png, &size))
+			{
+				sendResponse(client, "200 OK", "image/png", png, size);
+				free(png);
+				
+				latency = headlessNowMs() - start;
+				
+				pthread_mutex_lock(&server->lock);
+				server->samples[server->served % TILE_SERVER_SAMPLES] = latency;
+				server->served++;
+				server->latencyTotal += latency;
+				if (latency > server->latencyMax)
+					server->latencyMax = latency;
+				pthread_mutex_unlock(&server->lock);
+				return;
+			}
+			
+			message = "500 Internal Server Error";
+		}
+	}
+	
+	pthread_mutex_lock(&server->lock);
+	server->errors++;
+	pthread_mutex_unlock(&server->lock);
+	
+	sendResponse(client, message, "text/plain", message, strlen(message));
+}
+
+/**
+ * \fn static void* tileServerWorker(void *arg);
+ * \brief Attend les connexions et y répond, sans fin
+ * 
+ * \param arg Pointeur vers le serveur
+ * \return NULL
+ */
+static void* tileServerWorker(void *arg)
+{
+	tileServer *server = (tileServer*) arg;
+	iterationBuffer *buffer = iterationBufferCreate(PYRAMID_TILE, PYRAMID_TILE);
+	struct timeval timeout = {5, 0};
+	int client;
+	
+	if (buffer == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation d'une tuile du serveur\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	while (true)
+	{
+		client = accept(server->socket, NULL, NULL);
+		if (client < 0)
+			continue;
+		
+		/* Un client muet ne bloque pas le thread */
+		setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		
+		tileServerHandle(server, client, buffer);
+		close(client);
+	}
+	
+	iterationBufferFree(buffer);
+	return NULL;
+}
+
+/**
+ * \fn static int tileServerListen(int port);
+ * \brief Ouvre la socket d'écoute sur 127.0.0.1
+ * 
+ * \param port Port d'écoute
+ * \return La socket, -1 en cas d'erreur (message sur stderr)
+ */
+static int tileServerListen(int port)
+{
+	struct sockaddr_in address;
+	int listener = socket(AF_INET, SOCK_STREAM, 0), reuse = 1;
+	
+	if (listener < 0)
+	{
+		fprintf(stderr, "Erreur lors de la création de la socket : %s\n", strerror(errno));
+		return -1;
+	}
+	
+	setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+	
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	
+	if (bind(listener, (struct sockaddr*) &address, sizeof(address)) < 0 || listen(listener, 64) < 0)
+	{
+		fprintf(stderr, "Erreur lors de l'écoute sur le port %d : %s\n", port, strerror(errno));
+		close(listener);
+		return -1;
+	}
+	
+	return listener;
+}
+
+/**
+ * \fn int tileServerMain(int argc, char *argv[]);
+ * \brief Entrée du serveur de tuiles
+ * 
+ * En plus de "--port" et "--cache" (en mégaoctets), les options de
+ * LiFE --render valent pour toutes les fractales (itérations, constante
+ * de Julia, degré de Newton, threads, repère).
+ * 
+ * \param argc Nombre d'arguments
+ * \param argv Arguments de la ligne de commande
+ * \return EXIT_FAILURE si le serveur n'a pas pu démarrer, ne revient pas sinon
+ */
+int tileServerMain(int argc, char *argv[])
+{
+	tileServer *server = (tileServer*) calloc(1, sizeof(tileServer));
+	char **args = (char**) malloc(argc * sizeof(char*));
+	pthread_t thread;
+	renderJob job;
+	fractalSettings fSet;
+	int port = TILE_SERVER_PORT, cache = TILE_CACHE_BUDGET, count = 0, workers, i, id;
+	long cores;
+	bool valid = true;
+	char end;
+	
+	if (server == NULL || args == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation du serveur de tuiles\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	/* Options du serveur, les autres sont celles de --render */
+	args[count++] = argv[0];
+	for (i = 1; i < argc && valid; i++)
+	{
+		if (strcmp(argv[i], "--serve") == 0)
+			continue;
+		
+		if (strcmp(argv[i], "--port") == 0 && i + 1 < argc)
+			valid = sscanf(argv[++i], "%d%c", &port, &end) == 1 && port > 0 && port < 65536;
+		else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc)
+			valid = sscanf(argv[++i], "%d%c", &cache, &end) == 1 && cache > 0;
+		else
+			args[count++] = argv[i];
+	}
+	
+	renderJobInit(&job);
+	
+	if (!valid || !renderJobParse(&job, count, args))
+	{
+		fprintf(stderr, "Utilisation : LiFE --serve [--port N (%d)] [--cache Mo (%d)]"
+			" [--iter N] [--julia re,im] [--power N] [--threads N]\n",
+			TILE_SERVER_PORT, TILE_CACHE_BUDGET);
+		return EXIT_FAILURE;
+	}
+	
+	free(args);
+	
+	for (id = COMPLEX_MANDELBROT; id <= COMPLEX_NEWTON; id++)
+	{
+		job.fractalId = id;
+		fSet = renderJobSettings(&job);
+		
+		if (paletteSize(fSet) > 65536)
+		{
+			fprintf(stderr, "Trop d'itérations (%d) pour des indices sur 16 bits\n", fSet.iterMax);
+			return EXIT_FAILURE;
+		}
+		
+		server->regions[id] = pyramidRegion(fSet);
+		server->palettes[id] = paletteCreate(fSet);
+		
+		if (server->palettes[id] == NULL)
+		{
+			fprintf(stderr, "Erreur lors de l'allocation des palettes du serveur\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	
+	server->budget = (size_t) cache * 1024 * 1024;
+	pthread_mutex_init(&server->lock, NULL);
+	pthread_cond_init(&server->done, NULL);
+	
+	server->socket = tileServerListen(port);
+	if (server->socket < 0)
+		return EXIT_FAILURE;
+	
+	/* Un client parti avant la fin de la réponse ne doit pas tuer le serveur */
+	signal(SIGPIPE, SIG_IGN);
+	
+	cores = job.threads > 0 ? job.threads : sysconf(_SC_NPROCESSORS_ONLN);
+	workers = cores > TILE_SERVER_WORKERS ? cores : TILE_SERVER_WORKERS;
+	if (workers > COMPUTE_THREADS_MAX)
+		workers = COMPUTE_THREADS_MAX;
+	
+	printf("Tuiles sur http://127.0.0.1:%d/{mandelbrot,julia,burningship,newton}/{z}/{x}/{y}.png,"
+		" statistiques sur /stats\n", port);
+	fflush(stdout);
+	
+	/* Le thread principal sert aussi */
+	for (i = 1; i < workers; i++)
+		if (pthread_create(&thread, NULL, tileServerWorker, server) == 0)
+			pthread_detach(thread);
+	
+	tileServerWorker(server);
+	
+	return EXIT_SUCCESS;
+}
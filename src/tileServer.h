@@ -0,0 +1,126 @@
+/**
+ * \file tileServer.h
+ * \brief Fichier d'entête, serveur HTTP local de tuiles (LiFE --serve)
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Sert sur 127.0.0.1 les tuiles /{fractale}/{z}/{x}/{y}.png de la
+ * pyramide de chaque fractale (mêmes tuiles que LiFE --render --pyramid),
+ * calculées à la demande par un groupe de threads. Chaque thread attend
+ * une connexion, y répond, puis en attend une autre.
+ * 
+ * Les PNG sont gardés dans un cache LRU sous un budget mémoire. Une tuile
+ * demandée pendant son calcul n'est pas recalculée : la requête attend le
+ * résultat. /stats donne en JSON le taux de succès du cache et la latence
+ * des requêtes.
+ * 
+ */
+
+#ifndef H_TILE_SERVER
+#define H_TILE_SERVER
+
+#include <pthread.h>
+
+#include "pyramid.h"
+
+/* Macros */
+
+/**
+ * \def TILE_SERVER_PORT
+ * \brief Port d'écoute par défaut
+ */
+#define TILE_SERVER_PORT 8080
+
+/**
+ * \def TILE_SERVER_WORKERS
+ * \brief Nombre minimum de threads : une tuile longue ne bloque pas les autres requêtes
+ */
+#define TILE_SERVER_WORKERS 4
+
+/**
+ * \def TILE_CACHE_BUDGET
+ * \brief Mémoire maximum du cache de tuiles par défaut, en mégaoctets
+ */
+#define TILE_CACHE_BUDGET 256
+
+/**
+ * \def TILE_CACHE_BUCKETS
+ * \brief Nombre d'alvéoles de la table de hachage du cache
+ */
+#define TILE_CACHE_BUCKETS 4096
+
+/**
+ * \def TILE_SERVER_LEVELS
+ * \brief Niveau le plus profond servi (au delà, la précision des double ne suffit plus)
+ */
+#define TILE_SERVER_LEVELS 40
+
+/**
+ * \def TILE_SERVER_REQUEST
+ * \brief Taille maximum de l'en-tête d'une requête, en octets
+ */
+#define TILE_SERVER_REQUEST 4096
+
+/**
+ * \def TILE_SERVER_SAMPLES
+ * \brief Nombre de latences gardées pour les centiles de /stats
+ */
+#define TILE_SERVER_SAMPLES 1024
+
+/* Structures */
+
+/**
+ * \struct tileEntry
+ * \brief Une tuile du cache, prête ou en cours de calcul
+ * 
+*/
+typedef struct tileEntry
+{
+	int		fractalId;	/*!< Fractale de la tuile (clé) */
+	int		level;		/*!< Niveau de la tuile (clé) */
+	long		x;		/*!< Colonne de la tuile (clé) */
+	long		y;		/*!< Ligne de la tuile (clé) */
+	char		*png;		/*!< Image PNG, NULL pendant le calcul */
+	size_t		size;		/*!< Taille de l'image en octets */
+	struct tileEntry *chain;	/*!< Entrée suivante de la même alvéole */
+	struct tileEntry *newer;	/*!< Tuile utilisée juste après (LRU) */
+	struct tileEntry *older;	/*!< Tuile utilisée juste avant (LRU) */
+} tileEntry;
+
+/**
+ * \struct tileServer
+ * \brief État du serveur, partagé entre les threads
+ * 
+*/
+typedef struct
+{
+	int		socket;				/*!< Socket d'écoute */
+	fractalSettings	regions[COMPLEX_NEWTON + 1];	/*!< Carré couvert par la pyramide de chaque fractale */
+	palette		*palettes[COMPLEX_NEWTON + 1];	/*!< Palette de chaque fractale */
+	tileEntry	*buckets[TILE_CACHE_BUCKETS];	/*!< Table de hachage des tuiles */
+	tileEntry	*newest;			/*!< Tuile prête utilisée le plus récemment */
+	tileEntry	*oldest;			/*!< Tuile prête utilisée le moins récemment */
+	size_t		bytes;				/*!< Mémoire occupée par les PNG du cache */
+	size_t		budget;				/*!< Mémoire maximum du cache */
+	int		tiles;				/*!< Nombre de tuiles prêtes dans le cache */
+	pthread_mutex_t	lock;				/*!< Protège le cache et les compteurs */
+	pthread_cond_t	done;				/*!< Signalé à la fin du calcul d'une tuile */
+	unsigned long	requests;			/*!< Requêtes reçues */
+	unsigned long	hits;				/*!< Tuiles trouvées prêtes dans le cache */
+	unsigned long	misses;				/*!< Tuiles calculées */
+	unsigned long	shared;				/*!< Tuiles attendues pendant leur calcul par une autre requête */
+	unsigned long	errors;				/*!< Requêtes invalides ou échouées */
+	double		latencyTotal;			/*!< Somme des latences des tuiles, en ms */
+	double		latencyMax;			/*!< Plus grande latence d'une tuile, en ms */
+	float		samples[TILE_SERVER_SAMPLES];	/*!< Dernières latences des tuiles, en ms */
+	unsigned long	served;				/*!< Tuiles servies */
+} tileServer;
+
+/* Prototypes */
+
+int tileServerMain(int argc, char *argv[]);
+
+#endif /* H_TILE_SERVER */
@@ -0,0 +1,169 @@
+/**
+ * \file zoomPreview.c
+ * \brief Fichier source, aperçu de la zone sous le cadre de zoom
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Pendant que le cadre de zoom suit la souris, la zone qu'il couvre est
+ * calculée à 1/PREVIEW_SCALE de la résolution de l'écran, avec moins
+ * d'itérations, et affichée en incrustation. Le calcul est limité à
+ * quelques millisecondes par image : s'il n'est pas fini quand la
+ * souris bouge, il est abandonné pour la nouvelle zone.
+ * 
+ */
+
+#include "zoomPreview.h"
+#include "render.h"
+
+/**
+ * \fn zoomPreview* zoomPreviewCreate(int width, int height);
+ * \brief Alloue l'aperçu
+ * 
+ * \param width Largeur de l'écran en pixels
+ * \param height Hauteur de l'écran en pixels
+ * \return Un pointeur vers l'aperçu alloué
+ */
+zoomPreview* zoomPreviewCreate(int width, int height)
+{
+	zoomPreview *preview = (zoomPreview*) malloc(sizeof(zoomPreview));
+	
+	if (preview != NULL)
+		preview->buffer = iterationBufferCreate(width / PREVIEW_SCALE, height / PREVIEW_SCALE);
+	
+	if (preview == NULL || preview->buffer == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'allocation de l'aperçu du zoom\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	memset(&preview->view, 0, sizeof(fractalSettings));
+	preview->colors = NULL;
+	preview->nextRow = -1;
+	preview->ready = false;
+	
+	return preview;
+}
+
+/**
+ * \fn void zoomPreviewFree(zoomPreview *preview);
+ * \brief Libère l'aperçu
+ * 
+ * \param preview Pointeur vers l'aperçu
+ * \return Rien
+ */
+void zoomPreviewFree(zoomPreview *preview)
+{
+	if (preview != NULL)
+	{
+		iterationBufferFree(preview->buffer);
+		paletteFree(preview->colors);
+		free(preview);
+	}
+}
+
+/**
+ * \fn void zoomPreviewRequest(zoomPreview *preview, fractalSettings view);
+ * \brief Demande l'aperçu d'une vue, en abandonnant le calcul précédent
+ * 
+ * Rien n'est recalculé si la vue demandée est celle de l'aperçu.
+ * 
+ * \param preview Pointeur vers l'aperçu
+ * \param view Vue à la résolution de l'écran
+ * \return Rien
+ */
+void zoomPreviewRequest(zoomPreview *preview, fractalSettings view)
+{
+	fractalSettings last = preview->view;
+	
+	view.screenWidth = preview->buffer->width;
+	view.screenHeight = preview->buffer->height;
+	view.iterMax = view.iterMax / PREVIEW_ITERATIONS > PREVIEW_ITERATIONS_MIN ?
+			view.iterMax / PREVIEW_ITERATIONS : PREVIEW_ITERATIONS_MIN;
+	
+	if (renderCacheSameSettings(last, view))
+		return;
+	
+	/* La palette dépend de la fractale et du nombre d'itérations */
+	if (preview->colors == NULL || last.fractalId != view.fractalId
+		|| last.iterMax != view.iterMax || last.newtonPower != view.newtonPower)
+	{
+		paletteFree(preview->colors);
+		preview->colors = paletteCreate(view);
+		preview->ready = false;
+		
+		if (preview->colors == NULL)
+		{
+			fprintf(stderr, "Erreur lors de l'allocation de la palette de l'aperçu\n");
+			exit(EXIT_FAILURE);
+		}
+		
+		/* Les anciens indices pourraient sortir de la nouvelle palette */
+		memset(preview->buffer->data, 0, preview->buffer->width
+			* preview->buffer->height * sizeof(unsigned short));
+	}
+	
+	preview->view = view;
+	preview->nextRow = 0;
+}
+
+/**
+ * \fn bool zoomPreviewStep(zoomPreview *preview, Uint32 budget);
+ * \brief Calcule les lignes suivantes de l'aperçu, dans la limite du temps accordé
+ * 
+ * \param preview Pointeur vers l'aperçu
+ * \param budget Temps de calcul accordé en millisecondes
+ * \return Vrai s'il reste des lignes à calculer
+ */
+bool zoomPreviewStep(zoomPreview *preview, Uint32 budget)
+{
+	Uint32 start = SDL_GetTicks();
+	
+	if (preview->nextRow < 0)
+		return false;
+	
+	/* Au moins une ligne par image, même si le temps est dépassé */
+	do
+	{
+		computeComplexRows(preview->view, preview->buffer, preview->nextRow, preview->nextRow + 1);
+		preview->nextRow++;
+	}
+	while (preview->nextRow < preview->buffer->height && SDL_GetTicks() - start < budget);
+	
+	if (preview->nextRow < preview->buffer->height)
+		return true;
+	
+	preview->nextRow = -1;
+	preview->ready = true;
+	return false;
+}
+
+/**
+ * \fn void zoomPreviewDraw(zoomPreview *preview, float x, float y, float w, float h);
+ * \brief Dessine l'aperçu encadré dans un rectangle
+ * 
+ * Tant qu'il n'est pas fini, le bas de l'aperçu montre encore la zone précédente.
+ * 
+ * \param preview Pointeur vers l'aperçu
+ * \param x Abscisse du coin bas gauche
+ * \param y Ordonnée du coin bas gauche
+ * \param w Largeur du rectangle
+ * \param h Hauteur du rectangle
+ * \return Rien
+ */
+void zoomPreviewDraw(zoomPreview *preview, float x, float y, float w, float h)
+{
+	colorRGB white = {255, 255, 255};
+	
+	if (!preview->ready && preview->nextRow <= 0)
+		return;
+	
+	insetDraw(preview->buffer, preview->colors, x, y, w, h);
+	
+	drawLine(x, y, x + w, y, white);
+	drawLine(x + w, y, x + w, y + h, white);
+	drawLine(x + w, y + h, x, y + h, white);
+	drawLine(x, y + h, x, y, white);
+}
@@ -0,0 +1,75 @@
+/**
+ * \file zoomPreview.h
+ * \brief Fichier d'entête, aperçu de la zone sous le cadre de zoom
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Pendant que le cadre de zoom suit la souris, la zone qu'il couvre est
+ * calculée à 1/PREVIEW_SCALE de la résolution de l'écran, avec moins
+ * d'itérations, et affichée en incrustation. Le calcul est limité à
+ * quelques millisecondes par image : s'il n'est pas fini quand la
+ * souris bouge, il est abandonné pour la nouvelle zone.
+ * 
+ */
+
+#ifndef H_ZOOM_PREVIEW
+#define H_ZOOM_PREVIEW
+
+#include "engine.h"
+#include "palette.h"
+#include "renderCache.h"
+
+/* Macros */
+
+/**
+ * \def PREVIEW_SCALE
+ * \brief Diviseur de la résolution de l'aperçu
+ */
+#define PREVIEW_SCALE 8
+
+/**
+ * \def PREVIEW_ITERATIONS
+ * \brief Diviseur du nombre d'itérations de l'aperçu
+ */
+#define PREVIEW_ITERATIONS 2
+
+/**
+ * \def PREVIEW_ITERATIONS_MIN
+ * \brief Nombre d'itérations minimum de l'aperçu
+ */
+#define PREVIEW_ITERATIONS_MIN 20
+
+/**
+ * \def PREVIEW_BUDGET
+ * \brief Temps de calcul accordé à l'aperçu par image, en millisecondes
+ */
+#define PREVIEW_BUDGET 5
+
+/* Structures */
+
+/**
+ * \struct zoomPreview
+ * \brief Aperçu en cours de calcul
+ * 
+*/
+typedef struct
+{
+	fractalSettings	view;		/*!< Vue de l'aperçu (résolution et itérations réduites) */
+	iterationBuffer	*buffer;	/*!< Indices de l'aperçu */
+	palette		*colors;	/*!< Palette de l'aperçu */
+	int		nextRow;	/*!< Prochaine ligne à calculer, -1 si l'aperçu est fini */
+	bool		ready;		/*!< Vrai si le tampon contient un aperçu affichable */
+} zoomPreview;
+
+/* Prototypes */
+
+zoomPreview* zoomPreviewCreate(int width, int height);
+void zoomPreviewFree(zoomPreview *preview);
+void zoomPreviewRequest(zoomPreview *preview, fractalSettings view);
+bool zoomPreviewStep(zoomPreview *preview, Uint32 budget);
+void zoomPreviewDraw(zoomPreview *preview, float x, float y, float w, float h);
+
+#endif /* H_ZOOM_PREVIEW */
@@ -0,0 +1,211 @@
+/**
+ * \file packAssets.c
+ * \brief Outil de compilation, génère le paquet de ressources pré-décodées
+ * \author Timothée NICOLAS
+ * \author Nicolas SILVAIN
+ * \author Nicolas NATIVO
+ * \version 1.0
+ * \date 18/10/2026
+ * 
+ * Usage : LiFE-pack assets.pack img/menu_complex.png font/VeraMono.ttf ...
+ * 
+ * Les images (.png, .bmp) sont décodées en RGBA, les autres fichiers sont
+ * copiés tels quels. Voir src/assets.h pour le format.
+ * 
+ */
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_image.h>
+
+#include "../src/assets.h"
+
+/**
+ * \fn bool isImage(const char *name);
+ * \brief Indique si un fichier doit être décodé
+ * 
+ * \param name Chemin du fichier
+ * \return Vrai pour les images PNG et BMP
+ */
+static bool isImage(const char *name)
+{
+	const char *ext = strrchr(name, '.');
+	
+	return ext != NULL && (strcmp(ext, ".png") == 0 || strcmp(ext, ".bmp") == 0);
+}
+
+/**
+ * \fn unsigned char* loadImage(const char *name, assetEntry *entry);
+ * \brief Décode une image en pixels RGBA
+ * 
+ * \param name Chemin de l'image
+ * \param entry Description de la ressource à compléter
+ * \return Les pixels alloués, NULL en cas d'erreur
+ */
+static unsigned char* loadImage(const char *name, assetEntry *entry)
+{
+	SDL_Surface *source = NULL, *rgba = NULL;
+	unsigned char *pixels = NULL;
+	int y;
+	
+	source = IMG_Load(name);
+	if (source == NULL)
+	{
+		fprintf(stderr, "Erreur lors du chargement de l'image \"%s\" : %s\n",
+				name, IMG_GetError());
+		return NULL;
+	}
+	
+	/* Surface dont les octets sont dans l'ordre R, V, B, A */
+	#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+		rgba = SDL_CreateRGBSurface(SDL_SWSURFACE, source->w, source->h, 32,
+			0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff);
+	#else
+		rgba = SDL_CreateRGBSurface(SDL_SWSURFACE, source->w, source->h, 32,
+			0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+	#endif
+	
+	/* Copie sans mélange, la transparence est conservée */
+	SDL_SetAlpha(source, 0, 0);
+	SDL_BlitSurface(source, NULL, rgba, NULL);
+	
+	pixels = (unsigned char*) malloc(4 * source->w * source->h);
+	if (pixels != NULL)
+	{
+		for (y = 0; y < rgba->h; y++)
+			memcpy(pixels + 4 * y * rgba->w,
+				(unsigned char*) rgba->pixels + y * rgba->pitch,
+				4 * rgba->w);
+		
+		entry->type = ASSET_RGBA;
+		entry->width = rgba->w;
+		entry->height = rgba->h;
+		entry->size = 4 * rgba->w * rgba->h;
+	}
+	
+	SDL_FreeSurface(rgba);
+	SDL_FreeSurface(source);
+	
+	return pixels;
+}
+
+/**
+ * \fn unsigned char* loadFile(const char *name, assetEntry *entry);
+ * \brief Lit un fichier tel quel
+ * 
+ * \param name Chemin du fichier
+ * \param entry Description de la ressource à compléter
+ * \return Le contenu alloué, NULL en cas d'erreur
+ */
+static unsigned char* loadFile(const char *name, assetEntry *entry)
+{
+	FILE *file = fopen(name, "rb");
+	unsigned char *data = NULL;
+	long size;
+	
+	if (file == NULL)
+	{
+		fprintf(stderr, "Erreur lors de l'ouverture de \"%s\"\n", name);
+		return NULL;
+	}
+	
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	
+	data = (unsigned char*) malloc(size > 0 ? size : 1);
+	if (data != NULL && fread(data, 1, size, file) == (size_t) size)
+	{
+		entry->type = ASSET_RAW;
+		entry->size = size;
+	}
+	else
+	{
+		free(data);
+		data = NULL;
+	}
+	
+	fclose(file);
+	
+	return data;
+}
+
+/**
+ * \fn int main(int argc, char *argv[]);
+ * \brief Entrée de l'outil
+ * 
+ * \param argc Nombre d'arguments
+ * \param argv Fichier de sortie puis ressources à regrouper
+ * \return EXIT_SUCCESS, ou EXIT_FAILURE en cas d'erreur
+ */
+int main(int argc, char *argv[])
+{
+	assetHeader header;
+	assetEntry *entries = NULL;
+	unsigned char **data = NULL;
+	static const unsigned char padding[ASSETS_ALIGN] = {0};
+	uint64_t offset;
+	FILE *output = NULL;
+	int i, count = argc - 2;
+	
+	if (argc < 3)
+	{
+		fprintf(stderr, "Usage : %s paquet ressource...\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	
+	entries = (assetEntry*) calloc(count, sizeof(assetEntry));
+	data = (unsigned char**) calloc(count, sizeof(unsigned char*));
+	if (entries == NULL || data == NULL)
+		return EXIT_FAILURE;
+	
+	/* Les données suivent l'en-tête et la table, alignées */
+	offset = sizeof(assetHeader) + count * sizeof(assetEntry);
+	
+	for (i = 0; i < count; i++)
+	{
+		const char *name = argv[i + 2];
+		
+		if (strlen(name) >= sizeof(entries[i].name))
+		{
+			fprintf(stderr, "Nom de ressource trop long : \"%s\"\n", name);
+			return EXIT_FAILURE;
+		}
+		
+		strcpy(entries[i].name, name);
+		data[i] = isImage(name) ? loadImage(name, &entries[i]) : loadFile(name, &entries[i]);
+		
+		if (data[i] == NULL)
+			return EXIT_FAILURE;
+		
+		offset = (offset + ASSETS_ALIGN - 1) / ASSETS_ALIGN * ASSETS_ALIGN;
+		entries[i].offset = offset;
+		offset += entries[i].size;
+	}
+	
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, ASSETS_MAGIC, 8);
+	header.count = count;
+	
+	output = fopen(argv[1], "wb");
+	if (output == NULL)
+	{
+		fprintf(stderr, "Erreur lors de la création de \"%s\"\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	
+	fwrite(&header, sizeof(header), 1, output);
+	fwrite(entries, sizeof(assetEntry), count, output);
+	
+	for (i = 0; i < count; i++)
+	{
+		fwrite(padding, 1, entries[i].offset - ftell(output), output);
+		fwrite(data[i], 1, entries[i].size, output);
+		free(data[i]);
+	}
+	
+	fclose(output);
+	free(entries);
+	free(data);
+	
+	return EXIT_SUCCESS;
+}